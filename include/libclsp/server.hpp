@@ -16,7 +16,27 @@
 
 #pragma once
 
+#include <libclsp/server/byteScanner.hpp>
+#include <libclsp/server/cancellationToken.hpp>
 #include <libclsp/server/capability.hpp>
+#include <libclsp/server/capabilityRegistry.hpp>
+#include <libclsp/server/coroutine.hpp>
+#include <libclsp/server/envelope.hpp>
+#include <libclsp/server/frameReader.hpp>
+#include <libclsp/server/frameWriter.hpp>
+#include <libclsp/server/idleScheduler.hpp>
+#include <libclsp/server/incomingMessage.hpp>
 #include <libclsp/server/jsonHandler.hpp>
 #include <libclsp/server/jsonWriter.hpp>
+#include <libclsp/server/methods.hpp>
+#include <libclsp/server/recordingTransport.hpp>
+#include <libclsp/server/requestTable.hpp>
 #include <libclsp/server/server.hpp>
+#include <libclsp/server/shmTransport.hpp>
+#include <libclsp/server/socketServer.hpp>
+#include <libclsp/server/spscQueue.hpp>
+#include <libclsp/server/strand.hpp>
+#include <libclsp/server/threadPool.hpp>
+#include <libclsp/server/timerQueue.hpp>
+#include <libclsp/server/transport.hpp>
+#include <libclsp/server/uringTransport.hpp>
@@ -0,0 +1,71 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// Vectorized scans of the input bytes, done before the JSON parser.
+///
+/// The best instruction set is picked at runtime on x86 (AVX2, then SSE2)
+/// and at compile time elsewhere (NEON or plain C++).
+class ByteScanner
+{
+public:
+	/// The instruction sets of the scans.
+	enum class Isa
+	{
+		scalar,
+		sse2,
+		avx2,
+		neon,
+	};
+
+	/// True if this build and machine can run the instruction set.
+	static bool isSupported(Isa isa);
+
+	/// The instruction set used when none is given.
+	static Isa bestIsa();
+
+	/// Returns the first "\r\n\r\n" in [first, last) or last if there's
+	/// none.
+	static const char* findHeaderEnd(const char* first, const char* last);
+
+	/// findHeaderEnd() with a supported instruction set.
+	static const char* findHeaderEnd(const char* first, const char* last,
+		Isa isa);
+
+	/// Checks that the bytes are valid UTF-8, without overlong encodings,
+	/// surrogates or code points above U+10FFFF.
+	static bool isValidUtf8(const char* data, size_t size);
+
+	/// isValidUtf8() with a supported instruction set.
+	static bool isValidUtf8(const char* data, size_t size, Isa isa);
+
+	/// Returns the end of the JSON object or array that starts at first, or
+	/// last if it isn't closed. It's a plain scan, only used on the rare
+	/// values that are parsed later.
+	static const char* findValueEnd(const char* first, const char* last);
+
+	ByteScanner() = delete;
+};
+
+}
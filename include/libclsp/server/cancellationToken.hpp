@@ -0,0 +1,96 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// A flag shared by the server and a handler, set when the client cancels
+/// the work or when its deadline passes. Handlers poll it and return early.
+/// The server answers a request cancelled by the client with
+/// RequestCancelled anyway, but it sends the early result of an expired
+/// one.
+///
+/// The copies share the same flag. A null token has no flag, it's never
+/// cancelled and it costs no allocation. The flags are counted by hand and
+/// reused by the thread that frees them, so a request doesn't allocate one
+/// once the thread has some free.
+class CancellationToken
+{
+private:
+	enum class State
+	{
+		active,
+		expired,
+		cancelled
+	};
+
+	struct Flag;
+
+	/// Frees the flags kept by a thread when it ends.
+	struct FreeFlagsCleaner;
+
+	Flag* flag = nullptr;
+
+	/// The free flags of the thread, a list through Flag::next.
+	static thread_local Flag* freeFlags;
+
+	/// The length of freeFlags
+	static thread_local size_t freeFlagCount;
+
+	/// Takes a free flag of the thread, or a new one.
+	static Flag* acquire();
+
+	/// Drops a reference, the last one frees the flag.
+	static void release(Flag* flag);
+
+public:
+	/// True after cancel() or expire() is called on any copy.
+	bool isCancelled() const;
+
+	/// True if it was cancelled by expire() only.
+	bool isExpired() const;
+
+	/// Sets the flag.
+	void cancel();
+
+	/// Sets the flag because the deadline passed, if it isn't set yet.
+	void expire();
+
+	/// A token that isn't cancelled.
+	CancellationToken();
+
+	/// A null token, for the entries that aren't requests yet.
+	explicit CancellationToken(nullptr_t);
+
+	CancellationToken(const CancellationToken& other);
+
+	CancellationToken(CancellationToken&& other);
+
+	CancellationToken& operator=(const CancellationToken& other);
+
+	CancellationToken& operator=(CancellationToken&& other);
+
+	virtual ~CancellationToken();
+};
+
+}
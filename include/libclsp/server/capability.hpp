@@ -17,9 +17,12 @@
 #pragma once
 
 #include <any>
+#include <chrono>
 
+#include <libclsp/server/envelope.hpp>
 #include <libclsp/server/jsonHandler.hpp>
 #include <libclsp/server/jsonWriter.hpp>
+#include <libclsp/server/threadPool.hpp>
 #include <libclsp/types/objectT.hpp>
 
 namespace clsp
@@ -27,23 +30,30 @@ namespace clsp
 
 using namespace std;
 
+/// The functions to read and write the messages of a method.
+///
+/// It's a literal type, so the built-in capabilities are constants that
+/// are ready when the library is loaded. The functions are pointers, a
+/// lambda without captures can be given.
 struct Capability
 {
-	/// The name of the method
-	String method;
+	/// The name of the method. The registry keeps its own copy, so it
+	/// only has to live until addCapability() returns.
+	Key method;
 
 	struct JsonIO
 	{
 		/// A function to write the params or result.
-		optional<function<void(JsonWriter&, any&)>> writer;
+		void (*writer)(JsonWriter&, Envelope&);
 
 		/// A function to parse the params or result.
-		optional<function<ValueSetter(JsonHandler&, optional<any>&)>> reader;
+		ValueSetter (*reader)(JsonHandler&, Envelope&);
 
-		JsonIO(optional<function<void(JsonWriter&, any&)>> writer,
-			optional<function<ValueSetter(JsonHandler&, optional<any>&)>> reader);
-
-		virtual ~JsonIO();
+		constexpr JsonIO(void (*writer)(JsonWriter&, Envelope&),
+			ValueSetter (*reader)(JsonHandler&, Envelope&)):
+				writer(writer),
+				reader(reader)
+		{};
 	};
 
 	/// Functions to read/write the params of a RequestMessage or a
@@ -54,9 +64,57 @@ struct Capability
 	/// Ommited for notifications.
 	optional<JsonIO> result;
 
-	Capability(String method, JsonIO params, optional<JsonIO> result);
-
-	virtual ~Capability();
+	/// A function that returns the document of the parsed params.
+	/// Only for the methods on a text document, their messages run in the
+	/// strand of the document.
+	const DocumentUri& (*document)(Envelope&);
+
+	/// A function that returns the work done token of the parsed params.
+	/// Only for the requests that can report progress, cancelling the
+	/// progress cancels them.
+	optional<ProgressToken> (*workDoneToken)(Envelope&);
+
+	/// The scheduling class of the requests of the method.
+	Priority priority;
+
+	/// Set if the requests of the method are dropped when their document
+	/// changes before they're answered. They're answered with a
+	/// ContentModified error.
+	bool superseded;
+
+	/// The latency budget of the requests of the method, from when they're
+	/// read. They're scheduled by their deadline and their cancellation is
+	/// signaled when it passes, so the handler can return what it has.
+	/// None by default, set it on a copy before addCapability():
+	///
+	///     Capability completion = Capability::textDocumentCompletion;
+	///     completion.deadline = chrono::milliseconds(50);
+	///     server.addCapability(completion);
+	///
+	optional<chrono::milliseconds> deadline;
+
+	/// The result sent at the deadline if the handler didn't answer yet,
+	/// like an incomplete CompletionList. Its late answer is dropped.
+	/// Without it the handler answers late.
+	any (*expiredResult)();
+
+	constexpr Capability(Key method, JsonIO params, optional<JsonIO> result,
+		const DocumentUri& (*document)(Envelope&) = nullptr,
+		optional<ProgressToken> (*workDoneToken)(Envelope&) = nullptr,
+		Priority priority = Priority::normal,
+		bool superseded = false,
+		optional<chrono::milliseconds> deadline = nullopt,
+		any (*expiredResult)() = nullptr):
+			method(method),
+			params(params),
+			result(result),
+			document(document),
+			workDoneToken(workDoneToken),
+			priority(priority),
+			superseded(superseded),
+			deadline(deadline),
+			expiredResult(expiredResult)
+	{};
 
 	// Default capabilities
 	const static Capability cancelRequest;
@@ -0,0 +1,182 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <forward_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <libclsp/server/capability.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The capabilities of a server, looked up by method on every message.
+///
+/// The methods are interned to small ids, the built-in ones have fixed ids
+/// found with a perfect hash. The readers use an immutable snapshot of the
+/// table without locks or allocations, a change publishes a new snapshot.
+/// A reader protects its snapshot with the hazard pointer of its thread,
+/// the writer frees the old snapshots that no hazard points to. The
+/// capabilities are kept until the registry is destroyed, so the
+/// references given never dangle.
+class CapabilityRegistry
+{
+public:
+	/// The id of a method in a registry
+	using MethodId = uint32_t;
+
+	/// The number of built-in methods, they have the first ids.
+	constexpr static size_t builtinCount = 51;
+
+	/// The id of the methods without a capability.
+	constexpr static MethodId unknownMethod = UINT32_MAX;
+
+private:
+	/// The slots of the perfect hash, a power of two.
+	constexpr static size_t hashSize = 256;
+
+	/// The built-in methods with the hash that has no collisions on them.
+	struct BuiltinTable
+	{
+		array<const Capability*, builtinCount> capabilities;
+
+		/// The seed found for the hash
+		uint32_t seed = 0;
+
+		/// The id + 1 of the method of each slot, 0 if empty.
+		array<uint8_t, hashSize> slots = {};
+	};
+
+	/// A version of the table
+	struct Snapshot
+	{
+		/// The capabilities by id, null if not added.
+		vector<const Capability*> capabilities;
+
+		/// The ids of the methods that aren't built-in. The keys view the
+		/// names kept by the registry.
+		unordered_map<string_view, MethodId> customIds;
+	};
+
+	/// The pointer to a snapshot that a thread is reading. The writers
+	/// don't free it.
+	struct Hazard
+	{
+		atomic<const Snapshot*> snapshot = nullptr;
+
+		/// Set while a thread owns it
+		atomic<bool> used = true;
+
+		Hazard* next = nullptr;
+	};
+
+	/// Gives back the hazard of a thread when it exits.
+	struct HazardOwner;
+
+	/// Protects the current snapshot while it's read.
+	class Reader
+	{
+		Hazard& hazard;
+
+	public:
+		const Snapshot& snapshot;
+
+		Reader(const CapabilityRegistry& registry);
+
+		Reader(const Reader&) = delete;
+
+		~Reader();
+	};
+
+	/// The hazards of all the threads and registries, they're reused but
+	/// never freed.
+	static atomic<Hazard*> hazards;
+
+	/// The snapshot that the readers see
+	atomic<const Snapshot*> current;
+
+	/// Owns the current snapshot
+	unique_ptr<const Snapshot> latest;
+
+	/// The old snapshots that were being read when they were replaced.
+	vector<unique_ptr<const Snapshot>> retired;
+
+	/// All the capabilities added, the replaced ones too, in nodes that
+	/// don't move.
+	forward_list<Capability> added;
+
+	/// The names of the methods that aren't built-in, in nodes that don't
+	/// move.
+	forward_list<String> names;
+
+	/// A mutex for the writers
+	mutex writeMutex;
+
+	/// The hash of a method with a seed.
+	static uint32_t hash(string_view method, uint32_t seed);
+
+	/// The table of the built-in methods, made on first use.
+	static const BuiltinTable& builtins();
+
+	/// The id of a method in a snapshot.
+	static optional<MethodId> idOf(const Snapshot& snapshot,
+		string_view method);
+
+	/// The hazard of this thread, taken on its first read.
+	static Hazard& hazard();
+
+	/// Frees the retired snapshots that no hazard points to.
+	void reclaim();
+
+public:
+	/// The id of a built-in method.
+	static optional<MethodId> builtinId(string_view method);
+
+	/// Adds a capability, or replaces the one of its method.
+	void add(Capability capability);
+
+	/// The capability of a method, or null. Wait-free, the reference lives
+	/// as long as the registry.
+	const Capability* find(string_view method) const;
+
+	/// The capability of a method id, or null.
+	const Capability* find(MethodId id) const;
+
+	/// The id of a method, if it's built-in or added.
+	optional<MethodId> idOf(string_view method) const;
+
+	/// The method of a built-in id or of an added one, or an empty string.
+	string_view nameOf(MethodId id) const;
+
+	CapabilityRegistry();
+
+	CapabilityRegistry(const CapabilityRegistry&) = delete;
+
+	virtual ~CapabilityRegistry();
+};
+
+}
@@ -0,0 +1,363 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// The coroutine handlers need C++20, the rest of the library only C++17.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <utility>
+
+#include <libclsp/server/server.hpp>
+#include <libclsp/server/timerQueue.hpp>
+#include <libclsp/types/requestMessage.hpp>
+#include <libclsp/types/responseMessage.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The return type of a request handler written as a coroutine.
+///
+/// The coroutine co_returns the result or the error of the request. While it
+/// waits with co_await it doesn't hold any thread, it's resumed in the pool
+/// of the server.
+///
+///     server.onAsyncRequest("textDocument/hover", RequestCoroutine::handler(
+///         [&server](shared_ptr<RequestMessage> request) -> RequestCoroutine
+///         {
+///             auto config = co_await ClientRequest(server,
+///                 "workspace/configuration", any(ConfigurationParams(...)));
+///
+///             co_return any(variant<Hover, Null>(Null()));
+///         }));
+///
+class RequestCoroutine
+{
+public:
+	struct promise_type
+	{
+		/// Takes the result of the coroutine
+		ResultHandler respond;
+
+		/// Kept alive until the coroutine ends, like the lambda that made it.
+		shared_ptr<void> owner;
+
+		RequestCoroutine get_return_object()
+		{
+			return RequestCoroutine(
+				coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		/// It starts when the result handler is set
+		suspend_always initial_suspend() noexcept
+		{
+			return {};
+		}
+
+		/// The frame is destroyed at the end
+		suspend_never final_suspend() noexcept
+		{
+			return {};
+		}
+
+		void return_value(variant<any, ResponseError> resultOrError)
+		{
+			respond(move(resultOrError));
+		}
+
+		void unhandled_exception()
+		{
+			respond(ResponseError(ErrorCodes::InternalError,
+				"Internal error", nullopt));
+		}
+	};
+
+private:
+	/// The coroutine until it starts
+	coroutine_handle<promise_type> handle;
+
+	explicit RequestCoroutine(coroutine_handle<promise_type> handle):
+		handle(handle)
+	{};
+
+public:
+	/// Runs the coroutine until its first co_await. The handler takes its
+	/// result, the owner is kept alive until it ends.
+	void start(ResultHandler respond, shared_ptr<void> owner = nullptr)
+	{
+		auto started = exchange(handle, nullptr);
+
+		started.promise().respond = move(respond);
+		started.promise().owner = move(owner);
+		started.resume();
+	}
+
+	/// Makes a handler for Server::onAsyncRequest() from a coroutine.
+	/// The coroutine can be a lambda with captures, they live until it ends.
+	static AsyncRequestHandler handler(
+		function<RequestCoroutine(shared_ptr<RequestMessage>)> coroutine)
+	{
+		auto shared = make_shared<
+			function<RequestCoroutine(shared_ptr<RequestMessage>)>>(
+				move(coroutine));
+
+		return [shared](shared_ptr<RequestMessage> request,
+			ResultHandler respond)
+		{
+			(*shared)(move(request)).start(move(respond), shared);
+		};
+	}
+
+	RequestCoroutine(RequestCoroutine&& other) noexcept:
+		handle(exchange(other.handle, nullptr))
+	{};
+
+	RequestCoroutine(const RequestCoroutine&) = delete;
+
+	virtual ~RequestCoroutine()
+	{
+		// Never started
+		if(handle)
+		{
+			handle.destroy();
+		}
+	};
+};
+
+/// Sends a request to the client, co_await returns its result or its error.
+///
+/// The request is sent when it's made, so several of them can be sent
+/// before awaiting any:
+///
+///     ClientRequest registration(server, "client/registerCapability", ...);
+///     ClientRequest configuration(server, "workspace/configuration", ...);
+///
+///     auto registered = co_await registration;
+///     auto config = co_await configuration;
+///
+class ClientRequest
+{
+private:
+	/// Shared with the result handler, which can run after this is gone.
+	struct State
+	{
+		mutex stateMutex;
+
+		optional<variant<any, ResponseError>> resultOrError;
+
+		/// Set when it's awaited before the response
+		coroutine_handle<> handle;
+	};
+
+	shared_ptr<State> state = make_shared<State>();
+
+public:
+	bool await_ready()
+	{
+		lock_guard lock(state->stateMutex);
+
+		return state->resultOrError.has_value();
+	}
+
+	bool await_suspend(coroutine_handle<> handle)
+	{
+		lock_guard lock(state->stateMutex);
+
+		// The response came after await_ready()
+		if(state->resultOrError.has_value())
+		{
+			return false;
+		}
+
+		state->handle = handle;
+
+		return true;
+	}
+
+	variant<any, ResponseError> await_resume()
+	{
+		lock_guard lock(state->stateMutex);
+
+		return move(*state->resultOrError);
+	}
+
+	ClientRequest(Server& server, String method, Envelope params,
+		optional<chrono::milliseconds> timeout = nullopt)
+	{
+		server.sendRequest(method, move(params),
+			[&pool = server.getThreadPool(), state = state](
+				variant<any, ResponseError> response)
+			{
+				coroutine_handle<> handle;
+
+				{
+					lock_guard lock(state->stateMutex);
+
+					state->resultOrError = move(response);
+					handle = state->handle;
+				}
+
+				// Not in the thread that dispatches the messages
+				if(handle)
+				{
+					pool.submit([handle]()
+					{
+						handle.resume();
+					});
+				}
+			},
+			timeout);
+	};
+
+	ClientRequest(const ClientRequest&) = delete;
+
+	virtual ~ClientRequest(){};
+};
+
+/// Waits some time, co_await returns when it passes.
+class Sleep
+{
+private:
+	Server& server;
+
+	TimerQueue::Clock::duration duration;
+
+public:
+	bool await_ready()
+	{
+		return duration <= TimerQueue::Clock::duration::zero();
+	}
+
+	void await_suspend(coroutine_handle<> handle)
+	{
+		ThreadPool& pool = server.getThreadPool();
+
+		TimerQueue::shared().schedule(TimerQueue::Clock::now() + duration,
+			[&pool, handle]()
+			{
+				pool.submit([handle]()
+				{
+					handle.resume();
+				});
+			});
+	}
+
+	void await_resume(){};
+
+	Sleep(Server& server, TimerQueue::Clock::duration duration):
+		server(server),
+		duration(duration)
+	{};
+
+	virtual ~Sleep(){};
+};
+
+/// Runs a blocking function in ThreadPool::blocking(), co_await returns its
+/// result or rethrows its exception. The coroutine continues in the pool of
+/// the server, so the IO never holds one of its workers.
+template <typename T>
+class Offload
+{
+private:
+	Server& server;
+
+	function<T()> work;
+
+	optional<T> result;
+
+	/// What work() threw
+	exception_ptr error;
+
+public:
+	bool await_ready()
+	{
+		return false;
+	}
+
+	void await_suspend(coroutine_handle<> handle)
+	{
+		ThreadPool::blocking().submit([this, handle]()
+		{
+			try
+			{
+				result.emplace(work());
+			}
+			catch(...)
+			{
+				error = current_exception();
+			}
+
+			server.getThreadPool().submit([handle]()
+			{
+				handle.resume();
+			});
+		});
+	}
+
+	T await_resume()
+	{
+		if(error != nullptr)
+		{
+			rethrow_exception(error);
+		}
+
+		return move(*result);
+	}
+
+	Offload(Server& server, function<T()> work):
+		server(server),
+		work(move(work))
+	{};
+
+	virtual ~Offload(){};
+};
+
+/// Reads a whole file in the blocking IO pool, co_await returns its content
+/// or nullopt if it can't be read.
+class ReadFile: public Offload<optional<String>>
+{
+public:
+	ReadFile(Server& server, String path):
+		Offload(server, [path]() -> optional<String>
+		{
+			ifstream file(path, ios::binary);
+
+			if(!file)
+			{
+				return nullopt;
+			}
+
+			stringstream content;
+			content << file.rdbuf();
+
+			return content.str();
+		})
+	{};
+
+	virtual ~ReadFile(){};
+};
+
+}
+
+#endif
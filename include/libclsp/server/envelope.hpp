@@ -0,0 +1,316 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The params or the result of a message, of any type.
+///
+/// It's like an optional<any> but the value is stored in the envelope when
+/// it fits, so the params of the requests on a position, like HoverParams
+/// or DefinitionParams, are parsed without touching the heap. The bigger
+/// ones, like InitializeParams, are allocated.
+///
+/// The type of the value is known by its tag, the reader of the capability
+/// of the method sets it. An any can be stored too, get<T>() looks inside
+/// it, so the handlers can still send any params and results.
+class Envelope
+{
+public:
+	/// The bytes stored inline, enough for every TextDocumentPositionParams
+	/// and most of the other params.
+	constexpr static size_t inlineSize = 320;
+
+	/// True if a T is stored inline. The types are stored inline even if
+	/// their moves can throw.
+	template <typename T>
+	constexpr static bool isInline = sizeof(T) <= inlineSize &&
+		alignof(T) <= alignof(max_align_t);
+
+private:
+	/// The operations of a type, its address is the tag.
+	struct Type
+	{
+		void (*destroy)(Envelope&);
+
+		/// Moves the value to an empty envelope.
+		void (*move)(Envelope& from, Envelope& to);
+
+		/// Copies the value to an empty envelope.
+		void (*copy)(const Envelope& from, Envelope& to);
+
+		/// Moves the value out to an any.
+		any (*toAny)(Envelope&);
+	};
+
+	/// The value or a pointer to it.
+	alignas(max_align_t) unsigned char storage[inlineSize];
+
+	/// Null if empty.
+	const Type* type = nullptr;
+
+	template <typename T>
+	T& object()
+	{
+		if constexpr(isInline<T>)
+		{
+			return *launder(reinterpret_cast<T*>(storage));
+		}
+		else
+		{
+			return **launder(reinterpret_cast<T**>(storage));
+		}
+	}
+
+	template <typename T>
+	const T& object() const
+	{
+		return const_cast<Envelope*>(this)->object<T>();
+	}
+
+	template <typename T, typename... Args>
+	void construct(Args&&... args)
+	{
+		if constexpr(isInline<T>)
+		{
+			new(storage) T(forward<Args>(args)...);
+		}
+		else
+		{
+			new(storage) T*(new T(forward<Args>(args)...));
+		}
+	}
+
+	template <typename T>
+	inline static const Type typeOf = {
+		// Destroy
+		[](Envelope& envelope)
+		{
+			if constexpr(isInline<T>)
+			{
+				envelope.object<T>().~T();
+			}
+			else
+			{
+				delete &envelope.object<T>();
+			}
+		},
+
+		// Move
+		[](Envelope& from, Envelope& to)
+		{
+			if constexpr(isInline<T>)
+			{
+				to.construct<T>(std::move(from.object<T>()));
+				from.object<T>().~T();
+			}
+			else
+			{
+				// The pointer is taken
+				new(to.storage) T*(&from.object<T>());
+			}
+
+			to.type   = from.type;
+			from.type = nullptr;
+		},
+
+		// Copy
+		[](const Envelope& from, Envelope& to)
+		{
+			to.construct<T>(from.object<T>());
+			to.type = from.type;
+		},
+
+		// To any
+		[](Envelope& envelope)
+		{
+			return any(std::move(envelope.object<T>()));
+		}
+	};
+
+public:
+	/// True if there's a value.
+	bool has_value() const
+	{
+		return type != nullptr;
+	}
+
+	/// True if the value is a T. An any is not looked into.
+	template <typename T>
+	bool holds() const
+	{
+		return type == &typeOf<T>;
+	}
+
+	/// Destroys the value.
+	void reset()
+	{
+		if(type != nullptr)
+		{
+			type->destroy(*this);
+			type = nullptr;
+		}
+	}
+
+	/// Replaces the value with a new T.
+	template <typename T, typename... Args>
+	T& emplace(Args&&... args)
+	{
+		reset();
+
+		construct<T>(forward<Args>(args)...);
+		type = &typeOf<T>;
+
+		return object<T>();
+	}
+
+	/// The value if it's a T, or a T stored in an any. Null otherwise.
+	template <typename T>
+	T* getIf()
+	{
+		if(type == &typeOf<T>)
+		{
+			return &object<T>();
+		}
+
+		if(type == &typeOf<any>)
+		{
+			return any_cast<T>(&object<any>());
+		}
+
+		return nullptr;
+	}
+
+	template <typename T>
+	const T* getIf() const
+	{
+		return const_cast<Envelope*>(this)->getIf<T>();
+	}
+
+	/// The value as a T, it throws bad_any_cast like any_cast<>() if it
+	/// isn't one.
+	template <typename T>
+	T& get()
+	{
+		T* value = getIf<T>();
+
+		if(value == nullptr)
+		{
+			throw bad_any_cast();
+		}
+
+		return *value;
+	}
+
+	template <typename T>
+	const T& get() const
+	{
+		return const_cast<Envelope*>(this)->get<T>();
+	}
+
+	/// Moves the value out to an any, the envelope is left empty.
+	any toAny()
+	{
+		any value;
+
+		if(type != nullptr)
+		{
+			value = type->toAny(*this);
+			reset();
+		}
+
+		return value;
+	}
+
+	Envelope& operator=(Envelope&& other)
+	{
+		if(this != &other)
+		{
+			reset();
+
+			if(other.type != nullptr)
+			{
+				other.type->move(other, *this);
+			}
+		}
+
+		return *this;
+	}
+
+	Envelope& operator=(const Envelope& other)
+	{
+		if(this != &other)
+		{
+			reset();
+
+			if(other.type != nullptr)
+			{
+				other.type->copy(other, *this);
+			}
+		}
+
+		return *this;
+	}
+
+	Envelope()
+	{};
+
+	Envelope(nullopt_t)
+	{};
+
+	/// Stores the any as is, even an empty one, like an optional<any>.
+	Envelope(any value)
+	{
+		emplace<any>(std::move(value));
+	};
+
+	/// Stores the any as is, if there's one.
+	Envelope(optional<any> value)
+	{
+		if(value.has_value())
+		{
+			emplace<any>(std::move(*value));
+		}
+	};
+
+	Envelope(Envelope&& other)
+	{
+		*this = std::move(other);
+	};
+
+	Envelope(const Envelope& other)
+	{
+		*this = other;
+	};
+
+	~Envelope()
+	{
+		reset();
+	};
+};
+
+}
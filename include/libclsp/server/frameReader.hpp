@@ -0,0 +1,163 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// Splits a byte stream into the bodies of the messages framed with a
+/// "Content-Length" header.
+///
+/// All the bytes are kept in one buffer that grows when needed and is reused
+/// between messages, so the bodies can be parsed in-situ without copies.
+/// The bodies given by take() share the buffer, it's only reused when they
+/// are released. The bytes lent by a transport are read in place: the
+/// bodies entirely inside them share them instead, only the frames cut by
+/// their ends are copied to the buffer.
+class FrameReader
+{
+private:
+	/// The bytes read from the stream.
+	/// There's always a spare byte after the end for the null terminator.
+	shared_ptr<char[]> buffer;
+
+	/// The size of the buffer
+	size_t capacity = 0;
+
+	/// The first byte that wasn't consumed
+	size_t begin = 0;
+
+	/// The end of the bytes read
+	size_t end = 0;
+
+	/// The bytes after begin already searched for the end of a header
+	size_t headerScanned = 0;
+
+	/// The length of the body whose header was already consumed
+	optional<size_t> bodyLength;
+
+	/// The byte replaced by the null terminator of the last body
+	optional<pair<size_t, char>> terminator;
+
+	/// The lent bytes not consumed yet, they come after the buffer.
+	shared_ptr<char> lent;
+
+	/// The size of the lent bytes
+	size_t lentSize = 0;
+
+	/// The longest body accepted
+	size_t maxFrameSize = defaultMaxFrameSize;
+
+	/// Set when a header has an invalid length, the stream can't be read
+	/// anymore.
+	bool invalid = false;
+
+	/// The smallest space returned by prepare()
+	constexpr static size_t minRead = 4096;
+
+	/// Parses the value of a Content-Length field, from the colon to the
+	/// end of the line. Returns nullopt if it isn't a number or if it's
+	/// longer than the maximum.
+	optional<size_t> parseLength(const char* first, const char* last) const;
+
+	/// Puts back the byte replaced by the last terminator.
+	void restoreTerminator();
+
+	/// True while a body given by take() still uses the buffer.
+	bool isShared() const;
+
+	/// Moves the bytes not consumed to a new buffer of the size given.
+	void reallocate(size_t size);
+
+	/// Consumes the next complete body and returns where it starts.
+	optional<size_t> consume();
+
+	/// Consumes the next header and sets the bodyLength.
+	/// Returns false if the header isn't complete yet or if it's invalid.
+	bool readHeader();
+
+	/// Parses the fields of a header, without its "\r\n\r\n". Sets
+	/// the length if it has one. Returns false if it's invalid.
+	bool parseHeader(const char* first, const char* last,
+		optional<size_t>& length) const;
+
+	/// Consumes size of the lent bytes.
+	void skipLent(size_t size);
+
+	/// Copies the lent bytes that complete the frame in the buffer.
+	void completeFromLent();
+
+	/// Consumes the next frame of the lent bytes, the buffer must be empty.
+	/// Returns its body if it's complete, otherwise its start is copied to
+	/// the buffer.
+	optional<pair<shared_ptr<char>, size_t>> takeLent();
+
+public:
+	/// The longest body accepted by default, 64 MiB.
+	constexpr static size_t defaultMaxFrameSize = 64 << 20;
+
+	/// Sets the longest body accepted. A longer one makes the stream
+	/// invalid instead of growing the buffer.
+	void setMaxFrameSize(size_t size);
+
+	/// True after a header with a negative, malformed or too long
+	/// Content-Length. The session must end, the stream can't be resumed.
+	bool isInvalid() const;
+
+	/// Returns a writable space at the end of the buffer to read the next
+	/// bytes of the stream. The space is big enough to hold the rest of the
+	/// current message when its length is known.
+	pair<char*, size_t> prepare();
+
+	/// Marks size bytes of the space given by prepare() as read.
+	void commit(size_t size);
+
+	/// Copies some bytes of the stream to the buffer.
+	void feed(const char* data, size_t size);
+
+	/// Adds bytes lent by Transport::lend(). Only take() reads them in
+	/// place, they must be taken before anything else is read.
+	void commit(shared_ptr<char> bytes, size_t size);
+
+	/// Returns the next complete body. The body is null terminated, can be
+	/// modified and it's valid until the next call to any other function.
+	/// Returns nullopt when the stream is invalid.
+	optional<pair<char*, size_t>> next();
+
+	/// Returns the next complete body with a share of the buffer that keeps
+	/// it alive, so it can be used by another thread. The body isn't null
+	/// terminated and the reader never touches it again.
+	/// Returns nullopt when the stream is invalid.
+	optional<pair<shared_ptr<char>, size_t>> take();
+
+	/// Discards all the bytes read and the invalid state, but keeps the
+	/// buffer if no taken body uses it.
+	void clear();
+
+	FrameReader();
+
+	virtual ~FrameReader();
+};
+
+}
@@ -0,0 +1,158 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <libclsp/server/jsonWriter.hpp>
+#include <libclsp/server/transport.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// Gathers the frames sent to a transport and writes them together, with
+/// their headers, in a single writev().
+///
+/// Any thread can push frames, they go to a lock-free multi-producer
+/// single-consumer queue emptied by the writer thread. A producer never
+/// waits for a write, the mutex is only taken to wake up the writer when
+/// it sleeps.
+///
+/// Deferred frames wait for flush(). The others are written at once, or
+/// within the flush latency when it's not zero.
+class FrameWriter
+{
+private:
+	/// A header and the json of a message
+	struct Frame
+	{
+		char header[48];
+
+		size_t headerSize;
+
+		unique_ptr<JsonWriter> body;
+
+		/// The frame pushed before this one
+		Frame* next;
+	};
+
+	/// The bytes that make a batch be written at once
+	constexpr static size_t maxBatchSize = 1 << 20;
+
+	/// The transport written by the writer
+	atomic<Transport*> transport = nullptr;
+
+	/// The frames waiting to be written, the newest first.
+	/// The writer takes all of them at once.
+	atomic<Frame*> frames = nullptr;
+
+	/// The bytes of the frames waiting
+	atomic<size_t> batchSize = 0;
+
+	/// When the oldest frame waiting was added, in steady_clock ticks
+	atomic<chrono::steady_clock::rep> oldest = 0;
+
+	/// The number of frames pushed
+	atomic<uint64_t> pushed = 0;
+
+	/// The frames that must be written without waiting more
+	atomic<uint64_t> requested = 0;
+
+	/// The number of frames written or discarded
+	atomic<uint64_t> written = 0;
+
+	/// The longest time a frame waits, in microseconds
+	atomic<chrono::microseconds::rep> flushLatency = 0;
+
+	/// Writes the batches in order
+	thread writer;
+
+	/// Set while the writer runs
+	atomic<bool> writing = false;
+
+	/// Stops the writer
+	atomic<bool> stopping = false;
+
+	/// Set when the transport can't be written anymore. The frames are
+	/// discarded until the next transport.
+	atomic<bool> failed = false;
+
+	/// Set while the writer sleeps
+	atomic<bool> writerWaiting = false;
+
+	/// The threads waiting in drain()
+	atomic<int> drainers = 0;
+
+	/// A mutex to sleep and to wake up the sleepers.
+	mutex waitMutex;
+
+	/// Wakes up the writer.
+	condition_variable writerCondition;
+
+	/// Wakes up drain().
+	condition_variable drainCondition;
+
+	/// Wakes up the writer if it sleeps.
+	void wakeWriter();
+
+	/// Asks the writer to write the first count frames at once.
+	void request(uint64_t count);
+
+	/// The loop of the writer thread.
+	void writeLoop();
+
+	/// Writes all the frames waiting. Returns false if there were none.
+	/// A failed write interrupts the transport.
+	bool writeBatch();
+
+public:
+	/// Adds a frame with the json of a message.
+	/// A deferred frame waits for flush() or the flush latency.
+	void push(unique_ptr<JsonWriter> body, bool deferred);
+
+	/// Makes the writer write all the frames waiting with one writev().
+	/// It doesn't wait for the write.
+	void flush();
+
+	/// Same as flush() but it waits until the frames are written.
+	void drain();
+
+	/// True after a write to the transport failed, the session must end.
+	bool hasFailed() const;
+
+	/// Changes the transport. The frames waiting are written first.
+	/// The writer starts with the first transport.
+	void setTransport(Transport* transport);
+
+	/// Sets the longest time a frame can wait to be batched with others.
+	/// With zero, the frames that aren't deferred are written at once.
+	void setFlushLatency(chrono::microseconds latency);
+
+	FrameWriter();
+
+	virtual ~FrameWriter();
+};
+
+}
@@ -0,0 +1,124 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include <libclsp/server/cancellationToken.hpp>
+#include <libclsp/server/threadPool.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// Runs background tasks only while the client is idle, when no input
+/// arrived for some time. Like re-indexing, warming the caches of the
+/// document of the last hover or computing the symbols of a new document.
+///
+/// The tasks run in the pool with background priority. When input arrives
+/// their cancellation is signaled, they stop at their next check and run
+/// again in the next idle period. So idle CPU is used without slowing down
+/// the typing.
+class IdleScheduler
+{
+public:
+	using Clock = ThreadPool::Clock;
+
+	/// A task that runs while the client is idle. It checks the token often
+	/// and returns false if it stopped before the end, then it runs again.
+	/// A task can also do its work in steps this way.
+	using IdleTask = function<bool(CancellationToken)>;
+
+private:
+	/// The pool that runs the tasks
+	ThreadPool& pool;
+
+	/// How long the input must stop before the tasks run
+	atomic<Clock::duration::rep> delay;
+
+	/// When the last input arrived
+	atomic<Clock::duration::rep> lastActivity;
+
+	/// Set during an idle period
+	atomic<bool> idle = false;
+
+	/// A mutex for the state below
+	mutex idleMutex;
+
+	/// The tasks waiting for an idle period
+	deque<IdleTask> queue;
+
+	/// Cancelled when the idle period ends
+	CancellationToken period;
+
+	/// The timer that starts the next idle period
+	optional<uint64_t> timer;
+
+	/// The tasks running and the timer, the destructor waits for them.
+	size_t pending = 0;
+
+	/// Notified when pending gets to 0
+	condition_variable pendingCondition;
+
+	/// Set by the destructor
+	bool stopping = false;
+
+	/// Schedules the timer if it isn't. idleMutex must be locked.
+	void armTimer();
+
+	/// Called by the timer, starts an idle period if the input stopped.
+	void wake();
+
+	/// Runs a task in the pool. idleMutex must be locked.
+	void start(IdleTask task);
+
+	/// Ends a task, it's queued again if it's not done.
+	void finish(IdleTask task, bool done, CancellationToken token);
+
+	/// Ends something pending. idleMutex must be locked.
+	void release();
+
+public:
+	/// Runs a task in this or in the next idle period.
+	void post(IdleTask task);
+
+	/// Tells that input arrived. It ends the idle period, the running tasks
+	/// see their cancellation. Cheap if there is no idle period.
+	void activity();
+
+	/// True during an idle period
+	bool isIdle() const;
+
+	/// Sets how long the input must stop before the tasks run.
+	void setDelay(chrono::milliseconds delay);
+
+	IdleScheduler(ThreadPool& pool,
+		chrono::milliseconds delay = chrono::milliseconds(500));
+
+	/// Stops the tasks and waits for the running ones.
+	virtual ~IdleScheduler();
+};
+
+}
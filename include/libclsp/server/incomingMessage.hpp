@@ -0,0 +1,191 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <any>
+#include <memory>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include <libclsp/server/cancellationToken.hpp>
+#include <libclsp/server/envelope.hpp>
+#include <libclsp/server/jsonWriter.hpp>
+#include <libclsp/types/jsonTypes.hpp>
+#include <libclsp/types/objectT.hpp>
+#include <libclsp/types/responseMessage.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+class Server;
+
+/// A message from the client that can be a request, a notification or a
+/// response. The kind is known after the parsing.
+///
+/// The params and the result are parsed with the readers of the capability
+/// of the method. When they come before "method" or "id", their raw JSON is
+/// kept and parsed by parseDeferred() once the object is complete.
+///
+struct IncomingMessage: public ObjectT
+{
+private:
+	constexpr static Key jsonrpcKey = "jsonrpc";
+	constexpr static Key idKey      = "id";
+	constexpr static Key methodKey  = "method";
+	constexpr static Key paramsKey  = "params";
+	constexpr static Key resultKey  = "result";
+	constexpr static Key errorKey   = "error";
+
+	/// A reference to the lsp server
+	Server& server;
+
+	/// Values that no capability can read end here.
+	Any skipped;
+
+	/// A params or a result found before the member that picks its reader.
+	struct Deferred
+	{
+		/// paramsSetter() or resultSetter()
+		ValueSetter (IncomingMessage::*getSetter)(JsonHandler&);
+
+		/// The raw JSON of the value. It's copied out of the body, because
+		/// the in-situ parse rewrites the strings that it skips.
+		String raw;
+	};
+
+	/// The values waiting for parseDeferred()
+	vector<Deferred> deferred;
+
+	/// Returns the setter of the params using the method found.
+	ValueSetter paramsSetter(JsonHandler& handler);
+
+	/// Returns the setter of the result using the method of the request
+	/// sent with the id found.
+	ValueSetter resultSetter(JsonHandler& handler);
+
+	/// Makes a setter that gets the real one when the value is found.
+	ValueSetter lazySetter(JsonHandler& handler,
+		ValueSetter (IncomingMessage::*getSetter)(JsonHandler&));
+
+	/// Makes a setter that accepts anything and discards it.
+	ValueSetter skipSetter(JsonHandler& handler);
+
+	/// Makes a setter that keeps the raw JSON of a value for
+	/// parseDeferred().
+	ValueSetter deferSetter(JsonHandler& handler,
+		ValueSetter (IncomingMessage::*getSetter)(JsonHandler&));
+
+public:
+	/// The request id. Missing in notifications.
+	optional<variant<Number, String, Null>> id;
+
+	/// The method to be invoked. Missing in responses.
+	optional<String> method;
+
+	/// The method's params.
+	Envelope params;
+
+	/// The result of a request sent to the client.
+	Envelope result;
+
+	/// The error of a request sent to the client.
+	optional<ResponseError> error;
+
+	/// Set when the params or the result can't be read by the capability.
+	bool invalidParams = false;
+
+	/// Set when the message is part of a batch.
+	bool batched = false;
+
+	/// The response of a batched request, it's sent with the others of the
+	/// batch.
+	unique_ptr<JsonWriter> response;
+
+	/// Set when the request is added to the requests of the server.
+	bool received = false;
+
+	/// The cancellation of a request, set when it's received. It's null
+	/// until then.
+	CancellationToken cancellation = CancellationToken(nullptr);
+
+
+	/// The request id without the Null option.
+	optional<variant<Number, String>> requestId() const;
+
+	/// Parses the params or the result that came before the member that
+	/// picks their reader. It's called after the whole body is parsed.
+	void parseDeferred();
+
+
+	//====================   Parsing   ======================================//
+
+	/// This fills an ObjectInitializer
+	virtual void fillInitializer(ObjectInitializer& initializer);
+
+	// Using default isValid()
+
+	//=======================================================================//
+
+
+	IncomingMessage(Server& server);
+
+	virtual ~IncomingMessage();
+};
+
+/// The messages of one frame: a single message or a JSON-RPC batch, an
+/// array of messages.
+///
+/// The entries of a batch that aren't objects are kept as nullptr, they're
+/// answered with an InvalidRequest error.
+///
+struct IncomingFrame: public ObjectT
+{
+private:
+	/// A reference to the lsp server
+	Server& server;
+
+	/// The entries that are arrays end here.
+	Array skipped;
+
+public:
+	/// The messages in order
+	vector<unique_ptr<IncomingMessage>> messages;
+
+	/// Set when the frame is an array
+	bool batch = false;
+
+
+	//====================   Parsing   ======================================//
+
+	/// This fills an ObjectInitializer for the array of a batch
+	virtual void fillInitializer(ObjectInitializer& initializer);
+
+	// Using default isValid()
+
+	//=======================================================================//
+
+
+	IncomingFrame(Server& server);
+
+	virtual ~IncomingFrame();
+};
+
+}
@@ -33,6 +33,7 @@ using namespace std;
 using namespace rapidjson;
 
 struct JsonHandler;
+struct InsituBodyStream;
 
 /// Functions to initialize a json member
 struct ValueSetter
@@ -61,7 +62,7 @@ struct ValueSetter
 struct ObjectInitializer
 {
 	/// The key from which the object is the value
-	Key key;
+	clsp::String key;
 
 	/// A map with the keys of the object and it's initializers
 	map<Key, ValueSetter> setterMap;
@@ -95,6 +96,9 @@ struct JsonHandler: public BaseReaderHandler<UTF8<>, JsonHandler>
 	/// Last key obtained by Key()
 	clsp::String lastKey;
 
+	/// The body being parsed, when the raw JSON of a value is needed.
+	InsituBodyStream* stream = nullptr;
+
 	// Functions needed by the RapidJson reader.
 
 	bool Null();
@@ -122,4 +126,40 @@ struct JsonHandler: public BaseReaderHandler<UTF8<>, JsonHandler>
 	void pushInitializer();
 };
 
+/// An in-situ stream over a body that isn't null terminated, its end is
+/// read as a null character. The decoded strings are written back into the
+/// body, never past its end.
+struct InsituBodyStream
+{
+	typedef char Ch;
+
+	/// The next byte to read
+	char* src;
+
+	/// The next byte to write
+	char* dst;
+
+	/// The first byte
+	char* head;
+
+	/// The end of the body
+	char* last;
+
+	Ch Peek() const;
+
+	Ch Take();
+
+	size_t Tell() const;
+
+	Ch* PutBegin();
+
+	void Put(Ch c);
+
+	void Flush();
+
+	size_t PutEnd(Ch* begin);
+
+	InsituBodyStream(char* body, size_t size);
+};
+
 }
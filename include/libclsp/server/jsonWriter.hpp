@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include <rapidjson/writer.h>
 
 #include <libclsp/types/jsonTypes.hpp>
@@ -36,6 +38,20 @@ struct overload : Fs...
 	using Fs::operator()...;
 };
 
+/// Tells if a type is a vector<>
+template<class T>
+struct isVector: false_type{};
+
+template<class T>
+struct isVector<vector<T>>: true_type{};
+
+/// Tells if a type is a variant<>
+template<class T>
+struct isVariant: false_type{};
+
+template<class ...Ts>
+struct isVariant<variant<Ts...>>: true_type{};
+
 /// A writer with some extra functions
 class JsonWriter: public Writer<StringBuffer>
 {
@@ -60,10 +76,73 @@ public:
 	/// Writes almost anything
 	bool Any(Any &a);
 
+	/// Writes a value of a protocol type, like the result of a method.
+	/// The type is known at compile time, so it doesn't need an any.
+	template<class T>
+	bool Value(T &value)
+	{
+		if constexpr(is_base_of_v<ObjectT, T>)
+		{
+			return Object(value);
+		}
+		else if constexpr(is_same_v<T, clsp::Object>)
+		{
+			return Object(*value);
+		}
+		else if constexpr(is_same_v<T, clsp::Null>)
+		{
+			return Null();
+		}
+		else if constexpr(is_same_v<T, Boolean>)
+		{
+			return Bool(value);
+		}
+		else if constexpr(is_same_v<T, int>)
+		{
+			return Int(value);
+		}
+		else if constexpr(is_same_v<T, double>)
+		{
+			return Double(value);
+		}
+		else if constexpr(is_same_v<T, clsp::String>)
+		{
+			return String(value);
+		}
+		else if constexpr(isVector<T>::value)
+		{
+			bool result = StartArray();
+
+			for(auto& i: value)
+			{
+				result &= Value(i);
+			}
+
+			return result & EndArray();
+		}
+		else
+		{
+			static_assert(isVariant<T>::value, "Not a protocol type");
+
+			return visit([this](auto& alternative)
+			{
+				return Value(alternative);
+			}, value);
+		}
+	}
+
+	using Writer<StringBuffer>::String;
+
+	/// Writes a string constant, like the value of a kind.
+	bool String(string_view str)
+	{
+		return Writer<StringBuffer>::String(str.data(), str.size());
+	}
+
 	/// Writes a new key
-	bool Key(clsp::Key& str)
+	bool Key(clsp::Key str)
 	{
-		return Writer<StringBuffer>::Key(str.c_str(), str.size());
+		return Writer<StringBuffer>::Key(str.data(), str.size());
 	}
 
 
@@ -72,6 +151,12 @@ public:
 	{
 		return buffer.GetString();
 	}
+
+	/// Gets the size of the json
+	size_t GetSize() const
+	{
+		return buffer.GetSize();
+	}
 };
 
 
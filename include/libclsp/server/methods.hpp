@@ -0,0 +1,493 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <any>
+#include <functional>
+#include <variant>
+
+#include <libclsp/server/capability.hpp>
+#include <libclsp/server/incomingMessage.hpp>
+#include <libclsp/server/server.hpp>
+#include <libclsp/types.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// A request from the client, with the types of its params and its result.
+/// Methods without params have Null params.
+template<class P, class R>
+struct RequestMethod
+{
+	using Params = P;
+	using Result = R;
+
+	/// The function that answers the requests of the method.
+	using Handler =
+		function<variant<Result, ResponseError>(Params&, RequestMessage&)>;
+
+	constexpr static bool isRequest = true;
+};
+
+/// A notification from the client, with the type of its params.
+template<class P>
+struct NotificationMethod
+{
+	using Params = P;
+
+	/// The function that processes the notifications of the method.
+	using Handler = function<void(Params&, NotificationMessage&)>;
+
+	constexpr static bool isRequest = false;
+};
+
+// Requests from the client
+
+struct Initialize: public RequestMethod<InitializeParams, InitializeResult>
+{
+	static const Capability& capability()
+	{
+		return Capability::initialize;
+	}
+};
+
+struct Shutdown: public RequestMethod<Null, Null>
+{
+	static const Capability& capability()
+	{
+		return Capability::shutdown;
+	}
+};
+
+struct WorkspaceSymbol: public RequestMethod<WorkspaceSymbolParams,
+	variant<vector<SymbolInformation>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::workspaceSymbol;
+	}
+};
+
+struct WorkspaceExecuteCommand: public RequestMethod<ExecuteCommandParams,
+	variant<Any, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::workspaceExecuteCommand;
+	}
+};
+
+struct TextDocumentWillSaveWaitUntil: public RequestMethod<WillSaveTextDocumentParams,
+	variant<vector<TextEdit>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentWillSaveWaitUntil;
+	}
+};
+
+struct TextDocumentCompletion: public RequestMethod<CompletionParams,
+	variant<vector<CompletionItem>, CompletionList, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentCompletion;
+	}
+};
+
+struct CompletionItemResolve: public RequestMethod<CompletionItem,
+	CompletionItem>
+{
+	static const Capability& capability()
+	{
+		return Capability::completionItemResolve;
+	}
+};
+
+struct TextDocumentHover: public RequestMethod<HoverParams,
+	variant<Hover, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentHover;
+	}
+};
+
+struct TextDocumentSignatureHelp: public RequestMethod<SignatureHelpParams,
+	variant<SignatureHelp, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentSignatureHelp;
+	}
+};
+
+struct TextDocumentDeclaration: public RequestMethod<DeclarationParams,
+	variant<Location, vector<Location>, vector<LocationLink>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDeclaration;
+	}
+};
+
+struct TextDocumentDefinition: public RequestMethod<DefinitionParams,
+	variant<Location, vector<Location>, vector<LocationLink>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDefinition;
+	}
+};
+
+struct TextDocumentTypeDefinition: public RequestMethod<TypeDefinitionParams,
+	variant<Location, vector<Location>, vector<LocationLink>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentTypeDefinition;
+	}
+};
+
+struct TextDocumentImplementation: public RequestMethod<ImplementationParams,
+	variant<Location, vector<Location>, vector<LocationLink>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentImplementation;
+	}
+};
+
+struct TextDocumentReferences: public RequestMethod<ReferenceParams,
+	variant<vector<Location>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentReferences;
+	}
+};
+
+struct TextDocumentDocumentHighlight: public RequestMethod<DocumentHighlightParams,
+	variant<vector<DocumentHighlight>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDocumentHighlight;
+	}
+};
+
+struct TextDocumentDocumentSymbol: public RequestMethod<DocumentSymbolParams,
+	variant<vector<DocumentSymbol>, vector<SymbolInformation>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDocumentSymbol;
+	}
+};
+
+struct TextDocumentCodeAction: public RequestMethod<CodeActionParams,
+	variant<vector<variant<Command, CodeAction>>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentCodeAction;
+	}
+};
+
+struct TextDocumentCodeLens: public RequestMethod<CodeLensParams,
+	variant<vector<CodeLens>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentCodeLens;
+	}
+};
+
+struct CodeLensResolve: public RequestMethod<CodeLens, CodeLens>
+{
+	static const Capability& capability()
+	{
+		return Capability::codeLensResolve;
+	}
+};
+
+struct TextDocumentDocumentLink: public RequestMethod<DocumentLinkParams,
+	variant<vector<DocumentLink>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDocumentLink;
+	}
+};
+
+struct DocumentLinkResolve: public RequestMethod<DocumentLink, DocumentLink>
+{
+	static const Capability& capability()
+	{
+		return Capability::documentLinkResolve;
+	}
+};
+
+struct TextDocumentDocumentColor: public RequestMethod<DocumentColorParams,
+	vector<ColorInformation>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDocumentColor;
+	}
+};
+
+struct TextDocumentColorPresentation: public RequestMethod<ColorPresentationParams,
+	vector<ColorPresentation>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentColorPresentation;
+	}
+};
+
+struct TextDocumentFormatting: public RequestMethod<DocumentFormattingParams,
+	variant<vector<TextEdit>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentFormatting;
+	}
+};
+
+struct TextDocumentRangeFormatting: public RequestMethod<DocumentRangeFormattingParams,
+	variant<vector<TextEdit>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentRangeFormatting;
+	}
+};
+
+struct TextDocumentOnTypeFormatting: public RequestMethod<DocumentOnTypeFormattingParams,
+	variant<vector<TextEdit>, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentOnTypeFormatting;
+	}
+};
+
+struct TextDocumentRename: public RequestMethod<RenameParams,
+	variant<WorkspaceEdit, Null>>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentRename;
+	}
+};
+
+// Notifications from the client
+
+struct CancelRequest: public NotificationMethod<CancelParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::cancelRequest;
+	}
+};
+
+struct Progress: public NotificationMethod<ProgressParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::progress;
+	}
+};
+
+struct Initialized: public NotificationMethod<InitializedParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::initialized;
+	}
+};
+
+struct Exit: public NotificationMethod<Null>
+{
+	static const Capability& capability()
+	{
+		return Capability::exit;
+	}
+};
+
+struct WindowWorkDoneProgressCancel: public NotificationMethod<WorkDoneProgressCancelParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::windowWorkDoneProgressCancel;
+	}
+};
+
+struct WorkspaceDidChangeWorkspaceFolders: public NotificationMethod<DidChangeWorkspaceFoldersParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::workspaceDidChangeWorkspaceFolders;
+	}
+};
+
+struct WorkspaceDidChangeConfiguration: public NotificationMethod<DidChangeConfigurationParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::workspaceDidChangeConfiguration;
+	}
+};
+
+struct WorkspaceDidChangeWatchedFiles: public NotificationMethod<DidChangeWatchedFilesParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::workspaceDidChangeWatchedFiles;
+	}
+};
+
+struct TextDocumentDidOpen: public NotificationMethod<DidOpenTextDocumentParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDidOpen;
+	}
+};
+
+struct TextDocumentDidChange: public NotificationMethod<DidChangeTextDocumentParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDidChange;
+	}
+};
+
+struct TextDocumentWillSave: public NotificationMethod<WillSaveTextDocumentParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentWillSave;
+	}
+};
+
+struct TextDocumentDidSave: public NotificationMethod<DidSaveTextDocumentParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDidSave;
+	}
+};
+
+struct TextDocumentDidClose: public NotificationMethod<DidCloseTextDocumentParams>
+{
+	static const Capability& capability()
+	{
+		return Capability::textDocumentDidClose;
+	}
+};
+
+/// Defined here, it needs the types of the params and the results.
+template<class Method>
+void Server::on(typename Method::Handler handler)
+{
+	using Params = typename Method::Params;
+
+	String method(Method::capability().method);
+
+	// The params can't be parsed without it. One added before, like with a
+	// deadline, is kept.
+	if(findCapability(method) == nullptr)
+	{
+		addCapability(Method::capability());
+	}
+
+	if constexpr(Method::isRequest)
+	{
+		onWritingRequest(method, [handler](IncomingMessage& message,
+			RequestMessage& request)
+		{
+			// The handlers are shared by the sessions, the response goes
+			// to the one that received the request.
+			Server& session = request.getServer();
+
+			Null noParams;
+			Params* params;
+
+			if constexpr(is_same_v<Params, Null>)
+			{
+				params = &noParams;
+			}
+			else if(request.params.has_value())
+			{
+				params = &request.params.get<Params>();
+			}
+			else
+			{
+				session.respond(message, ResponseError(
+					ErrorCodes::InvalidParams, "Invalid params", nullopt));
+				return false;
+			}
+
+			auto resultOrError = handler(*params, request);
+
+			if(auto* error = get_if<ResponseError>(&resultOrError))
+			{
+				session.respond(message, move(*error));
+				return false;
+			}
+
+			auto& result = get<0>(resultOrError);
+
+			session.writeResponse(message, [&result](JsonWriter& writer)
+			{
+				writer.Value(result);
+			});
+
+			return true;
+		});
+	}
+	else
+	{
+		onNotification(method, [handler](NotificationMessage& notification)
+		{
+			Null noParams;
+			Params* params;
+
+			if constexpr(is_same_v<Params, Null>)
+			{
+				params = &noParams;
+			}
+			else if(notification.params.has_value())
+			{
+				params = &notification.params.get<Params>();
+			}
+			else
+			{
+				// Nothing to process
+				return;
+			}
+
+			handler(*params, notification);
+		});
+	}
+}
+
+}
@@ -0,0 +1,145 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include <libclsp/server/transport.hpp>
+#include <libclsp/types/jsonTypes.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// A transport that records all the bytes of another one in a session log.
+///
+/// The log is an append-only file written through a shared mapping, so a
+/// record is only a copy and it survives a crash of the process. Each read
+/// and each write is one record with its direction and the monotonic time
+/// since the start of the recording.
+///
+/// Layout of the log, little endian and 8 bytes aligned:
+///
+/// - Header: "clsplog1", the realtime clock at the start in nanoseconds.
+/// - Records: the time in nanoseconds, the size of the bytes, the
+///   direction (1 input, 2 output), 3 bytes of padding, then the bytes
+///   padded to 8. A direction of 0 ends the log.
+///
+class RecordingTransport: public Transport
+{
+private:
+	/// The recorded transport
+	Transport& transport;
+
+	/// The log descriptor
+	int fd = -1;
+
+	/// The mapping of the log
+	char* log = nullptr;
+
+	/// The size of the file and the mapping
+	size_t capacity = 0;
+
+	/// The end of the last record
+	size_t end = 0;
+
+	/// When the recording started
+	chrono::steady_clock::time_point start;
+
+	/// A mutex for the log, it's written by the reader and the writer.
+	mutex logMutex;
+
+	/// Appends a record with the bytes of all the parts.
+	void append(uint8_t direction, const iovec* parts, size_t count);
+
+public:
+	virtual ssize_t read(char* buffer, size_t size);
+
+	virtual bool write(const char* data, size_t size);
+
+	virtual bool writev(const iovec* parts, size_t count);
+
+	virtual void interrupt();
+
+	virtual bool wait();
+
+	/// False if the log couldn't be created.
+	bool isValid() const;
+
+	/// Records the transport in a new log at path.
+	RecordingTransport(Transport& transport, String path);
+
+	virtual ~RecordingTransport();
+};
+
+/// A transport that reads the input of a session log made by
+/// RecordingTransport. The output is discarded.
+class ReplayTransport: public Transport
+{
+private:
+	/// The mapping of the log
+	const char* log = nullptr;
+
+	/// The size of the log
+	size_t size = 0;
+
+	/// The next record
+	size_t next = 0;
+
+	/// The bytes of the current record not read yet
+	const char* pending = nullptr;
+	size_t pendingSize = 0;
+
+	/// Set to wait the times of the log between the records.
+	bool realTime;
+
+	/// The time of the first input record
+	optional<uint64_t> firstTime;
+
+	/// When the first input record was read
+	chrono::steady_clock::time_point replayStart;
+
+	/// The bytes written by the server
+	atomic<size_t> written = 0;
+
+	/// Moves to the next input record. Returns false at the end of the log.
+	bool nextInput();
+
+public:
+	virtual ssize_t read(char* buffer, size_t size);
+
+	virtual bool write(const char* data, size_t size);
+
+	/// False if the log couldn't be read.
+	bool isValid() const;
+
+	/// The bytes written by the server so far
+	size_t writtenSize() const;
+
+	/// Replays the log at path. With realTime the input arrives at the
+	/// original speed, otherwise as fast as possible.
+	ReplayTransport(String path, bool realTime);
+
+	virtual ~ReplayTransport();
+};
+
+}
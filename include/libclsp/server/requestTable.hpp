@@ -0,0 +1,419 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <libclsp/types/jsonTypes.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The requests in flight of a session, by id.
+///
+/// The ids are split in shards with their own lock, so the handlers of
+/// different requests rarely wait for each other. Each shard is an open
+/// addressing table with linear probing: the entries live in one vector
+/// and adding a request doesn't allocate once it's big enough. Integer ids
+/// are stored inline, the others are kept by their hash and compared in
+/// full only when the hashes match. The string ids are copied in the slot,
+/// only the very long ones allocate. The free slots hold a default Entry,
+/// so it must not allocate.
+template <typename Entry>
+class RequestTable
+{
+public:
+	using Id = variant<Number, String>;
+
+private:
+	/// The number of shards, a power of two.
+	constexpr static size_t shardCount = 16;
+
+	/// The slots of a new shard, a power of two.
+	constexpr static size_t initialSlots = 8;
+
+	enum class Kind: uint8_t
+	{
+		empty,
+
+		/// An entry was erased, the probes go on.
+		erased,
+
+		integer,
+		real,
+		string
+	};
+
+	/// The longest string id kept in the slot
+	constexpr static size_t shortNameSize = 40;
+
+	/// An id to look for, it only views a string id.
+	struct Probe
+	{
+		Kind kind;
+
+		/// The integer, the bits of the real or the hash of the string.
+		uint64_t value = 0;
+
+		string_view name;
+	};
+
+	/// A compact id
+	struct Key
+	{
+		Kind kind = Kind::empty;
+
+		/// The size of a string id
+		uint32_t nameSize = 0;
+
+		/// The integer, the bits of the real or the hash of the string.
+		uint64_t value = 0;
+
+		/// A string id that fits, most of them do.
+		array<char, shortNameSize> shortName = {};
+
+		/// A longer string id
+		String longName;
+
+		string_view name() const
+		{
+			if(nameSize <= shortNameSize)
+			{
+				return string_view(shortName.data(), nameSize);
+			}
+
+			return longName;
+		}
+
+		Key() = default;
+
+		/// Copies the id of the probe.
+		explicit Key(const Probe& probe):
+			kind(probe.kind),
+			nameSize(probe.name.size()),
+			value(probe.value)
+		{
+			if(nameSize <= shortNameSize)
+			{
+				probe.name.copy(shortName.data(), nameSize);
+			}
+			else
+			{
+				longName = probe.name;
+			}
+		};
+	};
+
+	struct Slot
+	{
+		Key key;
+
+		Entry entry;
+	};
+
+	struct alignas(64) Shard
+	{
+		mutex shardMutex;
+
+		/// A power of two, or empty.
+		vector<Slot> slots;
+
+		/// The entries and the erased slots, they grow the table.
+		size_t used = 0;
+
+		/// The entries only
+		size_t size = 0;
+	};
+
+	array<Shard, shardCount> shards;
+
+	/// Mixes the bits so that the low ones depend on all of them.
+	static uint64_t mix(uint64_t value)
+	{
+		// splitmix64
+		value ^= value >> 30;
+		value *= 0xbf58476d1ce4e5b9u;
+		value ^= value >> 27;
+		value *= 0x94d049bb133111ebu;
+		value ^= value >> 31;
+
+		return value;
+	}
+
+	static Probe probeOf(const Id& id)
+	{
+		Probe probe;
+
+		if(auto string = get_if<String>(&id))
+		{
+			probe.kind  = Kind::string;
+			probe.name  = *string;
+			probe.value = hash<string_view>()(probe.name);
+		}
+		else if(auto integer = get_if<int>(&get<Number>(id)))
+		{
+			probe.kind  = Kind::integer;
+			probe.value = static_cast<uint32_t>(*integer);
+		}
+		else
+		{
+			double real = get<double>(get<Number>(id));
+
+			probe.kind = Kind::real;
+			memcpy(&probe.value, &real, sizeof(real));
+		}
+
+		return probe;
+	}
+
+	static Id idOf(const Key& key)
+	{
+		switch(key.kind)
+		{
+			case Kind::integer:
+			{
+				auto integer = static_cast<uint32_t>(key.value);
+
+				return Number(static_cast<int>(integer));
+			}
+
+			case Kind::real:
+			{
+				double real;
+				memcpy(&real, &key.value, sizeof(real));
+
+				return Number(real);
+			}
+
+			default:
+				return String(key.name());
+		}
+	}
+
+	static bool matches(const Key& slot, const Probe& probe)
+	{
+		return slot.kind == probe.kind && slot.value == probe.value &&
+			(probe.kind != Kind::string || slot.name() == probe.name);
+	}
+
+	Shard& shardOf(const Probe& probe)
+	{
+		return shards[mix(probe.value) & (shardCount - 1)];
+	}
+
+	/// The slot of the key in the shard, or null. The shard is locked.
+	static Slot* find(Shard& shard, const Probe& probe)
+	{
+		if(shard.slots.empty())
+		{
+			return nullptr;
+		}
+
+		size_t mask = shard.slots.size() - 1;
+
+		// The shard takes the low bits, the slot the high ones
+		for(size_t i = (mix(probe.value) >> 32) & mask;; i = (i + 1) & mask)
+		{
+			Slot& slot = shard.slots[i];
+
+			if(slot.key.kind == Kind::empty)
+			{
+				return nullptr;
+			}
+
+			if(matches(slot.key, probe))
+			{
+				return &slot;
+			}
+		}
+	}
+
+	/// The first free slot of a key with the value. The shard is locked
+	/// and has space.
+	static Slot& freeSlot(Shard& shard, uint64_t value)
+	{
+		size_t mask = shard.slots.size() - 1;
+
+		for(size_t i = (mix(value) >> 32) & mask;; i = (i + 1) & mask)
+		{
+			Slot& slot = shard.slots[i];
+
+			if(slot.key.kind == Kind::empty || slot.key.kind == Kind::erased)
+			{
+				return slot;
+			}
+		}
+	}
+
+	/// Makes space for one more entry, it drops the erased slots. The
+	/// shard is locked.
+	static void reserve(Shard& shard)
+	{
+		// At most half full, so the probes stay short
+		if((shard.used + 1) * 2 <= shard.slots.size())
+		{
+			return;
+		}
+
+		size_t size = initialSlots;
+
+		while(size < (shard.size + 1) * 4)
+		{
+			size *= 2;
+		}
+
+		vector<Slot> old = move(shard.slots);
+
+		shard.slots = vector<Slot>(size);
+		shard.used  = shard.size;
+
+		for(Slot& slot: old)
+		{
+			if(slot.key.kind != Kind::empty && slot.key.kind != Kind::erased)
+			{
+				freeSlot(shard, slot.key.value) = move(slot);
+			}
+		}
+	}
+
+	/// Frees a slot. The shard is locked.
+	static void erase(Shard& shard, Slot& slot)
+	{
+		slot.key   = Key();
+		slot.entry = Entry();
+
+		slot.key.kind = Kind::erased;
+
+		shard.size--;
+	}
+
+public:
+	/// Adds an entry if the id is new, then runs f(entry, added) with the
+	/// entry of the id while its shard is locked.
+	template <typename F>
+	void emplace(const Id& id, Entry entry, F f)
+	{
+		Probe probe = probeOf(id);
+		Shard& shard = shardOf(probe);
+
+		lock_guard lock(shard.shardMutex);
+
+		if(Slot* slot = find(shard, probe))
+		{
+			f(slot->entry, false);
+			return;
+		}
+
+		reserve(shard);
+
+		Slot& slot = freeSlot(shard, probe.value);
+
+		if(slot.key.kind == Kind::empty)
+		{
+			shard.used++;
+		}
+
+		shard.size++;
+
+		slot.key   = Key(probe);
+		slot.entry = move(entry);
+
+		f(slot.entry, true);
+	}
+
+	/// Adds an entry if the id is new.
+	void emplace(const Id& id, Entry entry)
+	{
+		emplace(id, move(entry), [](Entry&, bool){});
+	}
+
+	/// Runs f(entry) with the entry of the id while its shard is locked.
+	/// Returns false if there's no entry.
+	template <typename F>
+	bool update(const Id& id, F f)
+	{
+		Probe probe = probeOf(id);
+		Shard& shard = shardOf(probe);
+
+		lock_guard lock(shard.shardMutex);
+
+		Slot* slot = find(shard, probe);
+
+		if(slot == nullptr)
+		{
+			return false;
+		}
+
+		f(slot->entry);
+
+		return true;
+	}
+
+	/// Removes the entry of the id and returns it.
+	optional<Entry> take(const Id& id)
+	{
+		Probe probe = probeOf(id);
+		Shard& shard = shardOf(probe);
+
+		lock_guard lock(shard.shardMutex);
+
+		Slot* slot = find(shard, probe);
+
+		if(slot == nullptr)
+		{
+			return nullopt;
+		}
+
+		optional<Entry> entry = move(slot->entry);
+
+		erase(shard, *slot);
+
+		return entry;
+	}
+
+	/// Runs f(id, entry) with every entry, one shard locked at a time.
+	template <typename F>
+	void forEach(F f)
+	{
+		for(Shard& shard: shards)
+		{
+			lock_guard lock(shard.shardMutex);
+
+			for(Slot& slot: shard.slots)
+			{
+				if(slot.key.kind != Kind::empty &&
+					slot.key.kind != Kind::erased)
+				{
+					f(idOf(slot.key), slot.entry);
+				}
+			}
+		}
+	}
+};
+
+}
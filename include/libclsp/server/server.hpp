@@ -16,17 +16,61 @@
 
 #pragma once
 
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 
+#include <libclsp/server/cancellationToken.hpp>
 #include <libclsp/server/jsonHandler.hpp>
 #include <libclsp/server/capability.hpp>
+#include <libclsp/server/capabilityRegistry.hpp>
+#include <libclsp/server/envelope.hpp>
+#include <libclsp/server/frameReader.hpp>
+#include <libclsp/server/frameWriter.hpp>
+#include <libclsp/server/idleScheduler.hpp>
+#include <libclsp/server/requestTable.hpp>
+#include <libclsp/server/strand.hpp>
+#include <libclsp/server/threadPool.hpp>
+#include <libclsp/server/transport.hpp>
 
 namespace clsp
 {
 
 using namespace std;
 
+struct Message;
+struct RequestMessage;
+struct NotificationMessage;
+struct ResponseError;
+struct IncomingMessage;
+struct IncomingFrame;
+
+/// A function that answers a request from the client.
+/// It returns the result of the request or the error that ocurred.
+using RequestHandler = function<variant<any, ResponseError>(RequestMessage&)>;
+
+/// A function that processes a notification from the client.
+using NotificationHandler = function<void(NotificationMessage&)>;
+
+/// A function that takes the result of a request or its error.
+using ResultHandler = function<void(variant<any, ResponseError>)>;
+
+/// A function that answers a request from the client later. It must call
+/// the result handler once, from any thread, and it shouldn't block while
+/// it waits for other work.
+using AsyncRequestHandler =
+	function<void(shared_ptr<RequestMessage>, ResultHandler)>;
+
+/// A function that writes the result of a request.
+using ResultWriter = function<void(JsonWriter&)>;
+
 enum class RequestKind
 {
 	/// The request waits a response from the client.
@@ -39,51 +83,478 @@ enum class RequestKind
 class Server
 {
 private:
-	/// A map with the capabilities that the server supports.
-	map<String, Capability> capabiliyMap;
+	/// A function set with on<Method>(). It answers the request itself with
+	/// writeResponse(), so the result doesn't go through an any. Returns
+	/// false if it answered with an error.
+	using WritingRequestHandler =
+		function<bool(IncomingMessage&, RequestMessage&)>;
+
+	/// What a server shares with the sessions it hosts. Each session has
+	/// its own initialization, documents and requests.
+	struct Shared
+	{
+		/// The capabilities that the server supports.
+		CapabilityRegistry capabilities;
+
+		/// A map with the functions that answer the requests from the
+		/// client, at once, asynchronously or with a typed result.
+		map<String, variant<RequestHandler, AsyncRequestHandler,
+			WritingRequestHandler>> requestHandlerMap;
+
+		/// A map with the functions that process the notifications from
+		/// the client.
+		map<String, NotificationHandler> notificationHandlerMap;
+
+		/// A mutex for the handler maps.
+		mutable shared_mutex handlerMutex;
+	};
+
+	/// The capabilities and the handlers, shared with the host or the
+	/// sessions.
+	shared_ptr<Shared> shared;
+
+
+	/// A request sent to the client that isn't answered yet.
+	struct SentRequest
+	{
+		/// The interned method of the request
+		CapabilityRegistry::MethodId method =
+			CapabilityRegistry::unknownMethod;
 
-	/// A mutex for the capability map.
-	mutable shared_mutex capabilityMutex;
+		/// When it was sent
+		ThreadPool::Clock::time_point start;
+	};
 
+	/// The requests sent to the client, by id.
+	RequestTable<SentRequest> requestSentTable;
 
-	/// A map with the requests send to the client.
-	/// The key is the id and the value is the method.
-	map<variant<Number, String>, String> requestSentMap;
 
-	/// A mutex for the requestSent map.
-	mutable shared_mutex requestSentMutex;
+	/// A request recieved from the client that isn't answered yet.
+	struct ReceivedRequest
+	{
+		/// The interned method of the request
+		CapabilityRegistry::MethodId method =
+			CapabilityRegistry::unknownMethod;
 
+		/// When it was received
+		ThreadPool::Clock::time_point start;
 
-	/// A map with the requests recieved from the client.
-	/// The key is the id and the value is the method.
-	map<variant<Number, String>, String> requestRecievedMap;
+		/// Cancelled by $/cancelRequest or by its progress. It's null in
+		/// the free slots of the table, a request gets its own.
+		CancellationToken cancellation = CancellationToken(nullptr);
 
-	/// A mutex for the requestSent map.
-	mutable shared_mutex requestRecievedMutex;
+		/// Set when it's part of a batch, its response is sent with the
+		/// others.
+		bool batched = false;
+
+		/// Set when the response is sent or queued.
+		bool answered = false;
+
+		/// The work done token of its params
+		optional<ProgressToken> workDoneToken;
+
+		/// The hash of its document, only when a change supersedes it. A
+		/// view would dangle: short uris live inside the string of the
+		/// params, and they move with the message.
+		size_t documentHash = 0;
+
+		/// Set when a change of the document drops it.
+		bool superseded = false;
+
+		/// The timer of its deadline, if its capability has one.
+		optional<uint64_t> deadlineTimer;
+	};
+
+	/// The requests recieved from the client, by id.
+	RequestTable<ReceivedRequest> requestRecievedTable;
+
+
+	/// A progress that can be cancelled by the client.
+	struct ProgressCancellation
+	{
+		CancellationToken cancellation;
+
+		/// The request that reports the progress, if any.
+		optional<variant<Number, String>> request;
+	};
+
+	/// A map with the progress tokens that can be cancelled.
+	map<ProgressToken, ProgressCancellation> progressMap;
+
+	/// A mutex for the progress map.
+	mutex progressMutex;
 
 
 	/// The last id used for a request sent to the client
-	int lastId = 0;
+	atomic<int> lastId = 0;
+
+	/// A request sent with sendRequest() waiting for its response.
+	struct PendingResult
+	{
+		/// Takes the response
+		ResultHandler handler;
+
+		/// The timer of its timeout, if any.
+		optional<uint64_t> timer;
+	};
+
+	/// The requests sent with sendRequest() that aren't answered yet.
+	map<variant<Number, String>, PendingResult> resultHandlerMap;
+
+	/// A mutex for the result handler map.
+	mutex resultHandlerMutex;
+
+
+	/// The transport of the session.
+	Transport* transport = nullptr;
+
+	/// The frames read from the transport.
+	FrameReader frameReader;
+
+	/// The frames written to the transport.
+	FrameWriter frameWriter;
+
+	/// The server whose messages are dispatched by the current thread.
+	/// The messages it sends meanwhile are written together at the end of
+	/// the read, or when the pipeline is empty.
+	inline static thread_local Server* dispatchingServer = nullptr;
+
+	/// The pool that runs the requests.
+	ThreadPool& pool;
+
+	/// The tasks of this server queued or running in the pool.
+	size_t pendingTasks = 0;
+
+	/// A mutex for pendingTasks.
+	mutex tasksMutex;
+
+	/// Notified when pendingTasks gets to 0.
+	condition_variable tasksCondition;
+
+	/// The strands of the documents with messages queued or running.
+	map<DocumentUri, shared_ptr<Strand>> strands;
+
+	/// A mutex for the strands map.
+	mutex strandsMutex;
+
+	/// The messages read by readInput() that keep their order. They run
+	/// in the pool, so the socket loop doesn't wait for their handlers.
+	shared_ptr<Strand> ordered;
+
+	/// Set when the initialize request is answered.
+	atomic<bool> initialized = false;
+
+	/// Cleared by the exit notification.
+	atomic<bool> running = false;
+
+	/// Runs background work while the client is idle. The last member, so
+	/// its tasks end before the rest of the server is destroyed.
+	IdleScheduler idleScheduler;
+
+
+	/// The messages queued between two stages of startIO()
+	constexpr static size_t pipelineDepth = 64;
+
+	/// Parses the body of a frame in-situ, it doesn't need a null
+	/// terminator. Returns nullptr if the frame was invalid, its error
+	/// response is already sent.
+	unique_ptr<IncomingFrame> parse(char* body, size_t size);
+
+	/// True if the messages sent now can wait to be written with others.
+	bool deferred() const;
+
+	/// Runs the handlers of a parsed frame. After the initialization the
+	/// messages on a document run in its strand and the other requests run
+	/// in the pool, the rest run in order by dispatchInOrder().
+	void schedule(unique_ptr<IncomingFrame> frame);
+
+	/// Runs the handlers of a frame after the ones before it. They run in
+	/// this thread, or in the ordered strand for readInput().
+	void dispatchInOrder(unique_ptr<IncomingFrame> frame);
+
+	/// Returns the document of a message on one, or null. It points into
+	/// the params of the message.
+	const DocumentUri* documentOf(IncomingMessage& message,
+		const Capability& capability);
+
+	/// Ends a task of this server in the pool.
+	void taskDone();
+
+	/// Waits until the pool runs all the tasks of this server.
+	void waitTasks();
+
+	/// Runs the handlers of a parsed frame.
+	void dispatch(unique_ptr<IncomingFrame> frame);
+
+	/// Runs the handler of a parsed message. A request whose handler
+	/// throws is answered with an InternalError, the other messages are
+	/// dropped. Both are logged to stderr.
+	void dispatch(IncomingMessage& message);
+
+	/// Runs the handler of a parsed message, without catching.
+	void invoke(IncomingMessage& message);
+
+	/// Answers or drops a message whose handler threw.
+	void fail(IncomingMessage& message, const char* what);
+
+	/// Runs the handlers of a batch, from the message given, and sends all
+	/// its responses in one array. The consecutive requests run in parallel
+	/// in the pool, the other messages wait for the ones before them.
+	/// It doesn't wait for the pool: the last request of a group dispatches
+	/// the rest of the batch.
+	void dispatchBatch(shared_ptr<IncomingFrame> frame, size_t first);
+
+	/// Adds a request from the client to the request map and sets its
+	/// cancellation. Returns its deadline, if its capability has one.
+	optional<ThreadPool::Clock::time_point> receiveRequest(
+		IncomingMessage& message, const Capability* capability,
+		const DocumentUri* document = nullptr);
+
+	/// Signals the cancellation of a request when its deadline passes, and
+	/// answers it with the expired result of its capability if any.
+	void expireRequest(variant<Number, String> id);
+
+	/// Drops the requests on a document that are superseded by a change,
+	/// they're answered with a ContentModified error.
+	void supersede(const DocumentUri& document);
+
+	/// Marks a request from the client as answered. Returns false if it was
+	/// already answered, like when it's cancelled.
+	bool claimResponse(variant<Number, String> id);
+
+	/// Serializes a response.
+	unique_ptr<JsonWriter> makeResponse(variant<Number, String, Null> id,
+		variant<any, ResponseError> resultOrError);
+
+	/// Sends the response of a request from the client.
+	void respond(variant<Number, String> id,
+		variant<any, ResponseError> resultOrError);
+
+	/// Gives the response of a request sent with sendRequest() to its
+	/// handler.
+	void receiveResult(IncomingMessage& message);
+
+	/// Takes a request sent with sendRequest() out of the pending ones and
+	/// stops its timeout. Returns nullopt if it was already taken.
+	optional<ResultHandler> takeResult(variant<Number, String> id);
+
+	/// Fails a request sent with sendRequest() when its timeout passes and
+	/// asks the client to cancel it.
+	void timeoutResult(variant<Number, String> id);
+
+	/// Fails the requests sent with sendRequest() that aren't answered yet.
+	void failResults();
+
+	/// Sends the response of a request, or keeps it in the message when it's
+	/// part of a batch.
+	void respond(IncomingMessage& message,
+		variant<any, ResponseError> resultOrError);
+
+	/// Like respond() but the result is written by the function given.
+	void writeResponse(IncomingMessage& message,
+		const ResultWriter& resultWriter);
+
+	/// Sets a function made by on<Method>() for the requests of a method.
+	void onWritingRequest(String method, WritingRequestHandler handler);
+
+	/// A session hosted by a server.
+	Server(shared_ptr<Shared> shared, ThreadPool& pool);
+
 public:
-	/// This starts the server and seeks for the Initialize request.
+	/// This starts the server on the standard input and output and seeks for
+	/// the Initialize request. It returns after the exit notification or at
+	/// the end of the input.
 	void startIO();
 
+	/// Same as startIO() but with the given backend for the standard input
+	/// and output.
+	void startIO(IOBackend backend);
+
+	/// Same as startIO() but on any transport.
+	///
+	/// The session runs in a pipeline: this thread reads the frames, another
+	/// one parses them and a third one runs the handlers, so a big message
+	/// doesn't stop the reading of the next ones. The requests run in the
+	/// pool of the server.
+	void startIO(Transport& transport);
+
+	/// Starts a session on a transport without blocking. readInput() must be
+	/// called when the transport has bytes to read.
+	void connect(Transport& transport);
+
+	/// Reads the bytes available in the transport and dispatches the complete
+	/// messages. Returns false when the session ends, by the end of the input
+	/// or by the exit notification.
+	bool readInput();
+
+	/// Ends the session on the transport.
+	void disconnect();
+
+	/// Parses the body of a message, or a batch of them, in-situ and
+	/// dispatches it.
+	/// The body must be null terminated and it's modified by the parsing.
+	void receive(char* body, size_t size);
+
+	/// Writes a message to the client with its header.
+	void send(Message& message);
+
+	/// Sets the longest time a message sent outside readInput() waits to be
+	/// written together with others. By default it's written at once.
+	void setFlushLatency(chrono::microseconds latency);
+
+	/// Sets the longest message accepted from the client, 64 MiB by
+	/// default. A longer Content-Length, or a malformed one, ends the
+	/// session instead of allocating its buffer.
+	void setMaxFrameSize(size_t size);
+
+	/// Sets the function that answers the requests of a method.
+	/// The capability of the method is needed to parse the params.
+	///
+	/// After the initialization the requests run in a thread pool, in
+	/// parallel with each other and with the notifications received after
+	/// them. A request starts after the notifications received before it.
+	///
+	/// The requests on a text document also wait for the notifications of
+	/// the document received before them, which run in the pool in order.
+	/// A didChange drops the requests on the document that aren't answered
+	/// yet if their capability is superseded.
+	///
+	/// The pool runs the requests by the priority of their capability.
+	void onRequest(String method, RequestHandler handler);
+
+	/// Sets a function that answers the requests of a method without
+	/// holding a thread, like one that waits for a response of the client.
+	/// It replaces the function set with onRequest().
+	///
+	/// In a batch its response is sent apart from the others.
+	void onAsyncRequest(String method, AsyncRequestHandler handler);
+
+	/// Sends a request to the client. The handler takes the response in the
+	/// thread that dispatches the messages, so it must be short. The
+	/// capability of the method is needed to write the params and to parse
+	/// the result.
+	///
+	/// If the session ends first the handler gets a RequestCancelled error.
+	/// With a timeout it also gets one when it passes, and the client is
+	/// asked to cancel the request.
+	///
+	/// The ids come from an atomic counter, so any thread can send requests
+	/// without waiting for the responses of the others.
+	///
+	/// The params can be an any, or be built in the envelope to skip the
+	/// allocation:
+	///
+	///     Envelope params;
+	///     params.emplace<ShowMessageRequestParams>(...);
+	///     server.sendRequest(method, move(params), handler);
+	///
+	void sendRequest(String method, Envelope params,
+		ResultHandler handler,
+		optional<chrono::milliseconds> timeout = nullopt);
+
+	/// Like the other sendRequest() but the result or the error is given by
+	/// a future. Don't wait for it in the thread that dispatches the
+	/// messages, like in a notification handler.
+	future<variant<any, ResponseError>> sendRequest(String method,
+		Envelope params,
+		optional<chrono::milliseconds> timeout = nullopt);
+
+	/// Sets a typed function that answers the requests of a method, or that
+	/// processes its notifications. It gets the params with their type and
+	/// its result is written without an any:
+	///
+	///     server.on<TextDocumentHover>([](HoverParams& params,
+	///         RequestMessage& request)
+	///         -> variant<variant<Hover, Null>, ResponseError>
+	///     {
+	///         ...
+	///     });
+	///
+	/// The methods are in methods.hpp, which defines this function. It
+	/// replaces the functions set with onRequest() or onNotification(), and
+	/// adds the capability of the method if the server doesn't have it.
+	template<class Method>
+	void on(typename Method::Handler handler);
+
+	/// The pool that runs the requests.
+	ThreadPool& getThreadPool();
+
+	/// The scheduler of the background work that runs while the client is
+	/// idle. The input read by the server ends its idle periods.
+	IdleScheduler& getIdleScheduler();
+
+	/// Sets the function that processes the notifications of a method.
+	/// The capability of the method is needed to parse the params.
+	void onNotification(String method, NotificationHandler handler);
+
 	/// This function adds a new capability to the server, but doesn't
-	/// send the client/registerCapability request.
+	/// send the client/registerCapability request. It replaces the
+	/// capability of the same method, like to set its deadline.
 	void addCapability(Capability capability);
 
 	/// Returns the capability of the method given. If no capability is found
 	/// the optional<> is set to nullopt.
 	optional<Capability> getCapability(String method);
 
+	/// Like getCapability() but without a copy, it returns null if no
+	/// capability is found. It doesn't lock nor allocate for the built-in
+	/// methods, the capability lives as long as the server.
+	const Capability* findCapability(string_view method) const;
+
+	/// The capability of a request sent to the client and not completed
+	/// yet, or null. It doesn't complete the request, so the parser can
+	/// pick the reader of its result.
+	const Capability* sentCapability(variant<Number, String> id);
+
+
+	/// Cancels a request from the client. It's answered at once with a
+	/// RequestCancelled error, its handler can check its cancellation to
+	/// stop early. Used by $/cancelRequest.
+	void cancelRequest(variant<Number, String> id);
+
+	/// Cancels a progress, and the request that reports it if any. Used by
+	/// window/workDoneProgress/cancel.
+	void cancelProgress(ProgressToken token);
+
+	/// Returns a cancellation for a progress created by the server, it's
+	/// cancelled when the client cancels the progress.
+	CancellationToken addProgress(ProgressToken token);
+
+	/// Forgets a progress created by the server when it ends.
+	void removeProgress(ProgressToken token);
+
 
 	/// Adds a request to one of the two request maps.
 	void addRequest(variant<Number, String> id, String method, RequestKind kind);
 
-	/// Completes a request and returns the method name.
-	String completeRequest(variant<Number, String> id, RequestKind kind);
+	/// Completes a request and returns the method name, or an empty string.
+	/// The name lives as long as the capabilities.
+	string_view completeRequest(variant<Number, String> id, RequestKind kind);
 
+	/// Opens a session hosted by this server, like the one of a client of
+	/// a SocketServer. It has its own initialization, documents, requests
+	/// and ids, but it shares the capabilities, the handlers and the pool
+	/// of this server. The handlers set on any of them are seen by all, so
+	/// the indexes they read are loaded once for all the sessions.
+	///
+	/// A shared handler must answer through the session of its message,
+	/// given by Message::getServer():
+	///
+	///     host.onNotification(method, [](NotificationMessage& notification)
+	///     {
+	///         Server& session = notification.getServer();
+	///         ...
+	///     });
+	///
+	/// The session can outlive the server, but not its pool.
+	unique_ptr<Server> openSession();
+
+	/// A server that runs its requests in the shared pool.
 	Server();
+
+	/// A server that runs its requests in the given pool.
+	Server(ThreadPool& pool);
+
 	virtual ~Server();
 };
 
@@ -0,0 +1,136 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <libclsp/server/transport.hpp>
+#include <libclsp/types/jsonTypes.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// A transport for clients on the same host. The frames go through two
+/// single-producer/single-consumer rings in a shared memory object, one for
+/// each direction, so no bytes are copied by the kernel.
+///
+/// A side only sleeps on a futex when its ring is empty (reader) or full
+/// (writer), and a side is only woken up when it's sleeping.
+///
+/// Layout of the shared memory object, with 64 bytes aligned blocks:
+///
+/// - Segment: magic, version, capacity, server pid, client pid.
+/// - Ring from the client to the server, then its data.
+/// - Ring from the server to the client, then its data.
+///
+/// Each Ring has the tail, a data sequence and the closed flag written by
+/// the producer, then the head and a space sequence written by the
+/// consumer. The sequences are the futex words.
+///
+class ShmTransport: public Transport
+{
+public:
+	/// The side that uses the transport.
+	enum class Side
+	{
+		/// Creates the shared memory object and removes it at the end.
+		server,
+
+		/// Opens the shared memory object made by the server.
+		client
+	};
+
+	/// The data size of each ring used by default
+	constexpr static size_t defaultCapacity = 4 << 20;
+
+private:
+	struct Segment;
+	struct Ring;
+
+	/// The name of the shared memory object
+	String name;
+
+	/// The side of this transport
+	Side side;
+
+	/// The mapped object
+	Segment* segment = nullptr;
+
+	/// The size of the mapping
+	size_t mappingSize = 0;
+
+	/// The ring read by read()
+	Ring* input = nullptr;
+
+	/// The ring written by write()
+	Ring* output = nullptr;
+
+	/// The data of the rings
+	char* inputData  = nullptr;
+	char* outputData = nullptr;
+
+	/// The data size of each ring, a power of two.
+	size_t capacity = 0;
+
+	/// A mutex for the output ring, it has a single producer.
+	mutex outputMutex;
+
+	/// Set by interrupt()
+	atomic<bool> interrupted = false;
+
+	/// A futex word of this process changed by interrupt(). The reader
+	/// waits on it together with the input ring.
+	atomic<uint32_t> wakeSequence = 0;
+
+	/// Checks if the process on the other side is still alive.
+	bool peerAlive() const;
+
+	/// True if the object of the name has a server that may still be
+	/// running, or one that is still making it.
+	static bool serverAlive(const String& name);
+
+public:
+	virtual ssize_t read(char* buffer, size_t size);
+
+	virtual bool write(const char* data, size_t size);
+
+	virtual bool writev(const iovec* parts, size_t count);
+
+	virtual void interrupt();
+
+	/// Closes the output, the other side reads the end of the stream.
+	void close();
+
+	/// False if the shared memory object couldn't be made or opened.
+	bool isValid() const;
+
+	/// The name must start with '/', like in shm_open(3). A server fails
+	/// if another one that's still running has the name.
+	/// The capacity is rounded up to a power of two and it's ignored by
+	/// clients.
+	ShmTransport(String name, Side side, size_t capacity);
+
+	ShmTransport(String name, Side side);
+
+	virtual ~ShmTransport();
+};
+
+}
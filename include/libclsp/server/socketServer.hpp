@@ -0,0 +1,185 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libclsp/server/server.hpp>
+#include <libclsp/server/transport.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// A transport over a non-blocking socket watched by an epoll instance.
+/// The bytes that can't be written at once wait until the socket is
+/// writable again, up to a limit. A client that doesn't read its
+/// responses is dropped when it's reached.
+class SocketTransport: public Transport
+{
+private:
+	/// The socket of the client
+	int socketFd;
+
+	/// The epoll instance watching the socket
+	int epollFd;
+
+	/// The most bytes that can wait
+	size_t maxPending;
+
+	/// The bytes waiting for the socket to be writable
+	vector<char> pending;
+
+	/// Set when the limit was reached
+	bool dropped = false;
+
+	/// A mutex for the pending bytes.
+	mutex pendingMutex;
+
+	/// Changes the events watched by the epoll instance.
+	void watch(bool writable);
+
+	/// Appends bytes to the pending ones, or drops the client if they
+	/// don't fit. The socket is shut down, so its epoll loop sees the end
+	/// of the input and closes it.
+	bool keep(const char* first, const char* last);
+
+public:
+	virtual ssize_t read(char* buffer, size_t size);
+
+	virtual bool write(const char* data, size_t size);
+
+	virtual bool writev(const iovec* parts, size_t count);
+
+	/// Shuts down the reading side, so the epoll loop reads the end of the
+	/// input and closes the client.
+	virtual void interrupt();
+
+	/// Writes the pending bytes. It's called when the socket is writable.
+	/// Returns false if the socket can't be written anymore.
+	bool flush();
+
+	SocketTransport(int socketFd, int epollFd, size_t maxPending);
+
+	virtual ~SocketTransport();
+};
+
+/// Serves many clients from one thread. Each client gets its own session,
+/// so the request maps and the frames of a client are never shared.
+class SocketServer
+{
+private:
+	/// A client and its session.
+	struct Connection
+	{
+		unique_ptr<SocketTransport> transport;
+
+		unique_ptr<Server> server;
+	};
+
+	/// Makes the session of a new client.
+	function<unique_ptr<Server>()> serverMaker;
+
+	/// The most bytes waiting to be written to a client
+	size_t maxPending = defaultMaxPending;
+
+	/// The epoll instance
+	int epollFd;
+
+	/// An eventfd to wake up the loop from stop()
+	int wakeFd;
+
+	/// The listening sockets
+	vector<int> listenFds;
+
+	/// The clients by socket
+	map<int, Connection> connections;
+
+	/// Cleared by stop()
+	atomic<bool> running = false;
+
+	/// The clients closed, with their sockets, waiting to be reaped
+	vector<pair<int, Connection>> closed;
+
+	/// A mutex for the closed clients.
+	mutex closedMutex;
+
+	/// Wakes up the reaper
+	condition_variable closedCondition;
+
+	/// Cleared by the destructor
+	bool reaping = true;
+
+	/// Ends the sessions of the closed clients. Ending one waits for its
+	/// tasks, so it isn't done by the epoll loop.
+	thread reaper;
+
+	/// The reaper thread.
+	void reap();
+
+	/// Listens on a bound socket.
+	bool startListening(int socketFd);
+
+	/// Accepts all the clients waiting on a listening socket.
+	void accept(int listenFd);
+
+	/// Stops watching a client and gives it to the reaper, which ends its
+	/// session and closes its socket.
+	void close(int socketFd);
+
+public:
+	constexpr static size_t defaultMaxPending = 64 << 20;
+
+	/// Sets the most bytes that can wait to be written to a client, 64 MiB
+	/// by default. It applies to the clients accepted after.
+	void setMaxPending(size_t size);
+	/// Listens on a TCP port of localhost.
+	/// Returns the port, useful when 0 is given to get a free one, or -1 on
+	/// errors.
+	int listenTcp(uint16_t port);
+
+	/// Listens on a Unix domain socket. An old socket file on the path is
+	/// replaced. Returns false on errors.
+	bool listenUnix(String path);
+
+	/// Serves the clients until stop() is called.
+	void run();
+
+	/// Stops run(). It can be called from any thread.
+	void stop();
+
+	SocketServer(function<unique_ptr<Server>()> serverMaker);
+
+	/// Serves each client in a session hosted by the server given, which
+	/// must outlive this one.
+	SocketServer(Server& host);
+
+	virtual ~SocketServer();
+};
+
+}
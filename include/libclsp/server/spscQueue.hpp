@@ -0,0 +1,217 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// A bounded queue between one producer thread and one consumer thread.
+///
+/// Pushing and popping are lock-free, the mutex is only taken to sleep when
+/// the queue is full or empty and to wake up the other side while it
+/// sleeps.
+template <typename T>
+class SpscQueue
+{
+private:
+	/// The items, T must be default constructible.
+	vector<T> slots;
+
+	/// The size of slots minus one, it's a power of two.
+	size_t mask;
+
+	/// The next item to pop, written by the consumer.
+	alignas(64) atomic<size_t> head = 0;
+
+	/// The next slot to push, written by the producer.
+	alignas(64) atomic<size_t> tail = 0;
+
+	/// Set when no more items will be pushed.
+	atomic<bool> closed = false;
+
+	/// Set while a side sleeps.
+	atomic<bool> consumerWaiting = false;
+	atomic<bool> producerWaiting = false;
+
+	mutex waitMutex;
+	condition_variable waitCondition;
+
+	/// Sleeps until the condition is true, after some spinning.
+	template <typename Condition>
+	void wait(atomic<bool>& waiting, Condition condition)
+	{
+		for(int i = 0; i < 64; i++)
+		{
+			if(condition())
+			{
+				return;
+			}
+		}
+
+		unique_lock<mutex> lock(waitMutex);
+
+		waiting = true;
+
+		// The other side either sees the flag or this sees its change.
+		atomic_thread_fence(memory_order_seq_cst);
+
+		waitCondition.wait(lock, condition);
+
+		waiting = false;
+	}
+
+	/// Wakes up the other side if it sleeps.
+	void notify(atomic<bool>& waiting)
+	{
+		atomic_thread_fence(memory_order_seq_cst);
+
+		if(waiting.load(memory_order_relaxed))
+		{
+			lock_guard<mutex> lock(waitMutex);
+
+			waitCondition.notify_all();
+		}
+	}
+
+public:
+	/// Pushes an item if there's space. The item isn't moved otherwise.
+	bool tryPush(T& item)
+	{
+		size_t position = tail.load(memory_order_relaxed);
+
+		if(position - head.load(memory_order_acquire) > mask)
+		{
+			return false;
+		}
+
+		slots[position & mask] = move(item);
+		tail.store(position + 1, memory_order_release);
+
+		notify(consumerWaiting);
+
+		return true;
+	}
+
+	/// Pops an item if there's one.
+	optional<T> tryPop()
+	{
+		size_t position = head.load(memory_order_relaxed);
+
+		if(position == tail.load(memory_order_acquire))
+		{
+			return nullopt;
+		}
+
+		optional<T> item = move(slots[position & mask]);
+		head.store(position + 1, memory_order_release);
+
+		notify(producerWaiting);
+
+		return item;
+	}
+
+	/// Pushes an item, it waits while the queue is full.
+	/// Returns false if the queue was closed.
+	bool push(T item)
+	{
+		while(!closed.load(memory_order_acquire))
+		{
+			if(tryPush(item))
+			{
+				return true;
+			}
+
+			wait(producerWaiting, [this]()
+			{
+				return closed.load(memory_order_acquire) ||
+					tail.load(memory_order_relaxed) -
+					head.load(memory_order_acquire) <= mask;
+			});
+		}
+
+		return false;
+	}
+
+	/// Pops an item, it waits while the queue is empty.
+	/// Returns nullopt when the queue is closed and empty.
+	optional<T> pop()
+	{
+		while(true)
+		{
+			if(auto item = tryPop())
+			{
+				return item;
+			}
+
+			if(closed.load(memory_order_acquire))
+			{
+				// The items pushed before closing
+				return tryPop();
+			}
+
+			wait(consumerWaiting, [this]()
+			{
+				return closed.load(memory_order_acquire) ||
+					head.load(memory_order_relaxed) !=
+					tail.load(memory_order_acquire);
+			});
+		}
+	}
+
+	/// Checks if there's nothing to pop right now.
+	bool empty() const
+	{
+		return head.load(memory_order_relaxed) ==
+			tail.load(memory_order_acquire);
+	}
+
+	/// Ends the queue. The consumer still pops the items left and the
+	/// producer can't push anymore.
+	void close()
+	{
+		closed.store(true, memory_order_release);
+
+		notify(consumerWaiting);
+		notify(producerWaiting);
+	}
+
+	/// The capacity is rounded up to a power of two.
+	SpscQueue(size_t capacity)
+	{
+		size_t size = 1;
+
+		while(size < capacity)
+		{
+			size <<= 1;
+		}
+
+		slots.resize(size);
+		mask = size - 1;
+	}
+
+	virtual ~SpscQueue(){};
+};
+
+}
@@ -0,0 +1,94 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include <libclsp/server/threadPool.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// A serial executor on a thread pool.
+///
+/// The tasks start in the order they are posted. An exclusive task runs
+/// alone, after the ones before it end. Consecutive shared tasks run in
+/// parallel with each other. So the edits of a document are applied in
+/// order and the requests between them can run together.
+///
+/// A task is submitted with the highest priority and the earliest deadline
+/// queued in the strand, so an interactive request doesn't wait for the
+/// normal edits before it.
+class Strand: public enable_shared_from_this<Strand>
+{
+private:
+	struct Entry
+	{
+		ThreadPool::Task task;
+		bool shared;
+		Priority priority;
+		optional<ThreadPool::Clock::time_point> deadline;
+	};
+
+	/// The pool that runs the tasks
+	ThreadPool& pool;
+
+	/// A mutex for the queue and the running state
+	mutable mutex strandMutex;
+
+	/// The tasks waiting for the ones before them
+	deque<Entry> queue;
+
+	/// The shared tasks running
+	size_t sharedRunning = 0;
+
+	/// Set while an exclusive task runs
+	bool exclusiveRunning = false;
+
+	/// Called after each task ends, with true if nothing is left to run.
+	function<void(bool)> finishHandler;
+
+	/// Submits the queued tasks that can start. strandMutex must be locked.
+	void startReady();
+
+	/// Ends a task and starts the next ones.
+	void finish(bool shared);
+
+public:
+	/// Runs a task after the ones posted before. A shared task runs together
+	/// with the shared tasks next to it.
+	void post(ThreadPool::Task task, bool shared = false,
+		Priority priority = Priority::normal,
+		optional<ThreadPool::Clock::time_point> deadline = nullopt);
+
+	/// True if no task is running or queued.
+	bool idle() const;
+
+	/// Strands must be owned by a shared_ptr, the running tasks keep them
+	/// alive. The finish handler is called without locks held.
+	Strand(ThreadPool& pool, function<void(bool)> finishHandler = nullptr);
+
+	virtual ~Strand();
+};
+
+}
@@ -0,0 +1,182 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The scheduling classes of the tasks, from the most urgent.
+enum class Priority
+{
+	/// Requests that a user waits for while typing, like completion.
+	interactive,
+
+	/// The default
+	normal,
+
+	/// Bulk requests, like the ones on the whole workspace.
+	background
+};
+
+/// A pool of threads where each worker has its own deques of tasks, one
+/// for each priority.
+///
+/// A worker runs the tasks at the front of its deques, taking only its own
+/// lock. When they're all empty it steals from the back of another one, so
+/// short tasks are never stuck behind a long one while a worker is idle,
+/// and there is no global queue or counter to contend on.
+///
+/// A worker runs its interactive tasks before the normal ones, and those
+/// before the background ones. A task that waited more than the aging
+/// limit of its class runs before the others, so none is starved.
+///
+/// In a class, the tasks with a deadline run before the others, the
+/// earliest first.
+class ThreadPool
+{
+public:
+	using Task = function<void()>;
+
+	using Clock = chrono::steady_clock;
+
+	constexpr static size_t priorityCount = 3;
+
+	/// How long the tasks of each class wait before they go first.
+	constexpr static array<chrono::milliseconds, priorityCount> agingLimit = {
+		chrono::milliseconds(0),
+		chrono::milliseconds(100),
+		chrono::milliseconds(500)
+	};
+
+private:
+	struct Entry
+	{
+		Task task;
+
+		/// When the task was submitted
+		Clock::time_point submitted;
+
+		/// When the task must be done, the deques are sorted by it.
+		/// The tasks without one have the maximum time.
+		Clock::time_point deadline;
+	};
+
+	/// Aligned to a cache line, so the counters of the workers don't
+	/// share one.
+	struct alignas(64) Worker
+	{
+		/// The tasks in the deques, the thieves skip the empty workers
+		/// without locking them.
+		atomic<size_t> queued = 0;
+
+		/// A mutex for the deques, taken by its owner and by the thieves.
+		mutex dequeMutex;
+
+		array<deque<Entry>, priorityCount> tasks;
+
+		thread runner;
+	};
+
+	vector<unique_ptr<Worker>> workers;
+
+	/// The worker that gets the next task submitted from outside the pool
+	atomic<size_t> nextWorker = 0;
+
+	/// The workers sleeping
+	atomic<size_t> sleepers = 0;
+
+	/// Set by the destructor, the workers finish the queued tasks and exit.
+	atomic<bool> stopping = false;
+
+	mutex sleepMutex;
+	condition_variable sleepCondition;
+
+	/// The pool of the current thread, if it's a worker.
+	inline static thread_local ThreadPool* currentPool = nullptr;
+
+	/// The index of the current worker in its pool.
+	inline static thread_local size_t currentWorker = 0;
+
+	/// Pushes a task at the back of a deque, before the tasks with a later
+	/// deadline.
+	void push(size_t worker, Task task, Priority priority,
+		optional<Clock::time_point> deadline);
+
+	/// True if any deque has a task.
+	bool hasTasks() const;
+
+	/// Takes a task of the worker that waited more than the aging limit of
+	/// its class. The worker's mutex must be held.
+	optional<Task> takeAged(Worker& worker, Clock::time_point now);
+
+	/// Takes the newest task of another worker, the most urgent class first.
+	optional<Task> steal(size_t worker);
+
+	/// Takes the next task for a worker from its own deques, the aged ones
+	/// first and then by priority. It steals when they're empty.
+	optional<Task> take(size_t worker);
+
+	/// The loop of a worker.
+	void work(size_t worker);
+
+	/// Runs a task. An exception can't stop the worker, it's logged to
+	/// stderr and dropped.
+	static void execute(Task& task);
+
+public:
+	/// Runs a task in the pool.
+	/// A worker puts its tasks in its own deques, the other threads spread
+	/// them across the workers.
+	void submit(Task task, Priority priority = Priority::normal,
+		optional<Clock::time_point> deadline = nullopt);
+
+	/// Runs all the tasks in the pool and returns when they are done.
+	/// A worker that calls it runs tasks while it waits.
+	void run(vector<Task>& tasks, Priority priority = Priority::normal);
+
+	/// The number of workers
+	size_t size() const;
+
+	/// The pool shared by the whole process, with a worker per hardware
+	/// thread and at least two, so a long task can't stop the others.
+	static ThreadPool& shared();
+
+	/// The pool for blocking IO shared by the whole process. Its workers
+	/// mostly wait, so there are twice as many as hardware threads, and
+	/// they never hold the workers of shared().
+	static ThreadPool& blocking();
+
+	ThreadPool(size_t workers);
+
+	virtual ~ThreadPool();
+};
+
+}
@@ -0,0 +1,81 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// Runs callbacks at given times in one thread.
+///
+/// The callbacks must be short, like submitting a task to a pool or
+/// resuming a coroutine there.
+class TimerQueue
+{
+public:
+	using Clock = chrono::steady_clock;
+
+private:
+	/// The timers in the order they're due, with their ids.
+	multimap<Clock::time_point, uint64_t> order;
+
+	/// The callbacks of the timers that aren't cancelled.
+	map<uint64_t, function<void()>> callbacks;
+
+	/// The id of the last timer
+	uint64_t lastId = 0;
+
+	/// Set by the destructor
+	bool stopping = false;
+
+	/// A mutex for all the state
+	mutex timersMutex;
+
+	/// Notified when a timer goes before the others or on stop.
+	condition_variable timersCondition;
+
+	thread runner;
+
+	/// The loop of the timer thread.
+	void run();
+
+public:
+	/// Runs a callback at a time. Returns the id of the timer.
+	uint64_t schedule(Clock::time_point when, function<void()> callback);
+
+	/// Removes a timer that isn't due yet. Returns false if it already ran
+	/// or it's running.
+	bool cancel(uint64_t id);
+
+	/// The timer queue shared by the whole process.
+	static TimerQueue& shared();
+
+	TimerQueue();
+
+	virtual ~TimerQueue();
+};
+
+}
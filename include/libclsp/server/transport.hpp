@@ -0,0 +1,112 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The ways a transport can do its IO.
+enum class IOBackend
+{
+	/// Plain read(2) and write(2) calls.
+	readWrite,
+
+	/// io_uring, with readWrite as a fallback when the kernel doesn't
+	/// support it.
+	ioUring
+};
+
+/// A byte stream that carries the framed messages of a session.
+class Transport
+{
+public:
+	/// Reads at most size bytes into buffer.
+	/// Returns the number of bytes read, 0 at the end of the stream and -1 on
+	/// errors, like read(2).
+	virtual ssize_t read(char* buffer, size_t size) = 0;
+
+	/// Reads the next bytes into memory of the transport and lends it, so
+	/// they aren't copied. The memory is reused when the last share of
+	/// bytes is released. Returns like read(). By default it fails with
+	/// ENOTSUP, then read() must be used.
+	virtual ssize_t lend(shared_ptr<char>& bytes);
+
+	/// Writes all the bytes given.
+	/// Returns false if the stream can't be written anymore.
+	virtual bool write(const char* data, size_t size) = 0;
+
+	/// Writes all the parts given in order, like writev(2).
+	/// By default each part is written with write().
+	virtual bool writev(const iovec* parts, size_t count);
+
+	/// Wakes up a read() blocked in another thread, it returns 0 like at the
+	/// end of the stream. By default the read returns with the next bytes.
+	virtual void interrupt();
+
+	/// Blocks until read() has bytes to return or the stream ends, for the
+	/// reads that fail with EAGAIN. Returns false if interrupt() woke it up
+	/// or the stream can't be waited on. By default it returns true at
+	/// once, for the transports whose read() blocks.
+	virtual bool wait();
+
+	Transport();
+
+	virtual ~Transport();
+};
+
+/// A transport over a pair of file descriptors. The default one uses the
+/// standard input and output.
+class FdTransport: public Transport
+{
+private:
+	/// The descriptor read by read()
+	int inFd;
+
+	/// The descriptor written by write()
+	int outFd;
+
+	/// An eventfd polled with inFd, written by interrupt()
+	int wakeFd;
+
+public:
+	virtual ssize_t read(char* buffer, size_t size);
+
+	virtual bool write(const char* data, size_t size);
+
+	virtual bool writev(const iovec* parts, size_t count);
+
+	virtual void interrupt();
+
+	virtual bool wait();
+
+	FdTransport(int inFd, int outFd);
+
+	FdTransport();
+
+	virtual ~FdTransport();
+};
+
+}
@@ -0,0 +1,223 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <libclsp/server/transport.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// A transport over a pair of file descriptors that does its IO with
+/// io_uring.
+///
+/// The input is read ahead into memory known by the kernel: a provided
+/// buffer ring that a multishot receive or read keeps filling while the
+/// bytes are parsed, or registered buffers read with fixed reads on kernels
+/// without it. lend() gives the buffers to the reader in place, they go
+/// back to the kernel when released.
+///
+/// writev() copies the parts and returns without waiting. The writes are
+/// sent in order by a completion thread, which resumes the short ones.
+///
+/// isValid() is false when the kernel doesn't support io_uring, then the
+/// transport must not be used.
+class UringTransport: public Transport
+{
+private:
+	/// An io_uring instance
+	struct Ring;
+
+	/// Bytes read and not consumed yet
+	struct Chunk
+	{
+		/// The buffer id
+		unsigned buffer;
+
+		/// The first byte not consumed
+		size_t begin;
+
+		/// The end of the bytes read
+		size_t end;
+	};
+
+	/// How the input is read
+	enum class InputMode
+	{
+		/// A multishot receive or read into the provided buffer ring
+		multishot,
+
+		/// Single receives or reads into the provided buffer ring, on
+		/// kernels without the multishot ones
+		single,
+
+		/// Fixed reads into the registered buffers, on kernels without
+		/// provided buffer rings
+		fixed
+	};
+
+	/// The number of input buffers
+	constexpr static unsigned bufferCount = 8;
+
+	/// The size of each input buffer
+	constexpr static size_t bufferSize = 64 * 1024;
+
+	/// The ring for the reads
+	unique_ptr<Ring> inputRing;
+
+	/// The ring for the writes
+	unique_ptr<Ring> outputRing;
+
+	/// The descriptor read by read()
+	int inFd;
+
+	/// The descriptor written by write()
+	int outFd;
+
+	/// Set when the input is a socket, it's received instead of read.
+	bool socket = false;
+
+	/// The memory of the input buffers
+	char* inputMemory = nullptr;
+
+	/// The provided buffer ring
+	void* bufferRing = nullptr;
+
+	InputMode mode = InputMode::fixed;
+
+	/// The completed reads in order
+	deque<Chunk> chunks;
+
+	/// Set while a read or a multishot one is in flight.
+	bool reading = false;
+
+	/// The buffers that the kernel can fill
+	unsigned kernelBuffers = 0;
+
+	/// Set when the kernel picks a buffer of the ring for the first time.
+	bool ringUsed = false;
+
+	/// The registered buffers free for a fixed read
+	deque<unsigned> fixedBuffers;
+
+	/// The buffers released by the lent bytes, from any thread
+	vector<unsigned> returned;
+
+	/// A mutex for the returned buffers.
+	mutex returnedMutex;
+
+	/// Notified when a buffer is returned or interrupt() is called, for a
+	/// reader that has no buffer to read into.
+	condition_variable returnedCondition;
+
+	/// Set by interrupt()
+	bool interrupted = false;
+
+	/// An eventfd written by interrupt(), it's polled by the input ring.
+	int wakeFd = -1;
+
+	/// Set when the poll of wakeFd is submitted.
+	bool wakePolled = false;
+
+	/// The result that ended the input: 0 at the end of the stream or a
+	/// negative errno.
+	optional<int> inputEnd;
+
+	/// Bytes copied by writev() waiting to be written
+	struct Output
+	{
+		vector<char> bytes;
+
+		/// The bytes already written
+		size_t written = 0;
+	};
+
+	/// The outputs not written yet, the first one is in flight.
+	deque<Output> outputs;
+
+	/// Set when a write failed, the output can't be written anymore.
+	bool outputFailed = false;
+
+	/// A mutex for the outputs and the submissions of the output ring.
+	mutex outputMutex;
+
+	/// Notified when the outputs are written or the output fails.
+	condition_variable outputCondition;
+
+	/// Reaps the writes and submits the next ones.
+	thread completer;
+
+	/// Queues the next read if the kernel has a free buffer.
+	/// Returns false if nothing was queued.
+	bool readAhead();
+
+	/// Gives a consumed buffer back to the kernel. Only the reader calls it.
+	void releaseBuffer(unsigned buffer);
+
+	/// Gives back the buffers returned by the lent bytes.
+	void releaseReturned();
+
+	/// Stops using the provided buffer ring, for kernels that register it
+	/// but can't read into it.
+	void unregisterBufferRing();
+
+	/// Moves the completed reads to the chunks.
+	void reap();
+
+	/// Waits for the next chunk. Returns false at the end of the input,
+	/// with the result of read() in result.
+	bool waitChunk(ssize_t& result);
+
+	/// Submits the write of the first output. outputMutex must be locked.
+	bool submitOutput();
+
+	/// The completion thread.
+	void complete();
+
+public:
+	virtual ssize_t read(char* buffer, size_t size);
+
+	virtual ssize_t lend(shared_ptr<char>& bytes);
+
+	virtual bool write(const char* data, size_t size);
+
+	virtual bool writev(const iovec* parts, size_t count);
+
+	virtual void interrupt();
+
+	/// False when the kernel doesn't support io_uring.
+	bool isValid() const;
+
+	UringTransport(int inFd, int outFd);
+
+	UringTransport();
+
+	/// Waits until the outputs are written.
+	virtual ~UringTransport();
+};
+
+}
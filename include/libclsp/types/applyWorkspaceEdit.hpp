@@ -36,8 +36,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String labelKey;
-	const static String editKey;
+	constexpr static Key labelKey = "label";
+	constexpr static Key editKey  = "edit";
 
 public:
 	/// An optional label of the workspace edit. This label is
@@ -66,8 +66,8 @@ public:
 struct ApplyWorkspaceEditResponse: public ObjectT
 {
 private:
-	const static String appliedKey;
-	const static String failureReasonKey;
+	constexpr static Key appliedKey       = "applied";
+	constexpr static Key failureReasonKey = "failureReason";
 
 public:
 	/// Indicates whether the edit was applied or not.
@@ -34,7 +34,7 @@ using namespace std;
 struct CancelParams: public ObjectT
 {
 private:
-	const static String idKey;
+	constexpr static Key idKey = "id";
 
 protected:
 	/// This is like write() but without the object bounds.
@@ -118,9 +118,9 @@ struct CodeActionKind
 struct CodeActionClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String codeActionLiteralSupportKey;
-	const static String isPreferredSupportKey;
+	constexpr static Key dynamicRegistrationKey      = "dynamicRegistration";
+	constexpr static Key codeActionLiteralSupportKey = "codeActionLiteralSupport";
+	constexpr static Key isPreferredSupportKey       = "isPreferredSupport";
 
 public:
 	/// Whether code action supports dynamic registration.
@@ -133,7 +133,7 @@ public:
 	struct CodeActionLiteralSupport: public ObjectT
 	{
 	private:
-		const static String codeActionKindKey;
+		constexpr static Key codeActionKindKey = "codeActionKind";
 
 	public:
 		/// The code action kind is supported with the following value
@@ -141,7 +141,7 @@ public:
 		struct CodeActionKind: public ObjectT
 		{
 		private:
-			const static String valueSetKey;
+			constexpr static Key valueSetKey = "valueSet";
 
 			struct ValueSetMaker: public ObjectT
 			{
@@ -250,7 +250,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String codeActionKindsKey;
+	constexpr static Key codeActionKindsKey = "codeActionKinds";
 
 public:
 	/// CodeActionKinds that this server may return.
@@ -301,8 +301,8 @@ public:
 struct CodeActionContext: public ObjectT
 {
 private:
-	const static String diagnosticsKey;
-	const static String onlyKey;
+	constexpr static Key diagnosticsKey = "diagnostics";
+	constexpr static Key onlyKey        = "only";
 
 	struct DiagnosticsMaker: public ObjectT
 	{
@@ -387,9 +387,9 @@ struct CodeActionParams:
 	public PartialResultParams
 {
 private:
-	const static String textDocumentKey;
-	const static String rangeKey;
-	const static String contextKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key rangeKey        = "range";
+	constexpr static Key contextKey      = "context";
 
 public:
 	/// The document in which the command was invoked.
@@ -449,12 +449,12 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String titleKey;
-	const static String kindKey;
-	const static String diagnosticsKey;
-	const static String isPreferredKey;
-	const static String editKey;
-	const static String commandKey;
+	constexpr static Key titleKey       = "title";
+	constexpr static Key kindKey        = "kind";
+	constexpr static Key diagnosticsKey = "diagnostics";
+	constexpr static Key isPreferredKey = "isPreferred";
+	constexpr static Key editKey        = "edit";
+	constexpr static Key commandKey     = "command";
 
 public:
 	/// A short, human-readable, title for this code action.
@@ -37,7 +37,7 @@ using namespace std;
 struct CodeLensClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Whether code action supports dynamic registration.
@@ -73,7 +73,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String resolveProviderKey;
+	constexpr static Key resolveProviderKey = "resolveProvider";
 
 public:
 	/// Code lens has a resolve provider as well.
@@ -119,7 +119,7 @@ struct CodeLensParams:
 	public PartialResultParams
 {
 private:
-	const static String textDocumentKey;
+	constexpr static Key textDocumentKey = "textDocument";
 
 public:
 	/// The document in which the command was invoked.
@@ -166,9 +166,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String rangeKey;;
-	const static String commandKey;
-	const static String dataKey;
+	constexpr static Key rangeKey = "range";;
+	constexpr static Key commandKey = "command";
+	constexpr static Key dataKey    = "data";
 
 public:
 	/// The range in which this code lens is valid. Should only span a single
@@ -39,9 +39,9 @@ struct ColorPresentationParams:
 	public PartialResultParams
 {
 private:
-	const static String textDocumentKey;
-	const static String colorKey;
-	const static String rangeKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key colorKey        = "color";
+	constexpr static Key rangeKey        = "range";
 
 public:
 	/// The text document.
@@ -91,9 +91,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String labelKey;
-	const static String textEditKey;
-	const static String additionalTextEditsKey;
+	constexpr static Key labelKey               = "label";
+	constexpr static Key textEditKey            = "textEdit";
+	constexpr static Key additionalTextEditsKey = "additionalTextEdits";
 
 public:
 	/// The label of this color presentation. It will be shown on the color
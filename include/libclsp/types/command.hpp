@@ -41,9 +41,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String titleKey;
-	const static String commandKey;
-	const static String argumentsKey;
+	constexpr static Key titleKey     = "title";
+	constexpr static Key commandKey   = "command";
+	constexpr static Key argumentsKey = "arguments";
 
 public:
 	/// Title of the command, like `save`.
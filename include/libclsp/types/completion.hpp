@@ -44,9 +44,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String triggerCharactersKey;
-	const static String allCommitCharactersKey;
-	const static String resolveProviderKey;
+	constexpr static Key triggerCharactersKey   = "triggerCharacters";
+	constexpr static Key allCommitCharactersKey = "allCommitCharacters";
+	constexpr static Key resolveProviderKey     = "resolveProvider";
 
 public:
 	/// Most tools trigger completion request automatically without explicitly
@@ -138,8 +138,8 @@ enum class CompletionTriggerKind
 struct CompletionContext: public ObjectT
 {
 private:
-	const static String triggerKindKey;
-	const static String triggerCharacterKey;
+	constexpr static Key triggerKindKey      = "triggerKind";
+	constexpr static Key triggerCharacterKey = "triggerCharacter";
 
 public:
 	/// How the completion was triggered.
@@ -180,7 +180,7 @@ struct CompletionParams:
 	public PartialResultParams
 {
 private:
-	const static String contextKey;
+	constexpr static Key contextKey = "context";
 
 public:
 	/// The completion context. This is only available if the client specifies
@@ -312,22 +312,22 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String labelKey;
-	const static String kindKey;
-	const static String tagsKey;
-	const static String detailKey;
-	const static String documentationKey;
-	const static String deprecatedKey;
-	const static String preselectKey;
-	const static String sortTextKey;
-	const static String filterTextKey;
-	const static String insertTextKey;
-	const static String insertTextFormatKey;
-	const static String textEditKey;
-	const static String additionalTextEditsKey;
-	const static String commitCharactersKey;
-	const static String commandKey;
-	const static String dataKey;
+	constexpr static Key labelKey               = "label";
+	constexpr static Key kindKey                = "kind";
+	constexpr static Key tagsKey                = "tags";
+	constexpr static Key detailKey              = "detail";
+	constexpr static Key documentationKey       = "documentation";
+	constexpr static Key deprecatedKey          = "deprecated";
+	constexpr static Key preselectKey           = "preselect";
+	constexpr static Key sortTextKey            = "sortText";
+	constexpr static Key filterTextKey          = "filterText";
+	constexpr static Key insertTextKey          = "insertText";
+	constexpr static Key insertTextFormatKey    = "insertTextFormat";
+	constexpr static Key textEditKey            = "textEdit";
+	constexpr static Key additionalTextEditsKey = "additionalTextEdits";
+	constexpr static Key commitCharactersKey    = "commitCharacters";
+	constexpr static Key commandKey             = "command";
+	constexpr static Key dataKey                = "data";
 
 	struct TagsMaker: public ObjectT
 	{
@@ -503,8 +503,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String isIncompleteKey;
-	const static String itemsKey;
+	constexpr static Key isIncompleteKey = "isIncomplete";
+	constexpr static Key itemsKey        = "items";
 
 public:
 	/// This list it not complete. Further typing should result in recomputing
@@ -555,10 +555,10 @@ public:
 struct CompletionClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String completionItemKey;
-	const static String completionItemKindKey;
-	const static String contextSupportKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key completionItemKey      = "completionItem";
+	constexpr static Key completionItemKindKey  = "completionItemKind";
+	constexpr static Key contextSupportKey      = "contextSupport";
 
 public:
 	/// Whether completion supports dynamic registration.
@@ -569,12 +569,12 @@ public:
 	struct CompletionItem: public ObjectT
 	{
 	private:
-		const static String snippetSupportKey;
-		const static String commitCharactersSupportKey;
-		const static String documentationFormatKey;
-		const static String deprecatedSupportKey;
-		const static String preselectSupportKey;
-		const static String tagSupportKey;
+		constexpr static Key snippetSupportKey          = "snippetSupport";
+		constexpr static Key commitCharactersSupportKey = "commitCharactersSupport";
+		constexpr static Key documentationFormatKey     = "documentationFormat";
+		constexpr static Key deprecatedSupportKey       = "deprecatedSupport";
+		constexpr static Key preselectSupportKey        = "preselectSupport";
+		constexpr static Key tagSupportKey              = "tagSupport";
 
 		struct DocumentationFormatMaker: public ObjectT
 		{
@@ -625,7 +625,7 @@ public:
 		struct TagSupport: public ObjectT
 		{
 		private:
-			const static String valueSetKey;
+			constexpr static Key valueSetKey = "valueSet";
 
 			struct ValueSetMaker: public ObjectT
 			{
@@ -706,7 +706,7 @@ public:
 	struct CompletionItemKind: public ObjectT
 	{
 	private:
-		const static String valueSetKey;
+		constexpr static Key valueSetKey = "valueSet";
 
 		struct ValueSetMaker: public ObjectT
 		{
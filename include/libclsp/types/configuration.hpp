@@ -32,8 +32,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String scopeUriKey;
-	const static String sectionKey;
+	constexpr static Key scopeUriKey = "scopeUri";
+	constexpr static Key sectionKey  = "section";
 
 public:
 	/// The scope to get the configuration section for.
@@ -58,7 +58,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String itemsKey;
+	constexpr static Key itemsKey = "items";
 
 public:
 	vector<ConfigurationItem> items;
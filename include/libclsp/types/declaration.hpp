@@ -36,8 +36,8 @@ using namespace std;
 struct DeclarationClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String linkSupportKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key linkSupportKey         = "linkSupport";
 
 public:
 	/// Whether declaration supports dynamic registration. If this is set to
@@ -39,8 +39,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String locationKey;
-	const static String messageKey;
+	constexpr static Key locationKey = "location";
+	constexpr static Key messageKey  = "message";
 
 public:
 	/// The location of this related diagnostic information.
@@ -119,13 +119,13 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String rangeKey;
-	const static String severityKey;
-	const static String codeKey;
-	const static String sourceKey;
-	const static String messageKey;
-	const static String tagsKey;
-	const static String relatedInformationKey;
+	constexpr static Key rangeKey              = "range";
+	constexpr static Key severityKey           = "severity";
+	constexpr static Key codeKey               = "code";
+	constexpr static Key sourceKey             = "source";
+	constexpr static Key messageKey            = "message";
+	constexpr static Key tagsKey               = "tags";
+	constexpr static Key relatedInformationKey = "relatedInformation";
 
 	struct TagsMaker: public ObjectT
 	{
@@ -33,7 +33,7 @@ using namespace std;
 struct DidChangeConfigurationClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Did change configuration notification supports dynamic registration.
@@ -66,7 +66,7 @@ public:
 struct DidChangeConfigurationParams: public ObjectT
 {
 private:
-	const static String settingsKey;
+	constexpr static Key settingsKey = "settings";
 
 public:
 	/// The actual changed settings
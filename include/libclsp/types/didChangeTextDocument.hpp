@@ -42,7 +42,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String syncKindKey;
+	constexpr static Key syncKindKey = "syncKind";
 
 public:
 	/// How documents are synced to the server. See TextDocumentSyncKind.Full
@@ -76,9 +76,9 @@ public:
 struct TextDocumentContentChangeEvent: public ObjectT
 {
 private:
-	const static String rangeKey;
-	const static String rangeLengthKey;
-	const static String textKey;
+	constexpr static Key rangeKey       = "range";
+	constexpr static Key rangeLengthKey = "rangeLength";
+	constexpr static Key textKey        = "text";
 
 public:
 	/// The range of the document that changed.
@@ -126,8 +126,8 @@ public:
 struct DidChangeTextDocumentParams: public ObjectT
 {
 private:
-	const static String textDocumentKey;
-	const static String contentChangesKey;
+	constexpr static Key textDocumentKey   = "textDocument";
+	constexpr static Key contentChangesKey = "contentChanges";
 
 	struct ContentChangesMaker: public ObjectT
 	{
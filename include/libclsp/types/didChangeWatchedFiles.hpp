@@ -33,7 +33,7 @@ using namespace std;
 struct DidChangeWatchedFilesClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Did change watched files notification supports dynamic registration.
@@ -134,8 +134,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String globPatternKey;
-	const static String kindKey;
+	constexpr static Key globPatternKey = "globPattern";
+	constexpr static Key kindKey        = "kind";
 
 public:
 	/// The  glob pattern to watch.
@@ -175,7 +175,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String watchersKey;
+	constexpr static Key watchersKey = "watchers";
 
 public:
 	/// The watchers to register.
@@ -212,8 +212,8 @@ enum class FileChangeType
 struct FileEvent: public ObjectT
 {
 private:
-	const static String uriKey;
-	const static String typeKey;
+	constexpr static Key uriKey  = "uri";
+	constexpr static Key typeKey = "type";
 
 public:
 	/// The file's URI.
@@ -248,7 +248,7 @@ public:
 struct DidChangeWatchedFilesParams: public ObjectT
 {
 private:
-	const static String changesKey;
+	constexpr static Key changesKey = "changes";
 
 	struct ChangesMaker: public ObjectT
 	{
@@ -32,8 +32,8 @@ using namespace std;
 struct WorkspaceFoldersChangeEvent: public ObjectT
 {
 private:
-	const static String addedKey;
-	const static String removedKey;;
+	constexpr static Key addedKey = "added";
+	constexpr static Key removedKey = "removed";;
 
 	struct AddedRemovedMaker: public ObjectT
 	{
@@ -91,7 +91,7 @@ public:
 struct DidChangeWorkspaceFoldersParams: public ObjectT
 {
 private:
-	const static String eventKey;
+	constexpr static Key eventKey = "event";
 
 public:
 	/// The actual workspace folder change event.
@@ -32,7 +32,7 @@ using namespace std;
 struct DidCloseTextDocumentParams: public ObjectT
 {
 private:
-	const static String textDocumentKey;
+	constexpr static Key textDocumentKey = "textDocument";
 
 public:
 	/// The document that was closed.
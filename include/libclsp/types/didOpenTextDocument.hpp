@@ -32,7 +32,7 @@ using namespace std;
 struct DidOpenTextDocumentParams: public ObjectT
 {
 private:
-	const static String textDocumentKey;
+	constexpr static Key textDocumentKey = "textDocument";
 
 public:
 	/// The document that was opened.
@@ -35,7 +35,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String includeTextKey;
+	constexpr static Key includeTextKey = "includeText";
 
 public:
 	/// The client is supposed to include the content on save.
@@ -61,7 +61,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String includeTextKey;
+	constexpr static Key includeTextKey = "includeText";
 
 public:
 	/// The client is supposed to include the content on save.
@@ -87,8 +87,8 @@ public:
 struct DidSaveTextDocumentParams: public ObjectT
 {
 private:
-	const static String textDocumentKey;
-	const static String textKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key textKey         = "text";
 
 public:
 	/// The document that was saved.
@@ -35,7 +35,7 @@ using namespace std;
 struct DocumentColorClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Whether document color supports dynamic registration.
@@ -93,7 +93,7 @@ struct DocumentColorParams:
 	public PartialResultParams
 {
 private:
-	const static String textDocumentKey;
+	constexpr static Key textDocumentKey = "textDocument";
 
 public:
 	/// The text document.
@@ -137,10 +137,10 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String redKey;
-	const static String greenKey;
-	const static String blueKey;
-	const static String alphaKey;
+	constexpr static Key redKey   = "red";
+	constexpr static Key greenKey = "green";
+	constexpr static Key blueKey  = "blue";
+	constexpr static Key alphaKey = "alpha";
 
 public:
 	/// The red component of this color in the range [0-1].
@@ -186,8 +186,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String rangeKey;
-	const static String colorKey;
+	constexpr static Key rangeKey = "range";
+	constexpr static Key colorKey = "color";
 
 public:
 	/// The range in the document where this color appears.
@@ -41,9 +41,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String languageKey;
-	const static String schemeKey;
-	const static String patternKey;
+	constexpr static Key languageKey = "language";
+	constexpr static Key schemeKey   = "scheme";
+	constexpr static Key patternKey  = "pattern";
 
 public:
 	/// A language id, like `typescript`.
@@ -35,7 +35,7 @@ using namespace std;
 struct DocumentFormattingClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Whether declaration supports dynamic registration.
@@ -99,11 +99,11 @@ public:
 struct FormattingOptions: public ObjectT
 {
 private:
-	const static String tabSizeKey;
-	const static String insertSpacesKey;
-	const static String trimTrailingWhitespaceKey;
-	const static String insertFinalNewlineKey;
-	const static String trimFinalNewlinesKey;
+	constexpr static Key tabSizeKey                = "tabSize";
+	constexpr static Key insertSpacesKey           = "insertSpaces";
+	constexpr static Key trimTrailingWhitespaceKey = "trimTrailingWhitespace";
+	constexpr static Key insertFinalNewlineKey     = "insertFinalNewline";
+	constexpr static Key trimFinalNewlinesKey      = "trimFinalNewlines";
 
 public:
 	/// Size of a tab in spaces.
@@ -164,8 +164,8 @@ public:
 struct DocumentFormattingParams: public WorkDoneProgressParams
 {
 private:
-	const static String textDocumentKey;
-	const static String optionsKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key optionsKey      = "options";
 
 public:
 	/// The document to format.
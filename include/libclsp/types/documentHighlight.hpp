@@ -34,7 +34,7 @@ using namespace std;
 struct DocumentHighlightClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Whether declaration supports dynamic registration.
@@ -133,8 +133,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String rangeKey;
-	const static String kindKey;
+	constexpr static Key rangeKey = "range";
+	constexpr static Key kindKey  = "kind";
 
 public:
 	/// The range this highlight applies to.
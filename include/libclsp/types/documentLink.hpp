@@ -38,8 +38,8 @@ using namespace std;
 struct DocumentLinkClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String tooltipSupportKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key tooltipSupportKey      = "tooltipSupport";
 
 public:
 	/// Whether code action supports dynamic registration.
@@ -81,7 +81,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String resolveProviderKey;
+	constexpr static Key resolveProviderKey = "resolveProvider";
 
 public:
 	/// Code lens has a resolve provider as well.
@@ -127,7 +127,7 @@ struct DocumentLinkParams:
 	public PartialResultParams
 {
 private:
-	const static String textDocumentKey;
+	constexpr static Key textDocumentKey = "textDocument";
 
 public:
 	/// The document to provide document links for.
@@ -172,10 +172,10 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String rangeKey;;
-	const static String targetKey;
-	const static String tooltipKey;;
-	const static String dataKey;
+	constexpr static Key rangeKey = "range";;
+	constexpr static Key targetKey = "target";
+	constexpr static Key tooltipKey = "tooltip";;
+	constexpr static Key dataKey = "data";
 
 public:
 	/// The range this link applies to.
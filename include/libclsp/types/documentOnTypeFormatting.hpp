@@ -30,7 +30,7 @@ using namespace std;
 struct DocumentOnTypeFormattingClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Whether declaration supports dynamic registration.
@@ -69,8 +69,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String firstTriggerCharacterKey;
-	const static String moreTriggerCharacterKey;
+	constexpr static Key firstTriggerCharacterKey = "firstTriggerCharacter";
+	constexpr static Key moreTriggerCharacterKey  = "moreTriggerCharacter";
 
 public:
 	/// A character on which formatting should be triggered, like `}`.
@@ -119,8 +119,8 @@ public:
 struct DocumentOnTypeFormattingParams: public TextDocumentPositionParams
 {
 private:
-	const static String chKey;
-	const static String optionsKey;
+	constexpr static Key chKey      = "ch";
+	constexpr static Key optionsKey = "options";
 
 public:
 	/// The character that has been typed.
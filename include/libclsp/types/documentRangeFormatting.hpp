@@ -30,7 +30,7 @@ using namespace std;
 struct DocumentRangeFormattingClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Whether declaration supports dynamic registration.
@@ -89,9 +89,9 @@ public:
 struct DocumentRangeFormattingParams: public WorkDoneProgressParams
 {
 private:
-	const static String textDocumentKey;
-	const static String rangeKey;
-	const static String optionsKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key rangeKey        = "range";
+	constexpr static Key optionsKey      = "options";
 
 public:
 	/// The document to format.
@@ -73,9 +73,9 @@ enum class SymbolKind
 struct DocumentSymbolClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String symbolKindKey;
-	const static String hierarchicalDocumentSymbolSupportKey;
+	constexpr static Key dynamicRegistrationKey               = "dynamicRegistration";
+	constexpr static Key symbolKindKey                        = "symbolKind";
+	constexpr static Key hierarchicalDocumentSymbolSupportKey = "hierarchicalDocumentSymbolSupport";
 
 public:
 	/// Whether declaration supports dynamic registration.
@@ -86,7 +86,7 @@ public:
 	struct SymbolKind: public ObjectT
 	{
 	private:
-		const static String valueSetKey;
+		constexpr static Key valueSetKey = "valueSet";
 
 		struct ValueSetMaker: public ObjectT
 		{
@@ -194,7 +194,7 @@ struct DocumentSymbolParams:
 	public PartialResultParams
 {
 private:
-	const static String textDocumentKey;
+	constexpr static Key textDocumentKey = "textDocument";
 
 public:
 	/// The text document.
@@ -248,13 +248,13 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String nameKey;
-	const static String detailKey;
-	const static String kindKey;
-	const static String deprecatedKey;
-	const static String rangeKey;
-	const static String selectionRangeKey;
-	const static String childrenKey;
+	constexpr static Key nameKey           = "name";
+	constexpr static Key detailKey         = "detail";
+	constexpr static Key kindKey           = "kind";
+	constexpr static Key deprecatedKey     = "deprecated";
+	constexpr static Key rangeKey          = "range";
+	constexpr static Key selectionRangeKey = "selectionRange";
+	constexpr static Key childrenKey       = "children";
 
 public:
 	/// The name of this symbol. Will be displayed in the user interface and
@@ -319,11 +319,11 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String nameKey;
-	const static String kindKey;
-	const static String deprecatedKey;
-	const static String locationKey;
-	const static String containerNameKey;
+	constexpr static Key nameKey          = "name";
+	constexpr static Key kindKey          = "kind";
+	constexpr static Key deprecatedKey    = "deprecated";
+	constexpr static Key locationKey      = "location";
+	constexpr static Key containerNameKey = "containerName";
 
 public:
 	/// The name of this symbol.
@@ -32,7 +32,7 @@ using namespace std;
 struct ExecuteCommandClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Execute command supports dynamic registration.
@@ -68,7 +68,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String commandsKey;
+	constexpr static Key commandsKey = "commands";
 
 public:
 	/// The commands to be executed on the server
@@ -96,8 +96,8 @@ using ExecuteCommandRegistrationOptions = ExecuteCommandOptions; // No parsing
 struct ExecuteCommandParams: public WorkDoneProgressParams
 {
 private:
-	const static String commandKey;
-	const static String argumentsKey;
+	constexpr static Key commandKey   = "command";
+	constexpr static Key argumentsKey = "arguments";
 
 public:
 	/// The identifier of the actual command handler.
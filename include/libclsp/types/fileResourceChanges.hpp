@@ -38,8 +38,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String overwriteKey;
-	const static String ignoreIfExistsKey;
+	constexpr static Key overwriteKey      = "overwrite";
+	constexpr static Key ignoreIfExistsKey = "ignoreIfExists";
 
 public:
 	/// Overwrite existing file. Overwrite wins over `ignoreIfExists`
@@ -72,12 +72,12 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String uriKey;
-	const static String optionsKey;
+	constexpr static Key uriKey     = "uri";
+	constexpr static Key optionsKey = "options";
 
 public:
 	/// A create
-	const static pair<String, String> kind;
+	constexpr static pair<Key, Key> kind = {"kind", "create"};
 
 	/// The resource to create.
 	DocumentUri uri;
@@ -107,8 +107,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String overwriteKey;
-	const static String ignoreIfExistsKey;
+	constexpr static Key overwriteKey      = "overwrite";
+	constexpr static Key ignoreIfExistsKey = "ignoreIfExists";
 
 public:
 	/// Overwrite existing file. Overwrite wins over `ignoreIfExists`
@@ -143,13 +143,13 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String oldUriKey;
-	const static String newUriKey;
-	const static String optionsKey;
+	constexpr static Key oldUriKey  = "oldUri";
+	constexpr static Key newUriKey  = "newUri";
+	constexpr static Key optionsKey = "options";
 
 public:
 	/// A rename
-	const static pair<String, String> kind;
+	constexpr static pair<Key, Key> kind = {"kind", "rename"};
 
 	/// The old (existing) location.
 	DocumentUri oldUri;
@@ -184,8 +184,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String recursiveKey;
-	const static String ignoreIfNotExistsKey;
+	constexpr static Key recursiveKey         = "recursive";
+	constexpr static Key ignoreIfNotExistsKey = "ignoreIfNotExists";
 
 public:
 	/// Delete the content recursively if a folder is denoted.
@@ -219,12 +219,12 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String uriKey;
-	const static String optionsKey;
+	constexpr static Key uriKey     = "uri";
+	constexpr static Key optionsKey = "options";
 
 public:
 	/// A delete
-	const static pair<String, String> kind;
+	constexpr static pair<Key, Key> kind = {"kind", "delete"};
 
 	/// The file to delete.
 	DocumentUri uri;
@@ -42,9 +42,9 @@ using namespace std;
 struct FoldingRangeClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String rangeLimitKey;
-	const static String lineFoldingOnlyKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key rangeLimitKey          = "rangeLimit";
+	constexpr static Key lineFoldingOnlyKey     = "lineFoldingOnly";
 
 public:
 	/// Whether implementation supports dynamic registration. If this is set to
@@ -116,7 +116,7 @@ struct FoldingRangeParams:
 	public PartialResultParams
 {
 private:
-	const static String textDocumentKey;
+	constexpr static Key textDocumentKey = "textDocument";
 
 public:
 	/// The text document.
@@ -195,11 +195,11 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String startLineKey;
-	const static String startCharacterKey;
-	const static String endLineKey;
-	const static String endCharacterKey;
-	const static String kindKey;
+	constexpr static Key startLineKey      = "startLine";
+	constexpr static Key startCharacterKey = "startCharacter";
+	constexpr static Key endLineKey        = "endLine";
+	constexpr static Key endCharacterKey   = "endCharacter";
+	constexpr static Key kindKey           = "kind";
 
 public:
 	/// The zero-based line number from where the folded range starts.
@@ -102,11 +102,11 @@ struct ObjectArrayMaker: public ObjectT
 	//===============================================================//
 
 
-	ObjectArrayMaker<Object>(vector<Object> &parentArray):
+	ObjectArrayMaker(vector<Object> &parentArray):
 		parentArray(parentArray)
 	{};
 
-	virtual ~ObjectArrayMaker<Object>(){};
+	virtual ~ObjectArrayMaker(){};
 };
 
 /// An object with no predefined key-value pairs.
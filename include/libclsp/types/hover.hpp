@@ -38,8 +38,8 @@ using namespace std;
 struct HoverClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String contentFormatKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key contentFormatKey       = "contentFormat";
 
 	struct ContentFormatMaker: public ObjectT
 	{
@@ -143,8 +143,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String languageKey;
-	const static String valueKey;
+	constexpr static Key languageKey = "language";
+	constexpr static Key valueKey    = "value";
 
 public:
 	String language;
@@ -192,8 +192,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String contentsKey;
-	const static String rangeKey;
+	constexpr static Key contentsKey = "contents";
+	constexpr static Key rangeKey    = "range";
 
 public:
 	/// The hover's content
@@ -102,28 +102,28 @@ using namespace std;
 struct TextDocumentClientCapabilities: public ObjectT
 {
 private:
-	const static String synchronizationKey;
-	const static String completionKey;
-	const static String hoverKey;
-	const static String signatureHelpKey;
-	const static String declarationKey;
-	const static String definitionKey;
-	const static String typeDefinitionKey;
-	const static String implementationKey;
-	const static String referencesKey;
-	const static String documentHighlightKey;
-	const static String documentSymbolKey;
-	const static String codeActionKey;
-	const static String codeLensKey;
-	const static String documentLinkKey;
-	const static String colorProviderKey;
-	const static String formattingKey;
-	const static String rangeFormattingKey;
-	const static String onTypeFormattingKey;
-	const static String renameKey;
-	const static String publishDiagnosticsKey;
-	const static String foldingRangeKey;
-	const static String selectionRangeKey;
+	constexpr static Key synchronizationKey    = "synchronization";
+	constexpr static Key completionKey         = "completion";
+	constexpr static Key hoverKey              = "hover";
+	constexpr static Key signatureHelpKey      = "signatureHelp";
+	constexpr static Key declarationKey        = "declaration";
+	constexpr static Key definitionKey         = "definition";
+	constexpr static Key typeDefinitionKey     = "typeDefinition";
+	constexpr static Key implementationKey     = "implementation";
+	constexpr static Key referencesKey         = "references";
+	constexpr static Key documentHighlightKey  = "documentHighlight";
+	constexpr static Key documentSymbolKey     = "documentSymbol";
+	constexpr static Key codeActionKey         = "codeAction";
+	constexpr static Key codeLensKey           = "codeLens";
+	constexpr static Key documentLinkKey       = "documentLink";
+	constexpr static Key colorProviderKey      = "colorProvider";
+	constexpr static Key formattingKey         = "formatting";
+	constexpr static Key rangeFormattingKey    = "rangeFormatting";
+	constexpr static Key onTypeFormattingKey   = "onTypeFormatting";
+	constexpr static Key renameKey             = "rename";
+	constexpr static Key publishDiagnosticsKey = "publishDiagnostics";
+	constexpr static Key foldingRangeKey       = "foldingRange";
+	constexpr static Key selectionRangeKey     = "selectionRange";
 
 public:
 	optional<TextDocumentSyncClientCapabilities> synchronization;
@@ -276,23 +276,23 @@ public:
 struct ClientCapabilities: public ObjectT
 {
 private:
-	const static String workspaceKey;
-	const static String textDocumentKey;
-	const static String experimentalKey;
+	constexpr static Key workspaceKey    = "workspace";
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key experimentalKey = "experimental";
 
 public:
 	/// Workspace specific client capabilities.
 	struct Workspace: public ObjectT
 	{
 	private:
-		const static String applyEditKey;
-		const static String workspaceEditKey;
-		const static String didChangeConfigurationKey;
-		const static String didChangeWatchedFilesKey;
-		const static String symbolKey;
-		const static String executeCommandKey;
-		const static String workspaceFoldersKey;
-		const static String configurationKey;
+		constexpr static Key applyEditKey              = "applyEdit";
+		constexpr static Key workspaceEditKey          = "workspaceEdit";
+		constexpr static Key didChangeConfigurationKey = "didChangeConfiguration";
+		constexpr static Key didChangeWatchedFilesKey  = "didChangeWatchedFiles";
+		constexpr static Key symbolKey                 = "symbol";
+		constexpr static Key executeCommandKey         = "executeCommand";
+		constexpr static Key workspaceFoldersKey       = "workspaceFolders";
+		constexpr static Key configurationKey          = "configuration";
 
 	public:
 		/// The client supports applying batch edits
@@ -362,7 +362,7 @@ public:
 	optional<Any> experimental;
 
 	/// Extra capabilities
-	map<Key, Any> extra;
+	map<String, Any> extra;
 
 
 	//====================   Parsing   ======================================//
@@ -379,7 +379,7 @@ public:
 	ClientCapabilities(optional<Workspace> workspace,
 		optional<TextDocumentClientCapabilities> textDocument,
 		optional<Any> experimental,
-		map<Key, Any> extra);
+		map<String, Any> extra);
 
 	ClientCapabilities();
 
@@ -454,14 +454,14 @@ public:
 struct InitializeParams: public WorkDoneProgressParams
 {
 private:
-	const static String processIdKey;
-	const static String clientInfoKey;
-	const static String rootPathKey;
-	const static String rootUriKey;
-	const static String initializationOptionsKey;
-	const static String capabilitiesKey;
-	const static String traceKey;
-	const static String workspaceFoldersKey;
+	constexpr static Key processIdKey             = "processId";
+	constexpr static Key clientInfoKey            = "clientInfo";
+	constexpr static Key rootPathKey              = "rootPath";
+	constexpr static Key rootUriKey               = "rootUri";
+	constexpr static Key initializationOptionsKey = "initializationOptions";
+	constexpr static Key capabilitiesKey          = "capabilities";
+	constexpr static Key traceKey                 = "trace";
+	constexpr static Key workspaceFoldersKey      = "workspaceFolders";
 
 	struct WorkspaceFoldersMaker: public ObjectT
 	{
@@ -494,8 +494,8 @@ public:
 	struct ClientInfo: public ObjectT
 	{
 	private:
-		const static String nameKey;
-		const static String versionKey;
+		constexpr static Key nameKey    = "name";
+		constexpr static Key versionKey = "version";
 
 	public:
 		/// The name of the client as defined by the client.
@@ -656,31 +656,31 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String textDocumentSyncKey;
-	const static String completionProviderKey;
-	const static String hoverProviderKey;
-	const static String signatureHelpProviderKey;
-	const static String declarationProviderKey;
-	const static String definitionProviderKey;
-	const static String typeDefinitionProviderKey;
-	const static String implementationProviderKey;
-	const static String referencesProviderKey;
-	const static String documentHighlightProviderKey;
-	const static String documentSymbolProviderKey;
-	const static String codeActionProviderKey;
-	const static String codeLensProviderKey;
-	const static String documentLinkProviderKey;
-	const static String colorProviderKey;
-	const static String documentFormattingProviderKey;
-	const static String documentRangeFormattingProviderKey;
-	const static String documentOnTypeFormattingProviderKey;
-	const static String renameProviderKey;
-	const static String foldingRangeProviderKey;
-	const static String executeCommandProviderKey;
-	const static String selectionRangeProviderKey;
-	const static String workspaceSymbolProviderKey;
-	const static String workspaceKey;
-	const static String experimentalKey;
+	constexpr static Key textDocumentSyncKey                 = "textDocumentSync";
+	constexpr static Key completionProviderKey               = "completionProvider";
+	constexpr static Key hoverProviderKey                    = "hoverProvider";
+	constexpr static Key signatureHelpProviderKey            = "signatureHelpProvider";
+	constexpr static Key declarationProviderKey              = "declarationProvider";
+	constexpr static Key definitionProviderKey               = "definitionProvider";
+	constexpr static Key typeDefinitionProviderKey           = "typeDefinitionProvider";
+	constexpr static Key implementationProviderKey           = "implementationProvider";
+	constexpr static Key referencesProviderKey               = "referencesProvider";
+	constexpr static Key documentHighlightProviderKey        = "documentHighlightProvider";
+	constexpr static Key documentSymbolProviderKey           = "documentSymbolProvider";
+	constexpr static Key codeActionProviderKey               = "codeActionProvider";
+	constexpr static Key codeLensProviderKey                 = "codeLensProvider";
+	constexpr static Key documentLinkProviderKey             = "documentLinkProvider";
+	constexpr static Key colorProviderKey                    = "colorProvider";
+	constexpr static Key documentFormattingProviderKey       = "documentFormattingProvider";
+	constexpr static Key documentRangeFormattingProviderKey  = "documentRangeFormattingProvider";
+	constexpr static Key documentOnTypeFormattingProviderKey = "documentOnTypeFormattingProvider";
+	constexpr static Key renameProviderKey                   = "renameProvider";
+	constexpr static Key foldingRangeProviderKey             = "foldingRangeProvider";
+	constexpr static Key executeCommandProviderKey           = "executeCommandProvider";
+	constexpr static Key selectionRangeProviderKey           = "selectionRangeProvider";
+	constexpr static Key workspaceSymbolProviderKey          = "workspaceSymbolProvider";
+	constexpr static Key workspaceKey                        = "workspace";
+	constexpr static Key experimentalKey                     = "experimental";
 
 public:
 	/// Defines how text documents are synced. Is either a detailed structure
@@ -794,7 +794,7 @@ public:
 		virtual void partialWrite(JsonWriter &writer);
 
 	private:
-		const static String workspaceFoldersKey;
+		constexpr static Key workspaceFoldersKey = "workspaceFolders";
 
 	public:
 		/// The server supports workspace folder.
@@ -904,8 +904,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String capabilitiesKey;
-	const static String serverInfoKey;
+	constexpr static Key capabilitiesKey = "capabilities";
+	constexpr static Key serverInfoKey   = "serverInfo";
 
 public:
 	/// The capabilities the language server provides.
@@ -921,8 +921,8 @@ public:
 		virtual void partialWrite(JsonWriter &writer);
 
 	private:
-		const static String nameKey;
-		const static String versionKey;
+		constexpr static Key nameKey    = "name";
+		constexpr static Key versionKey = "version";
 
 	public:
 		/// The name of the server as defined by the server.
@@ -966,7 +966,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String retryKey;
+	constexpr static Key retryKey = "retry";
 
 public:
 	/// Indicates whether the client execute the following retry logic:
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 #include <memory>
@@ -45,8 +46,8 @@ using Any = variant<String, Number, Boolean, Null, Object, Array>;
 using DocumentUri   = String;
 using ProgressToken = variant<Number, String>;
 
-/// A utility type
-using Key = const String;
+/// The name of a member, the known ones are constants.
+using Key = string_view;
 
 
 // Some operator overloads for the Number type
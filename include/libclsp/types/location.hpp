@@ -39,8 +39,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String uriKey;
-	const static String rangeKey;
+	constexpr static Key uriKey   = "uri";
+	constexpr static Key rangeKey = "range";
 
 public:
 	DocumentUri uri;
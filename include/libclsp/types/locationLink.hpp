@@ -43,10 +43,10 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String originSelectionRangeKey;
-	const static String targetUriKey;
-	const static String targetRangeKey;
-	const static String targetSelectionRangeKey;
+	constexpr static Key originSelectionRangeKey = "originSelectionRange";
+	constexpr static Key targetUriKey            = "targetUri";
+	constexpr static Key targetRangeKey          = "targetRange";
+	constexpr static Key targetSelectionRangeKey = "targetSelectionRange";
 
 public:
 	/// Span of the origin of this link.
@@ -37,8 +37,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String typeKey;
-	const static String messageKey;
+	constexpr static Key typeKey    = "type";
+	constexpr static Key messageKey = "message";
 
 public:
 	/// The message type. See {@link MessageType}
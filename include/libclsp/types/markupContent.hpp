@@ -89,8 +89,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String kindKey;
-	const static String valueKey;
+	constexpr static Key kindKey  = "kind";
+	constexpr static Key valueKey = "value";
 
 public:
 	/// The type of the Markup
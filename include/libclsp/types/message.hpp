@@ -37,7 +37,11 @@ protected:
 	Server& server;
 
 public:
-	const static pair<String, String> jsonrpc;
+	constexpr static pair<Key, Key> jsonrpc = {"jsonrpc", "2.0"};
+
+	/// The server of the session of the message. The handlers shared by
+	/// the sessions of a host use it to send their messages.
+	Server& getServer();
 
 	Message(Server& server);
 
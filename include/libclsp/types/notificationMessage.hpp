@@ -19,6 +19,7 @@
 #include <variant>
 #include <optional>
 
+#include <libclsp/server/envelope.hpp>
 #include <libclsp/types/message.hpp>
 
 namespace clsp
@@ -40,19 +41,19 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String methodKey;
-	const static String paramsKey;
+	constexpr static Key methodKey = "method";
+	constexpr static Key paramsKey = "params";
 
 public:
 	/// The method to be invoked.
 	String method;
 
 	/// The notification's params.
-	optional<any> params;
+	Envelope params;
 
 	NotificationMessage(Server& server,
 		String method,
-		optional<any> params);
+		Envelope params);
 
 	NotificationMessage(Server& server);
 
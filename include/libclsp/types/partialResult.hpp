@@ -37,7 +37,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String partialResultTokenKey;
+	constexpr static Key partialResultTokenKey = "partialResultToken";
 
 public:
 	/// An optional token that a server can use to report partial results
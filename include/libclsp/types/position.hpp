@@ -40,8 +40,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String lineKey;
-	const static String characterKey;
+	constexpr static Key lineKey      = "line";
+	constexpr static Key characterKey = "character";
 
 public:
 
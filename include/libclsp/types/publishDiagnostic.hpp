@@ -37,9 +37,9 @@ using namespace std;
 struct PublishDiagnosticsClientCapabilities: public ObjectT
 {
 private:
-	const static String relatedInformationKey;
-	const static String tagSupportKey;
-	const static String versionSupportKey;
+	constexpr static Key relatedInformationKey = "relatedInformation";
+	constexpr static Key tagSupportKey         = "tagSupport";
+	constexpr static Key versionSupportKey     = "versionSupport";
 public:
 
 	/// Whether the clients accepts diagnostics with related information.
@@ -53,7 +53,7 @@ public:
 	struct TagSupport: public ObjectT
 	{
 	private:
-		const static String valueSetKey;
+		constexpr static Key valueSetKey = "valueSet";
 
 		struct ValueSetMaker: public ObjectT
 		{
@@ -143,9 +143,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String uriKey;
-	const static String versionKey;
-	const static String diagnosticsKey;
+	constexpr static Key uriKey         = "uri";
+	constexpr static Key versionKey     = "version";
+	constexpr static Key diagnosticsKey = "diagnostics";
 
 public:
 	/// The URI for which diagnostic information is reported.
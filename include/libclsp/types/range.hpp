@@ -39,8 +39,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String startKey;
-	const static String endKey;
+	constexpr static Key startKey = "start";
+	constexpr static Key endKey   = "end";
 
 public:
 	/// The range's start position.
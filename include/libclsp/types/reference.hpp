@@ -33,7 +33,7 @@ using namespace std;
 struct ReferenceClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Whether declaration supports dynamic registration.
@@ -88,7 +88,7 @@ public:
 struct ReferenceContext: public ObjectT
 {
 private:
-	const static String includeDeclarationKey;
+	constexpr static Key includeDeclarationKey = "includeDeclaration";
 
 public:
 	Boolean includeDeclaration;
@@ -122,7 +122,7 @@ struct ReferenceParams:
 	public PartialResultParams
 {
 private:
-	const static String contextKey;
+	constexpr static Key contextKey = "context";
 
 public:
 	ReferenceContext context;
@@ -40,9 +40,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String idKey;
-	const static String methodKey;
-	const static String registerOptionsKey;
+	constexpr static Key idKey              = "id";
+	constexpr static Key methodKey          = "method";
+	constexpr static Key registerOptionsKey = "registerOptions";
 
 public:
 	/// The id used to register the request. The id can be used to deregister
@@ -81,7 +81,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String registrationsKey;
+	constexpr static Key registrationsKey = "registrations";
 
 public:
 	vector<Registration> registrations;
@@ -109,8 +109,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String idKey;
-	const static String methodKey;
+	constexpr static Key idKey     = "id";
+	constexpr static Key methodKey = "method";
 
 public:
 	/// The id used to unregister the request or notification. Usually an id
@@ -141,7 +141,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String unregisterationsKey;
+	constexpr static Key unregisterationsKey = "unregisterations";
 
 public:
 	/// This should correctly be named `unregistrations`. However changing this
@@ -36,8 +36,8 @@ using namespace std;
 struct RenameClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String prepareSupportKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key prepareSupportKey      = "prepareSupport";
 
 public:
 	/// Whether declaration supports dynamic registration.
@@ -81,7 +81,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String prepareProviderKey;
+	constexpr static Key prepareProviderKey = "prepareProvider";
 
 public:
 	/// Renames should be checked and tested before being executed.
@@ -126,7 +126,7 @@ struct RenameParams: public TextDocumentPositionParams,
 	public WorkDoneProgressParams
 {
 private:
-	const static String newNameKey;
+	constexpr static Key newNameKey = "newName";
 
 public:
 	/// The new name of the symbol. If the given name is not valid the
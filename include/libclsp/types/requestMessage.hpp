@@ -21,6 +21,8 @@
 #include <optional>
 #include <variant>
 
+#include <libclsp/server/cancellationToken.hpp>
+#include <libclsp/server/envelope.hpp>
 #include <libclsp/types/jsonTypes.hpp>
 #include <libclsp/types/message.hpp>
 
@@ -40,31 +42,40 @@ using namespace std;
 ///
 struct RequestMessage: public Message
 {
+protected:
+	/// This is like write() but without the object bounds.
+	virtual void partialWrite(JsonWriter &writer);
 
-	const static String idKey;
+public:
+
+	constexpr static Key idKey = "id";
 
 	/// The request id.
 	variant<Number, String> id;
 
 
-	const static String methodKey;
+	constexpr static Key methodKey = "method";
 
 	/// The method to be invoked.
 	String method;
 
 
-	const static String paramsKey;
+	constexpr static Key paramsKey = "params";
 
 	/// The method's params.
-	optional<any> params;
+	Envelope params;
 
 	optional<function<void(any&, Writer<StringBuffer>&)>> paramsWriter;
 
+	/// Set when the client cancels a request it sent. The result of a
+	/// cancelled request is replaced by a RequestCancelled error.
+	CancellationToken cancellation;
+
 
 	RequestMessage(Server& server,
 		variant<Number, String> id,
 		String method,
-		optional<any> params,
+		Envelope params,
 		optional<function<void(any&, Writer<StringBuffer>&)>> paramsWriter);
 
 	RequestMessage(Server& server);
@@ -21,6 +21,7 @@
 #include <optional>
 #include <variant>
 
+#include <libclsp/server/envelope.hpp>
 #include <libclsp/types/jsonTypes.hpp>
 #include <libclsp/types/message.hpp>
 
@@ -57,24 +58,35 @@ enum class ErrorCodes
 ///
 struct ResponseError: public ObjectT
 {
-	const static String codeKey;
+	constexpr static Key codeKey = "code";
 
 	/// A number indicating the error type that occurred.
 	ErrorCodes code;
 
 
-	const static String messageKey;
+	constexpr static Key messageKey = "message";
 
 	/// A string providing a short description of the error.
 	String message;
 
 
-	const static String dataKey;
+	constexpr static Key dataKey = "data";
 
 	/// A Primitive or Structured value that contains additional
 	/// information about the error. Can be omitted.
 	optional<variant<String, Number, Boolean, Array, Object, Null>> data;
 
+
+	//====================   Parsing   ======================================//
+
+	/// This fills an ObjectInitializer
+	virtual void fillInitializer(ObjectInitializer& initializer);
+
+	// Using default isValid()
+
+	//=======================================================================//
+
+
 	// Initialize variables outside the constructor.
 	// The variant constructor is not very clever.
 	ResponseError(ErrorCodes code, String message,
@@ -108,9 +120,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String idKey;
-	const static String resultKey;
-	const static String errorKey;
+	constexpr static Key idKey     = "id";
+	constexpr static Key resultKey = "result";
+	constexpr static Key errorKey  = "error";
 
 public:
 	/// The request id.
@@ -118,15 +130,23 @@ public:
 
 	/// The result of a request. This member is REQUIRED on success.
 	/// This member MUST NOT exist if there was an error invoking the method.
-	optional<any> result;
+	Envelope result;
 
 	/// The error object in case a request fails.
 	optional<ResponseError> error;
 
+	/// Writes the result instead of the writer of the capability, for the
+	/// results that aren't in an any.
+	optional<function<void(JsonWriter&)>> resultWriter;
+
 	ResponseMessage(Server& server,
 		variant<Number, String, Null> id,
 		any result);
 
+	ResponseMessage(Server& server,
+		variant<Number, String, Null> id,
+		function<void(JsonWriter&)> resultWriter);
+
 	ResponseMessage(Server& server,
 		variant<Number, String, Null> id,
 		ResponseError error);
@@ -35,7 +35,7 @@ using namespace std;
 struct SelectionRangeClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
 
 public:
 	/// Whether declaration supports dynamic registration. If this is set to
@@ -95,8 +95,8 @@ struct SelectionRangeParams:
 	public PartialResultParams
 {
 private:
-	const static String textDocumentKey;
-	const static String positionsKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key positionsKey    = "positions";
 
 	struct PositionsMaker: public ObjectT
 	{
@@ -157,8 +157,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String rangeKey;
-	const static String parentKey;
+	constexpr static Key rangeKey  = "range";
+	constexpr static Key parentKey = "parent";
 
 public:
 	/// The range of this selection range.
@@ -55,8 +55,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String typeKey;
-	const static String messageKey;
+	constexpr static Key typeKey    = "type";
+	constexpr static Key messageKey = "message";
 
 public:
 	/// The message type. See {@link MessageType}.
@@ -87,7 +87,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String titleKey;
+	constexpr static Key titleKey = "title";
 
 public:
 	/// A short title like 'Retry', 'Open Log' etc.
@@ -118,9 +118,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String typeKey;
-	const static String messageKey;
-	const static String actionsKey;
+	constexpr static Key typeKey    = "type";
+	constexpr static Key messageKey = "message";
+	constexpr static Key actionsKey = "actions";
 
 public:
 	/// The message type. See {@link MessageType}.
@@ -45,9 +45,9 @@ using namespace std;
 struct SignatureHelpClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String signatureInformationKey;
-	const static String contextSupportKey;
+	constexpr static Key dynamicRegistrationKey  = "dynamicRegistration";
+	constexpr static Key signatureInformationKey = "signatureInformation";
+	constexpr static Key contextSupportKey       = "contextSupport";
 
 public:
 	/// Whether signature help supports dynamic registration.
@@ -58,8 +58,8 @@ public:
 	struct SignatureInformation: public ObjectT
 	{
 	private:
-		const static String documentationFormatKey;
-		const static String parameterInformationKey;
+		constexpr static Key documentationFormatKey  = "documentationFormat";
+		constexpr static Key parameterInformationKey = "parameterInformation";
 
 		struct DocumentationFormatMaker: public ObjectT
 		{
@@ -89,7 +89,7 @@ public:
 		struct ParameterInformation: public ObjectT
 		{
 		private:
-			const static String labelOffsetSupportKey;
+			constexpr static Key labelOffsetSupportKey = "labelOffsetSupport";
 
 		public:
 			/// The client supports processing label offsets instead of a
@@ -184,8 +184,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String triggerCharactersKey;
-	const static String retriggerCharactersKey;
+	constexpr static Key triggerCharactersKey   = "triggerCharacters";
+	constexpr static Key retriggerCharactersKey = "retriggerCharacters";
 
 public:
 	/// The characters that trigger signature help
@@ -249,8 +249,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String labelKey;
-	const static String documentationKey;
+	constexpr static Key labelKey         = "label";
+	constexpr static Key documentationKey = "documentation";
 
 	struct LabelMaker: public ObjectT
 	{
@@ -328,9 +328,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String labelKey;
-	const static String documentationKey;
-	const static String parametersKey;
+	constexpr static Key labelKey         = "label";
+	constexpr static Key documentationKey = "documentation";
+	constexpr static Key parametersKey    = "parameters";
 
 	struct ParametersMaker: public ObjectT
 	{
@@ -400,9 +400,9 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String signaturesKey;
-	const static String activeSignatureKey;
-	const static String activeParameterKey;
+	constexpr static Key signaturesKey      = "signatures";
+	constexpr static Key activeSignatureKey = "activeSignature";
+	constexpr static Key activeParameterKey = "activeParameter";
 
 	struct SignaturesMaker: public ObjectT
 	{
@@ -497,10 +497,10 @@ enum class SignatureHelpTriggerKind
 struct SignatureHelpContext: public ObjectT
 {
 private:
-	const static String triggerKindKey;
-	const static String triggerCharacterKey;
-	const static String isRetriggerKey;
-	const static String activeSignatureHelpKey;
+	constexpr static Key triggerKindKey         = "triggerKind";
+	constexpr static Key triggerCharacterKey    = "triggerCharacter";
+	constexpr static Key isRetriggerKey         = "isRetrigger";
+	constexpr static Key activeSignatureHelpKey = "activeSignatureHelp";
 
 public:
 	/// Action that caused signature help to be triggered.
@@ -556,7 +556,7 @@ struct SignatureHelpParams:
 	public WorkDoneProgressParams
 {
 private:
-	const static String contextKey;
+	constexpr static Key contextKey = "context";
 
 public:
 	/// The signature help context. This is only available if the client
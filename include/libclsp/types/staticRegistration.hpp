@@ -38,7 +38,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String idKey;
+	constexpr static Key idKey = "id";
 
 public:
 	/// The id used to register the request. The id can be used to deregister
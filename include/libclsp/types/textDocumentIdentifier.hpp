@@ -34,7 +34,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String uriKey;
+	constexpr static Key uriKey = "uri";
 
 public:
 
@@ -70,7 +70,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String versionKey;
+	constexpr static Key versionKey = "version";
 
 public:
 
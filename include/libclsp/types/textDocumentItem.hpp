@@ -40,10 +40,10 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String uriKey;
-	const static String languageIdKey;
-	const static String versionKey;
-	const static String textKey;
+	constexpr static Key uriKey        = "uri";
+	constexpr static Key languageIdKey = "languageId";
+	constexpr static Key versionKey    = "version";
+	constexpr static Key textKey       = "text";
 
 public:
 
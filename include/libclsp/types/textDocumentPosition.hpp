@@ -34,8 +34,8 @@ using namespace std;
 struct TextDocumentPositionParams: public virtual ObjectT
 {
 private:
-	const static String textDocumentKey;
-	const static String positionKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key positionKey     = "position";
 
 public:
 	/// The text document.
@@ -34,7 +34,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String documentSelectorKey;
+	constexpr static Key documentSelectorKey = "documentSelector";
 
 public:
 	/// A document selector to identify the scope of the registration.
@@ -62,11 +62,11 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String openCloseKey;
-	const static String changeKey;
-	const static String willSaveKey;
-	const static String willSaveWaitUntilKey;
-	const static String saveKey;
+	constexpr static Key openCloseKey         = "openClose";
+	constexpr static Key changeKey            = "change";
+	constexpr static Key willSaveKey          = "willSave";
+	constexpr static Key willSaveWaitUntilKey = "willSaveWaitUntil";
+	constexpr static Key saveKey              = "save";
 
 public:
 	/// Open and close notifications are sent to the server. If omitted
@@ -116,10 +116,10 @@ public:
 struct TextDocumentSyncClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String willSaveKey;
-	const static String willSaveWaitUntilKey;
-	const static String didSaveKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key willSaveKey            = "willSave";
+	constexpr static Key willSaveWaitUntilKey   = "willSaveWaitUntil";
+	constexpr static Key didSaveKey             = "didSave";
 
 public:
 	/// Whether text document synchronization supports dynamic registration.
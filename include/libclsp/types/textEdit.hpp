@@ -40,8 +40,8 @@ protected:
 
 private:
 
-	const static String rangeKey;
-	const static String newTextKey;
+	constexpr static Key rangeKey   = "range";
+	constexpr static Key newTextKey = "newText";
 
 public:
 
@@ -84,8 +84,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String textDocumentKey;
-	const static String editsKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key editsKey        = "edits";
 
 	struct EditsMaker: public ObjectT
 	{
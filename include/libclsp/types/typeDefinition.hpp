@@ -36,8 +36,8 @@ using namespace std;
 struct TypeDefinitionClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String linkSupportKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key linkSupportKey         = "linkSupport";
 
 public:
 	/// Whether implementation supports dynamic registration. If this is set to
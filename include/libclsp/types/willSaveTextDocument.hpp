@@ -48,8 +48,8 @@ enum class TextDocumentSaveReason
 struct WillSaveTextDocumentParams: public ObjectT
 {
 private:
-	const static String textDocumentKey;
-	const static String reasonKey;
+	constexpr static Key textDocumentKey = "textDocument";
+	constexpr static Key reasonKey       = "reason";
 
 public:
 	/// The document that will be saved.
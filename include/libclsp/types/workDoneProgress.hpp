@@ -47,13 +47,13 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String titleKey;
-	const static String cancellableKey;
-	const static String messageKey;
-	const static String percentageKey;
+	constexpr static Key titleKey       = "title";
+	constexpr static Key cancellableKey = "cancellable";
+	constexpr static Key messageKey     = "message";
+	constexpr static Key percentageKey  = "percentage";
 
 public:
-	const static pair<String, String> kind;
+	constexpr static pair<Key, Key> kind = {"kind", "begin"};
 
 	/// Mandatory title of the progress operation. Used to briefly inform about
 	/// the kind of operation being performed.
@@ -121,12 +121,12 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String cancellableKey;
-	const static String messageKey;
-	const static String percentageKey;
+	constexpr static Key cancellableKey = "cancellable";
+	constexpr static Key messageKey     = "message";
+	constexpr static Key percentageKey  = "percentage";
 
 public:
-	const static pair<String, String> kind;
+	constexpr static pair<Key, Key> kind = {"kind", "report"};
 
 	/// Controls enablement state of a cancel button. This property is only valid if a cancel
 	/// button got requested in the `WorkDoneProgressStart` payload.
@@ -184,10 +184,10 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String messageKey;
+	constexpr static Key messageKey = "message";
 
 public:
-	const static pair<String, String> kind;
+	constexpr static pair<Key, Key> kind = {"kind", "end"};
 
 	/// Optional, a final message indicating to for example indicate
 	/// the outcome of the operation.
@@ -218,7 +218,7 @@ public:
 struct WorkDoneProgressParams: public virtual ObjectT
 {
 private:
-	const static String workDoneTokenKey;
+	constexpr static Key workDoneTokenKey = "workDoneToken";
 
 public:
 	/// An optional token that a server can use to report work done progress.
@@ -255,7 +255,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String workDoneProgressKey;
+	constexpr static Key workDoneProgressKey = "workDoneProgress";
 
 public:
 	optional<Boolean> workDoneProgress;
@@ -282,7 +282,7 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String tokenKey;
+	constexpr static Key tokenKey = "token";
 
 public:
 	/// The token to be used to report progress.
@@ -309,7 +309,7 @@ public:
 struct WorkDoneProgressCancelParams: public ObjectT
 {
 private:
-	const static String tokenKey;
+	constexpr static Key tokenKey = "token";
 
 public:
 	/// The token to be used to report progress.
@@ -348,8 +348,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String tokenKey;
-	const static String valueKey;
+	constexpr static Key tokenKey = "token";
+	constexpr static Key valueKey = "value";
 
 	struct ValueMaker: public ObjectT
 	{
@@ -43,8 +43,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String changesKey;
-	const static String documentChangesKey;
+	constexpr static Key changesKey         = "changes";
+	constexpr static Key documentChangesKey = "documentChanges";
 
 public:
 	/// Holds changes to existing resources.
@@ -218,9 +218,9 @@ public:
 struct WorkspaceEditClientCapabilities: public ObjectT
 {
 private:
-	const static String documentChangesKey;
-	const static String resourceOperationsKey;
-	const static String failureHandlingKey;
+	constexpr static Key documentChangesKey    = "documentChanges";
+	constexpr static Key resourceOperationsKey = "resourceOperations";
+	constexpr static Key failureHandlingKey    = "failureHandling";
 
 	struct ResourceOperationsMaker: public ObjectT
 	{
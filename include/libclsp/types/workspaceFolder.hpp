@@ -39,8 +39,8 @@ protected:
 	virtual void partialWrite(JsonWriter &writer);
 
 private:
-	const static String supportedKey;
-	const static String changeNotificationsKey;
+	constexpr static Key supportedKey           = "supported";
+	constexpr static Key changeNotificationsKey = "changeNotifications";
 
 public:
 	/// The server has support for workspace folders
@@ -74,8 +74,8 @@ public:
 struct WorkspaceFolder: public ObjectT
 {
 private:
-	const static String uriKey;
-	const static String nameKey;
+	constexpr static Key uriKey  = "uri";
+	constexpr static Key nameKey = "name";
 
 public:
 	/// The associated URI for this workspace folder.
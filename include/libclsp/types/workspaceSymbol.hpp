@@ -35,8 +35,8 @@ using namespace std;
 struct WorkspaceSymbolClientCapabilities: public ObjectT
 {
 private:
-	const static String dynamicRegistrationKey;
-	const static String symbolKindKey;
+	constexpr static Key dynamicRegistrationKey = "dynamicRegistration";
+	constexpr static Key symbolKindKey          = "symbolKind";
 
 public:
 	/// Whether declaration supports dynamic registration. If this is set to
@@ -49,7 +49,7 @@ public:
 	struct SymbolKind: public ObjectT
 	{
 	private:
-		const static String valueSetKey;
+		constexpr static Key valueSetKey = "valueSet";
 
 		struct ValueSetMaker: public ObjectT
 		{
@@ -139,7 +139,7 @@ struct WorkspaceSymbolParams:
 	public PartialResultParams
 {
 private:
-	const static String queryKey;
+	constexpr static Key queryKey = "query";
 
 public:
 	/// A query string to filter symbols by. Clients may send an empty
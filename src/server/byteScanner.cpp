@@ -0,0 +1,566 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/byteScanner.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#define CLSP_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CLSP_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace clsp
+{
+
+using namespace std;
+
+//========================   Plain C++   ===================================//
+
+/// Checks the sequence that starts at p and returns the byte after it, or
+/// nullptr if it isn't valid.
+static const uint8_t* nextCodePoint(const uint8_t* p, const uint8_t* last)
+{
+	uint8_t lead = *p;
+
+	if(lead < 0x80)
+	{
+		return p + 1;
+	}
+
+	size_t continuations;
+
+	// The range of the second byte
+	uint8_t low  = 0x80;
+	uint8_t high = 0xBF;
+
+	if(lead >= 0xC2 && lead <= 0xDF)
+	{
+		continuations = 1;
+	}
+	else if(lead >= 0xE0 && lead <= 0xEF)
+	{
+		continuations = 2;
+
+		if(lead == 0xE0) // Overlong
+		{
+			low = 0xA0;
+		}
+		else if(lead == 0xED) // Surrogates
+		{
+			high = 0x9F;
+		}
+	}
+	else if(lead >= 0xF0 && lead <= 0xF4)
+	{
+		continuations = 3;
+
+		if(lead == 0xF0) // Overlong
+		{
+			low = 0x90;
+		}
+		else if(lead == 0xF4) // Above U+10FFFF
+		{
+			high = 0x8F;
+		}
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	if((size_t)(last - p) <= continuations || p[1] < low || p[1] > high)
+	{
+		return nullptr;
+	}
+
+	for(size_t i = 2; i <= continuations; i++)
+	{
+		if((p[i] & 0xC0) != 0x80)
+		{
+			return nullptr;
+		}
+	}
+
+	return p + continuations + 1;
+}
+
+/// Validates the bytes skipping the ASCII blocks found by isAscii.
+template<size_t blockSize, class IsAscii>
+static bool validateAsciiBlocks(const uint8_t* p, const uint8_t* last,
+	IsAscii isAscii)
+{
+	while(p < last)
+	{
+		while((size_t)(last - p) >= blockSize && isAscii(p))
+		{
+			p += blockSize;
+		}
+
+		const uint8_t* blockLast = min(p + blockSize, last);
+
+		while(p < blockLast)
+		{
+			p = nextCodePoint(p, last);
+
+			if(p == nullptr)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static const char* findHeaderEndScalar(const char* first, const char* last)
+{
+	const char headerEnd[] = "\r\n\r\n";
+
+	return search(first, last, headerEnd, headerEnd + 4);
+}
+
+#if defined(CLSP_X86)
+
+//========================   SSE2   ========================================//
+
+static const char* findHeaderEndSse2(const char* first, const char* last)
+{
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i lf = _mm_set1_epi8('\n');
+
+	// Each lane is the start of a candidate
+	while(last - first >= 16 + 3)
+	{
+		__m128i match = _mm_and_si128(
+			_mm_and_si128(
+				_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)first), cr),
+				_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(first + 1)), lf)),
+			_mm_and_si128(
+				_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(first + 2)), cr),
+				_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(first + 3)), lf)));
+
+		int mask = _mm_movemask_epi8(match);
+
+		if(mask != 0)
+		{
+			return first + __builtin_ctz(mask);
+		}
+
+		first += 16;
+	}
+
+	return findHeaderEndScalar(first, last);
+}
+
+static bool isValidUtf8Sse2(const uint8_t* p, const uint8_t* last)
+{
+	return validateAsciiBlocks<16>(p, last, [](const uint8_t* block)
+	{
+		return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)block)) == 0;
+	});
+}
+
+//========================   AVX2   ========================================//
+
+// The lookup algorithm of "Validating UTF-8 In Less Than One Instruction Per
+// Byte" (Keiser, Lemire 2021). Each pair of bytes is classified with three
+// table lookups (the high nibble of the first byte, its low nibble and the
+// high nibble of the second byte) and the results are intersected, any bit
+// left is an error. The 3 and 4 bytes sequences are checked apart.
+
+// The error classes
+constexpr static uint8_t tooShort     = 1<<0; // 11______ 0_______
+                                              // 11______ 11______
+constexpr static uint8_t tooLong      = 1<<1; // 0_______ 10______
+constexpr static uint8_t overlong3    = 1<<2; // 11100000 100_____
+constexpr static uint8_t tooLarge     = 1<<3; // 11110100 1001____
+                                              // 11110100 101_____
+                                              // 11110101 1001____
+                                              // 11110101 101_____
+                                              // 1111011_ 1001____
+                                              // 1111011_ 101_____
+                                              // 11111___ 1001____
+                                              // 11111___ 101_____
+constexpr static uint8_t surrogate    = 1<<4; // 11101101 101_____
+constexpr static uint8_t overlong2    = 1<<5; // 1100000_ 10______
+constexpr static uint8_t tooLarge1000 = 1<<6; // 11110101 1000____
+                                              // 1111011_ 1000____
+                                              // 11111___ 1000____
+constexpr static uint8_t overlong4    = 1<<6; // 11110000 1000____
+constexpr static uint8_t twoConts     = 1<<7; // 10______ 10______
+
+// The classes where the low nibble of the first byte doesn't matter
+constexpr static uint8_t carry = tooShort | tooLong | twoConts;
+
+// The helpers are always inlined, the vectors can't go through the stack.
+
+#define CLSP_TABLE(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+/// The bytes of the previous block shifted into this one by n bytes.
+#define CLSP_PREVIOUS(input, previous, n) _mm256_alignr_epi8(input, \
+	_mm256_permute2x128_si256(previous, input, 0x21), 16 - (n))
+
+__attribute__((target("avx2"), always_inline))
+inline static __m256i highNibble(__m256i bytes)
+{
+	return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+__attribute__((target("avx2"), always_inline))
+inline static __m256i checkSpecialCases(__m256i input, __m256i previous1)
+{
+	const __m256i byte1HighTable = CLSP_TABLE(
+		// 0_______ ________
+		tooLong, tooLong, tooLong, tooLong,
+		tooLong, tooLong, tooLong, tooLong,
+		// 10______ ________
+		twoConts, twoConts, twoConts, twoConts,
+		// 1100____ ________
+		tooShort | overlong2,
+		// 1101____ ________
+		tooShort,
+		// 1110____ ________
+		tooShort | overlong3 | surrogate,
+		// 1111____ ________
+		tooShort | tooLarge | tooLarge1000 | overlong4);
+
+	const __m256i byte1LowTable = CLSP_TABLE(
+		// ____0000 ________
+		carry | overlong3 | overlong2 | overlong4,
+		// ____0001 ________
+		carry | overlong2,
+		// ____001_ ________
+		carry,
+		carry,
+		// ____0100 ________
+		carry | tooLarge,
+		// ____0101 ________
+		carry | tooLarge | tooLarge1000,
+		// ____011_ ________
+		carry | tooLarge | tooLarge1000,
+		carry | tooLarge | tooLarge1000,
+		// ____1___ ________
+		carry | tooLarge | tooLarge1000,
+		carry | tooLarge | tooLarge1000,
+		carry | tooLarge | tooLarge1000,
+		carry | tooLarge | tooLarge1000,
+		carry | tooLarge | tooLarge1000,
+		// ____1101 ________
+		carry | tooLarge | tooLarge1000 | surrogate,
+		carry | tooLarge | tooLarge1000,
+		carry | tooLarge | tooLarge1000);
+
+	const __m256i byte2HighTable = CLSP_TABLE(
+		// ________ 0_______
+		tooShort, tooShort, tooShort, tooShort,
+		tooShort, tooShort, tooShort, tooShort,
+		// ________ 1000____
+		tooLong | overlong2 | twoConts | overlong3 | tooLarge1000 | overlong4,
+		// ________ 1001____
+		tooLong | overlong2 | twoConts | overlong3 | tooLarge,
+		// ________ 101_____
+		tooLong | overlong2 | twoConts | surrogate | tooLarge,
+		tooLong | overlong2 | twoConts | surrogate | tooLarge,
+		// ________ 11______
+		tooShort, tooShort, tooShort, tooShort);
+
+	__m256i byte1High = _mm256_shuffle_epi8(byte1HighTable,
+		highNibble(previous1));
+	__m256i byte1Low  = _mm256_shuffle_epi8(byte1LowTable,
+		_mm256_and_si256(previous1, _mm256_set1_epi8(0x0F)));
+	__m256i byte2High = _mm256_shuffle_epi8(byte2HighTable,
+		highNibble(input));
+
+	return _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+}
+
+__attribute__((target("avx2"), always_inline))
+inline static __m256i checkBlock(__m256i input, __m256i previous)
+{
+	__m256i previous1 = CLSP_PREVIOUS(input, previous, 1);
+	__m256i previous2 = CLSP_PREVIOUS(input, previous, 2);
+	__m256i previous3 = CLSP_PREVIOUS(input, previous, 3);
+
+	__m256i special = checkSpecialCases(input, previous1);
+
+	// The bytes 2 and 3 after a 3 or 4 bytes lead must be continuations,
+	// that's the only case where twoConts isn't an error.
+	__m256i must23 = _mm256_or_si256(
+		_mm256_subs_epu8(previous2, _mm256_set1_epi8((char)(0xE0 - 0x80))),
+		_mm256_subs_epu8(previous3, _mm256_set1_epi8((char)(0xF0 - 0x80))));
+
+	__m256i must23Cont = _mm256_and_si256(must23, _mm256_set1_epi8((char)0x80));
+
+	return _mm256_xor_si256(must23Cont, special);
+}
+
+/// The lead bytes at the end of a block that need more bytes
+__attribute__((target("avx2"), always_inline))
+inline static __m256i isIncomplete(__m256i input)
+{
+	const __m256i maxValue = _mm256_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1,
+		(char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+
+	return _mm256_subs_epu8(input, maxValue);
+}
+
+/// Checks the next block, the previous one is needed for the sequences
+/// between both.
+__attribute__((target("avx2"), always_inline))
+inline static void step(__m256i input, __m256i& previous, __m256i& incomplete,
+	__m256i& error)
+{
+	if(_mm256_movemask_epi8(input) == 0)
+	{
+		// An ASCII block can't finish a sequence
+		error = _mm256_or_si256(error, incomplete);
+	}
+	else
+	{
+		error = _mm256_or_si256(error, checkBlock(input, previous));
+		incomplete = isIncomplete(input);
+	}
+
+	previous = input;
+}
+
+__attribute__((target("avx2")))
+static bool isValidUtf8Avx2(const uint8_t* p, const uint8_t* last)
+{
+	__m256i error      = _mm256_setzero_si256();
+	__m256i previous   = _mm256_setzero_si256();
+	__m256i incomplete = _mm256_setzero_si256();
+
+	for(; last - p >= 32; p += 32)
+	{
+		step(_mm256_loadu_si256((const __m256i*)p), previous, incomplete,
+			error);
+	}
+
+	if(p < last)
+	{
+		// The padding is ASCII, so a truncated sequence is an error.
+		alignas(32) uint8_t tail[32] = {};
+
+		memcpy(tail, p, last - p);
+
+		step(_mm256_load_si256((const __m256i*)tail), previous, incomplete,
+			error);
+	}
+
+	error = _mm256_or_si256(error, incomplete);
+
+	return _mm256_testz_si256(error, error);
+}
+
+#undef CLSP_TABLE
+#undef CLSP_PREVIOUS
+
+static bool hasAvx2()
+{
+	static const bool resu = __builtin_cpu_supports("avx2");
+
+	return resu;
+}
+
+#elif defined(CLSP_NEON)
+
+//========================   NEON   ========================================//
+
+static const char* findHeaderEndNeon(const char* first, const char* last)
+{
+	const uint8x16_t cr = vdupq_n_u8('\r');
+	const uint8x16_t lf = vdupq_n_u8('\n');
+
+	while(last - first >= 16 + 3)
+	{
+		const uint8_t* p = (const uint8_t*)first;
+
+		uint8x16_t match = vandq_u8(
+			vandq_u8(vceqq_u8(vld1q_u8(p), cr), vceqq_u8(vld1q_u8(p + 1), lf)),
+			vandq_u8(vceqq_u8(vld1q_u8(p + 2), cr), vceqq_u8(vld1q_u8(p + 3), lf)));
+
+		if(vmaxvq_u8(match) != 0)
+		{
+			return findHeaderEndScalar(first, first + 16 + 3);
+		}
+
+		first += 16;
+	}
+
+	return findHeaderEndScalar(first, last);
+}
+
+static bool isValidUtf8Neon(const uint8_t* p, const uint8_t* last)
+{
+	return validateAsciiBlocks<16>(p, last, [](const uint8_t* block)
+	{
+		return vmaxvq_u8(vld1q_u8(block)) < 0x80;
+	});
+}
+
+#endif
+
+//==========================================================================//
+
+static bool isValidUtf8Scalar(const uint8_t* p, const uint8_t* last)
+{
+	return validateAsciiBlocks<sizeof(uint64_t)>(p, last,
+		[](const uint8_t* block)
+		{
+			uint64_t word;
+			memcpy(&word, block, sizeof(word));
+
+			return (word & 0x8080808080808080) == 0;
+		});
+}
+
+bool ByteScanner::isSupported(Isa isa)
+{
+	switch(isa)
+	{
+		case Isa::scalar:
+			return true;
+
+#if defined(CLSP_X86)
+		case Isa::sse2:
+			return true;
+
+		case Isa::avx2:
+			return hasAvx2();
+#elif defined(CLSP_NEON)
+		case Isa::neon:
+			return true;
+#endif
+
+		default:
+			return false;
+	}
+}
+
+ByteScanner::Isa ByteScanner::bestIsa()
+{
+#if defined(CLSP_X86)
+	return hasAvx2()? Isa::avx2: Isa::sse2;
+#elif defined(CLSP_NEON)
+	return Isa::neon;
+#else
+	return Isa::scalar;
+#endif
+}
+
+const char* ByteScanner::findHeaderEnd(const char* first, const char* last)
+{
+	return findHeaderEnd(first, last, bestIsa());
+}
+
+const char* ByteScanner::findHeaderEnd(const char* first, const char* last,
+	Isa isa)
+{
+	switch(isa)
+	{
+#if defined(CLSP_X86)
+		// There's no AVX2 search, the headers are short
+		case Isa::sse2:
+		case Isa::avx2:
+			return findHeaderEndSse2(first, last);
+#elif defined(CLSP_NEON)
+		case Isa::neon:
+			return findHeaderEndNeon(first, last);
+#endif
+
+		default:
+			return findHeaderEndScalar(first, last);
+	}
+}
+
+bool ByteScanner::isValidUtf8(const char* data, size_t size)
+{
+	return isValidUtf8(data, size, bestIsa());
+}
+
+bool ByteScanner::isValidUtf8(const char* data, size_t size, Isa isa)
+{
+	const uint8_t* first = (const uint8_t*)data;
+	const uint8_t* last  = first + size;
+
+	switch(isa)
+	{
+#if defined(CLSP_X86)
+		case Isa::sse2:
+			return isValidUtf8Sse2(first, last);
+
+		case Isa::avx2:
+			return isValidUtf8Avx2(first, last);
+#elif defined(CLSP_NEON)
+		case Isa::neon:
+			return isValidUtf8Neon(first, last);
+#endif
+
+		default:
+			return isValidUtf8Scalar(first, last);
+	}
+}
+
+const char* ByteScanner::findValueEnd(const char* first, const char* last)
+{
+	size_t depth = 0;
+	bool inString = false;
+
+	for(; first < last; first++)
+	{
+		char c = *first;
+
+		if(inString)
+		{
+			// The escaped quotes don't end the string
+			if(c == '\\' && first + 1 < last)
+			{
+				first++;
+			}
+			else if(c == '"')
+			{
+				inString = false;
+			}
+		}
+		else if(c == '"')
+		{
+			inString = true;
+		}
+		else if(c == '{' || c == '[')
+		{
+			depth++;
+		}
+		else if((c == '}' || c == ']') && --depth == 0)
+		{
+			return first + 1;
+		}
+	}
+
+	return last;
+}
+
+}
@@ -0,0 +1,185 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/cancellationToken.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+struct CancellationToken::Flag
+{
+	atomic<State> state;
+
+	/// The tokens that share it
+	atomic<size_t> references;
+
+	/// The next free flag of the thread
+	Flag* next;
+};
+
+/// The longest list of free flags kept by a thread
+constexpr static size_t maxFreeFlags = 256;
+
+// Plain pointers, so they can still be used while the thread ends
+thread_local CancellationToken::Flag* CancellationToken::freeFlags = nullptr;
+thread_local size_t CancellationToken::freeFlagCount = 0;
+
+/// The flags freed after the thread ends are deleted at once.
+struct CancellationToken::FreeFlagsCleaner
+{
+	~FreeFlagsCleaner()
+	{
+		while(freeFlags != nullptr)
+		{
+			auto* next = freeFlags->next;
+
+			delete freeFlags;
+			freeFlags = next;
+		}
+
+		freeFlagCount = maxFreeFlags;
+	}
+};
+
+CancellationToken::Flag* CancellationToken::acquire()
+{
+	Flag* flag = freeFlags;
+
+	if(flag != nullptr)
+	{
+		freeFlags = flag->next;
+		freeFlagCount--;
+	}
+	else
+	{
+		flag = new Flag;
+	}
+
+	flag->state.store(State::active, memory_order_relaxed);
+	flag->references.store(1, memory_order_relaxed);
+
+	return flag;
+}
+
+void CancellationToken::release(Flag* flag)
+{
+	if(flag == nullptr ||
+		flag->references.fetch_sub(1, memory_order_acq_rel) != 1)
+	{
+		return;
+	}
+
+	// Made by the first flag kept, it deletes them
+	static thread_local FreeFlagsCleaner cleaner;
+
+	if(freeFlagCount < maxFreeFlags)
+	{
+		flag->next = freeFlags;
+		freeFlags = flag;
+		freeFlagCount++;
+	}
+	else
+	{
+		delete flag;
+	}
+}
+
+CancellationToken::CancellationToken():
+	flag(acquire())
+{};
+
+CancellationToken::CancellationToken(nullptr_t){};
+
+CancellationToken::CancellationToken(const CancellationToken& other):
+	flag(other.flag)
+{
+	if(flag != nullptr)
+	{
+		flag->references.fetch_add(1, memory_order_relaxed);
+	}
+};
+
+CancellationToken::CancellationToken(CancellationToken&& other):
+	flag(other.flag)
+{
+	other.flag = nullptr;
+};
+
+CancellationToken& CancellationToken::operator=(const CancellationToken& other)
+{
+	if(other.flag != nullptr)
+	{
+		other.flag->references.fetch_add(1, memory_order_relaxed);
+	}
+
+	release(flag);
+	flag = other.flag;
+
+	return *this;
+}
+
+CancellationToken& CancellationToken::operator=(CancellationToken&& other)
+{
+	if(this != &other)
+	{
+		release(flag);
+
+		flag = other.flag;
+		other.flag = nullptr;
+	}
+
+	return *this;
+}
+
+CancellationToken::~CancellationToken()
+{
+	release(flag);
+};
+
+bool CancellationToken::isCancelled() const
+{
+	return flag != nullptr &&
+		flag->state.load(memory_order_relaxed) != State::active;
+}
+
+bool CancellationToken::isExpired() const
+{
+	return flag != nullptr &&
+		flag->state.load(memory_order_relaxed) == State::expired;
+}
+
+void CancellationToken::cancel()
+{
+	if(flag != nullptr)
+	{
+		flag->state.store(State::cancelled, memory_order_relaxed);
+	}
+}
+
+void CancellationToken::expire()
+{
+	State active = State::active;
+
+	if(flag != nullptr)
+	{
+		flag->state.compare_exchange_strong(active, State::expired,
+			memory_order_relaxed);
+	}
+}
+
+}
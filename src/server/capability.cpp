@@ -23,41 +23,29 @@ namespace clsp
 
 using namespace std;
 
-Capability::Capability(String method, JsonIO params, optional<JsonIO> result):
-	method(method),
-	params(params),
-	result(result)
-{};
-
-Capability::~Capability(){};
-
-
-Capability::JsonIO::JsonIO(optional<function<void(JsonWriter&, any&)>> writer,
-	optional<function<ValueSetter(JsonHandler&, optional<any>&)>> reader):
-		writer(writer),
-		reader(reader)
-{};
-
-Capability::JsonIO::~JsonIO(){};
-
+// The params of the requests on a position are parsed in the envelope
+static_assert(Envelope::isInline<HoverParams>);
+static_assert(Envelope::isInline<DefinitionParams>);
+static_assert(Envelope::isInline<ReferenceParams>);
+static_assert(Envelope::isInline<CompletionParams>);
 
 // Cancellation Support
-const Capability Capability::cancelRequest = {
+constexpr Capability Capability::cancelRequest = {
 	// Method
 	"$/cancelRequest",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<CancelParams&>(data));
+			writer.Object(data.get<CancelParams>());
 		},
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<CancelParams>();
+			auto& params = data.emplace<CancelParams>();
 
 			return ValueSetter{
 				// String
@@ -89,22 +77,22 @@ const Capability Capability::cancelRequest = {
 	nullopt
 };
 
-const Capability Capability::progress = {
+constexpr Capability Capability::progress = {
 	// Method
 	"$/progress",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<ProgressParams&>(data));
+			writer.Object(data.get<ProgressParams>());
 		},
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<ProgressParams>();
+			auto& params = data.emplace<ProgressParams>();
 
 			return ValueSetter{
 				// String
@@ -136,19 +124,19 @@ const Capability Capability::progress = {
 	nullopt
 };
 
-const Capability Capability::initialize = {
+constexpr Capability Capability::initialize = {
 	// Method
 	"initialize",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<InitializeParams>();
+			auto& params = data.emplace<InitializeParams>();
 
 			return ValueSetter{
 				// String
@@ -179,29 +167,29 @@ const Capability Capability::initialize = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<InitializeResult&>(data));
+			writer.Object(data.get<InitializeResult>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	}}
 };
 
-const Capability Capability::initialized = {
+constexpr Capability Capability::initialized = {
 	// Method
 	"initialized",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<InitializedParams>();
+			auto& params = data.emplace<InitializedParams>();
 
 			return ValueSetter{
 				// String
@@ -233,19 +221,19 @@ const Capability Capability::initialized = {
 	nullopt
 };
 
-const Capability Capability::shutdown = {
+constexpr Capability Capability::shutdown = {
 	// Method
 	"shutdown",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler&, optional<any>& data)
+		[](JsonHandler&, Envelope& data)
 		{
-			data = nullopt;
+			data.reset();
 
 			return ValueSetter();
 		}
@@ -254,29 +242,29 @@ const Capability Capability::shutdown = {
 	// Response
 	{{
 		// Reader
-		[](JsonWriter& writer, any&)
+		[](JsonWriter& writer, Envelope&)
 		{
 			writer.Null();
 		},
 
 		// Writer
-		nullopt
+		nullptr
 	}}
 };
 
-const Capability Capability::exit = {
+constexpr Capability Capability::exit = {
 	// Method
 	"exit",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler&, optional<any>& data)
+		[](JsonHandler&, Envelope& data)
 		{
-			data = nullopt;
+			data.reset();
 
 			return ValueSetter();
 		}
@@ -286,51 +274,51 @@ const Capability Capability::exit = {
 	nullopt
 };
 
-const Capability Capability::windowShowMessage = {
+constexpr Capability Capability::windowShowMessage = {
 	// Method
 	"window/showMessage",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<ShowMessageParams&>(data));
+			writer.Object(data.get<ShowMessageParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	nullopt
 };
 
-const Capability Capability::windowShowMessageRequest = {
+constexpr Capability Capability::windowShowMessageRequest = {
 	// Method
 	"window/showMessageRequest",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<ShowMessageRequestParams&>(data));
+			writer.Object(data.get<ShowMessageRequestParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	{{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<variant<MessageActionItem, Null>>();
+			auto& params = data.emplace<variant<MessageActionItem, Null>>();
 
 			return ValueSetter{
 				// String
@@ -364,70 +352,70 @@ const Capability Capability::windowShowMessageRequest = {
 	}}
 };
 
-const Capability Capability::windowLogMessage = {
+constexpr Capability Capability::windowLogMessage = {
 	// Method
 	"window/logMessage",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<LogMessageParams&>(data));
+			writer.Object(data.get<LogMessageParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	nullopt
 };
 
-const Capability Capability::windowWorkDoneProgressCreate = {
+constexpr Capability Capability::windowWorkDoneProgressCreate = {
 	// Method
 	"window/workDoneProgress/create",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<WorkDoneProgressCreateParams&>(data));
+			writer.Object(data.get<WorkDoneProgressCreateParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	{{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler&, optional<any>& data)
+		[](JsonHandler&, Envelope& data)
 		{
-			data = nullopt;
+			data.reset();
 
 			return ValueSetter();
 		}
 	}}
 };
 
-const Capability Capability::windowWorkDoneProgressCancel = {
+constexpr Capability Capability::windowWorkDoneProgressCancel = {
 	// Method
 	"window/workDoneProgress/cancel",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<WorkDoneProgressCancelParams>();
+			auto& params = data.emplace<WorkDoneProgressCancelParams>();
 
 			return ValueSetter{
 				// String
@@ -459,82 +447,82 @@ const Capability Capability::windowWorkDoneProgressCancel = {
 	nullopt
 };
 
-const Capability Capability::telemetryEvent = {
+constexpr Capability Capability::telemetryEvent = {
 	// Method
 	"telemetry/event",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Any(any_cast<Any&>(data));
+			writer.Any(data.get<Any>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	nullopt
 };
 
-const Capability Capability::clientRegisterCapability = {
+constexpr Capability Capability::clientRegisterCapability = {
 	// Method
 	"client/registerCapability",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<RegistrationParams&>(data));
+			writer.Object(data.get<RegistrationParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	{{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler&, optional<any>& data)
+		[](JsonHandler&, Envelope& data)
 		{
-			data = nullopt;
+			data.reset();
 
 			return ValueSetter();
 		}
 	}}
 };
 
-const Capability Capability::clientUnregisterCapability = {
+constexpr Capability Capability::clientUnregisterCapability = {
 	// Method
 	"client/unregisterCapability",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<UnregistrationParams&>(data));
+			writer.Object(data.get<UnregistrationParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	{{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler&, optional<any>& data)
+		[](JsonHandler&, Envelope& data)
 		{
-			data = nullopt;
+			data.reset();
 
 			return ValueSetter();
 		}
@@ -542,28 +530,28 @@ const Capability Capability::clientUnregisterCapability = {
 };
 
 
-const Capability Capability::workspaceWorkspaceFolders = {
+constexpr Capability Capability::workspaceWorkspaceFolders = {
 	// Method
 	"workspace/workspaceFolders",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	{{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<variant<vector<WorkspaceFolder>, Null>>();
+			auto& params = data.emplace<variant<vector<WorkspaceFolder>, Null>>();
 
 			return ValueSetter{
 				// String
@@ -598,19 +586,19 @@ const Capability Capability::workspaceWorkspaceFolders = {
 	}}
 };
 
-const Capability Capability::workspaceDidChangeWorkspaceFolders = {
+constexpr Capability Capability::workspaceDidChangeWorkspaceFolders = {
 	// Method
 	"workspace/didChangeWorkspaceFolders",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DidChangeWorkspaceFoldersParams>();
+			auto& params = data.emplace<DidChangeWorkspaceFoldersParams>();
 
 			return ValueSetter{
 				// String
@@ -642,19 +630,19 @@ const Capability Capability::workspaceDidChangeWorkspaceFolders = {
 	nullopt
 };
 
-const Capability Capability::workspaceDidChangeConfiguration = {
+constexpr Capability Capability::workspaceDidChangeConfiguration = {
 	// Method
 	"workspace/didChangeConfiguration’",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DidChangeConfigurationParams>();
+			auto& params = data.emplace<DidChangeConfigurationParams>();
 
 			return ValueSetter{
 				// String
@@ -686,31 +674,31 @@ const Capability Capability::workspaceDidChangeConfiguration = {
 	nullopt
 };
 
-const Capability Capability::workspaceConfiguration = {
+constexpr Capability Capability::workspaceConfiguration = {
 	// Method
 	"workspace/configuration",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<ConfigurationParams&>(data));
+			writer.Object(data.get<ConfigurationParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	{{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<Array>();
+			auto& params = data.emplace<Array>();
 
 			return ValueSetter{
 				// String
@@ -741,19 +729,19 @@ const Capability Capability::workspaceConfiguration = {
 	}}
 };
 
-const Capability Capability::workspaceDidChangeWatchedFiles = {
+constexpr Capability Capability::workspaceDidChangeWatchedFiles = {
 	// Method
 	"workspace/didChangeWatchedFiles",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DidChangeWatchedFilesParams>();
+			auto& params = data.emplace<DidChangeWatchedFilesParams>();
 
 			return ValueSetter{
 				// String
@@ -785,19 +773,19 @@ const Capability Capability::workspaceDidChangeWatchedFiles = {
 	nullopt
 };
 
-const Capability Capability::workspaceSymbol = {
+constexpr Capability Capability::workspaceSymbol = {
 	// Method
 	"workspace/symbol",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<WorkspaceSymbolParams>();
+			auto& params = data.emplace<WorkspaceSymbolParams>();
 
 			return ValueSetter{
 				// String
@@ -828,7 +816,7 @@ const Capability Capability::workspaceSymbol = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<SymbolInformation>& vec)
@@ -844,27 +832,39 @@ const Capability Capability::workspaceSymbol = {
 				{
 					writer.Null();
 				}
-			),any_cast<variant<vector<SymbolInformation>, Null>&>(data));
+			),data.get<variant<vector<SymbolInformation>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	nullptr,
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<WorkspaceSymbolParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::background
 };
 
-const Capability Capability::workspaceExecuteCommand = {
+constexpr Capability Capability::workspaceExecuteCommand = {
 	// Method
 	"workspace/executeCommand",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<ExecuteCommandParams>();
+			auto& params = data.emplace<ExecuteCommandParams>();
 
 			return ValueSetter{
 				// String
@@ -895,7 +895,7 @@ const Capability Capability::workspaceExecuteCommand = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](Any& anyResponse)
@@ -906,39 +906,48 @@ const Capability Capability::workspaceExecuteCommand = {
 				{
 					writer.Null();
 				}
-			),any_cast<variant<Any, Null>&>(data));
+			),data.get<variant<Any, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	nullptr,
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<ExecuteCommandParams>().workDoneToken;
+	}
 };
 
-const Capability Capability::workspaceApplyEdit = {
+constexpr Capability Capability::workspaceApplyEdit = {
 	// Method
 	"workspace/applyEdit",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<ApplyWorkspaceEditParams&>(data));
+			writer.Object(data.get<ApplyWorkspaceEditParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	{{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<ApplyWorkspaceEditResponse>();
+			auto& params = data.emplace<ApplyWorkspaceEditResponse>();
 
 			return ValueSetter{
 				// String
@@ -968,19 +977,19 @@ const Capability Capability::workspaceApplyEdit = {
 	}}
 };
 
-const Capability Capability::textDocumentDidOpen = {
+constexpr Capability Capability::textDocumentDidOpen = {
 	// Method
 	"textDocument/didOpen",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DidOpenTextDocumentParams>();
+			auto& params = data.emplace<DidOpenTextDocumentParams>();
 
 			return ValueSetter{
 				// String
@@ -1009,22 +1018,28 @@ const Capability Capability::textDocumentDidOpen = {
 	},
 
 	// Response
-	nullopt
+	nullopt,
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DidOpenTextDocumentParams>().textDocument.uri;
+	}
 };
 
-const Capability Capability::textDocumentDidChange = {
+constexpr Capability Capability::textDocumentDidChange = {
 	// Method
 	"textDocument/didChange",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DidChangeTextDocumentParams>();
+			auto& params = data.emplace<DidChangeTextDocumentParams>();
 
 			return ValueSetter{
 				// String
@@ -1053,22 +1068,28 @@ const Capability Capability::textDocumentDidChange = {
 	},
 
 	// Response
-	nullopt
+	nullopt,
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DidChangeTextDocumentParams>().textDocument.uri;
+	}
 };
 
-const Capability Capability::textDocumentWillSave = {
+constexpr Capability Capability::textDocumentWillSave = {
 	// Method
 	"textDocument/willSave",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<WillSaveTextDocumentParams>();
+			auto& params = data.emplace<WillSaveTextDocumentParams>();
 
 			return ValueSetter{
 				// String
@@ -1097,22 +1118,28 @@ const Capability Capability::textDocumentWillSave = {
 	},
 
 	// Response
-	nullopt
+	nullopt,
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<WillSaveTextDocumentParams>().textDocument.uri;
+	}
 };
 
-const Capability Capability::textDocumentWillSaveWaitUntil = {
+constexpr Capability Capability::textDocumentWillSaveWaitUntil = {
 	// Method
 	"textDocument/willSaveWaitUntil",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<WillSaveTextDocumentParams>();
+			auto& params = data.emplace<WillSaveTextDocumentParams>();
 
 			return ValueSetter{
 				// String
@@ -1143,7 +1170,7 @@ const Capability Capability::textDocumentWillSaveWaitUntil = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<TextEdit>& vec)
@@ -1159,27 +1186,33 @@ const Capability Capability::textDocumentWillSaveWaitUntil = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<TextEdit>, Null>&>(data));
+			), data.get<variant<vector<TextEdit>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<WillSaveTextDocumentParams>().textDocument.uri;
+	}
 };
 
-const Capability Capability::textDocumentDidSave = {
+constexpr Capability Capability::textDocumentDidSave = {
 	// Method
 	"textDocument/didSave",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DidSaveTextDocumentParams>();
+			auto& params = data.emplace<DidSaveTextDocumentParams>();
 
 			return ValueSetter{
 				// String
@@ -1208,22 +1241,28 @@ const Capability Capability::textDocumentDidSave = {
 	},
 
 	// Response
-	nullopt
+	nullopt,
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DidSaveTextDocumentParams>().textDocument.uri;
+	}
 };
 
-const Capability Capability::textDocumentDidClose = {
+constexpr Capability Capability::textDocumentDidClose = {
 	// Method
 	"textDocument/didClose",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DidCloseTextDocumentParams>();
+			auto& params = data.emplace<DidCloseTextDocumentParams>();
 
 			return ValueSetter{
 				// String
@@ -1252,42 +1291,48 @@ const Capability Capability::textDocumentDidClose = {
 	},
 
 	// Response
-	nullopt
+	nullopt,
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DidCloseTextDocumentParams>().textDocument.uri;
+	}
 };
 
-const Capability Capability::textDocumentPublishDiagnostics = {
+constexpr Capability Capability::textDocumentPublishDiagnostics = {
 	// Method
 	"textDocument/publishDiagnostics",
 
 	// Request
 	{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<PublishDiagnosticsParams&>(data));
+			writer.Object(data.get<PublishDiagnosticsParams>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	},
 
 	// Response
 	nullopt
 };
 
-const Capability Capability::textDocumentCompletion = {
+constexpr Capability Capability::textDocumentCompletion = {
 	// Method
 	"textDocument/completion",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<CompletionParams>();
+			auto& params = data.emplace<CompletionParams>();
 
 			return ValueSetter{
 				// String
@@ -1318,7 +1363,7 @@ const Capability Capability::textDocumentCompletion = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<CompletionItem>& vec)
@@ -1338,27 +1383,56 @@ const Capability Capability::textDocumentCompletion = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<CompletionItem>, CompletionList, Null>&>(data));
+			), data.get<variant<vector<CompletionItem>, CompletionList, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<CompletionParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<CompletionParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::interactive,
+
+	// Superseded
+	true,
+
+	// Deadline
+	nullopt,
+
+	// Expired result
+	[]()
+	{
+		// The client asks again as the user types
+		return any(variant<vector<CompletionItem>, CompletionList, Null>(
+			CompletionList(true, {})));
+	}
 };
 
-const Capability Capability::completionItemResolve = {
+constexpr Capability Capability::completionItemResolve = {
 	// Method
 	"completionItem/resolve",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<CompletionItem>();
+			auto& params = data.emplace<CompletionItem>();
 
 			return ValueSetter{
 				// String
@@ -1389,29 +1463,38 @@ const Capability Capability::completionItemResolve = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<CompletionItem&>(data));
+			writer.Object(data.get<CompletionItem>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	nullptr,
+
+	// Work done token
+	nullptr,
+
+	// Priority
+	Priority::interactive
 };
 
-const Capability Capability::textDocumentHover = {
+constexpr Capability Capability::textDocumentHover = {
 	// Method
 	"textDocument/hover",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<HoverParams>();
+			auto& params = data.emplace<HoverParams>();
 
 			return ValueSetter{
 				// String
@@ -1442,7 +1525,7 @@ const Capability Capability::textDocumentHover = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](Hover& obj)
@@ -1453,27 +1536,54 @@ const Capability Capability::textDocumentHover = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<Hover, Null>&>(data));
+			), data.get<variant<Hover, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<HoverParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<HoverParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::interactive,
+
+	// Superseded
+	true,
+
+	// Deadline
+	nullopt,
+
+	// Expired result
+	[]()
+	{
+		return any(variant<Hover, Null>(Null()));
+	}
 };
 
-const Capability Capability::textDocumentSignatureHelp = {
+constexpr Capability Capability::textDocumentSignatureHelp = {
 	// Method
 	"textDocument/signatureHelp",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<SignatureHelpParams>();
+			auto& params = data.emplace<SignatureHelpParams>();
 
 			return ValueSetter{
 				// String
@@ -1504,7 +1614,7 @@ const Capability Capability::textDocumentSignatureHelp = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](SignatureHelp& obj)
@@ -1515,27 +1625,54 @@ const Capability Capability::textDocumentSignatureHelp = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<SignatureHelp, Null>&>(data));
+			), data.get<variant<SignatureHelp, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<SignatureHelpParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<SignatureHelpParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::interactive,
+
+	// Superseded
+	true,
+
+	// Deadline
+	nullopt,
+
+	// Expired result
+	[]()
+	{
+		return any(variant<SignatureHelp, Null>(Null()));
+	}
 };
 
-const Capability Capability::textDocumentDeclaration = {
+constexpr Capability Capability::textDocumentDeclaration = {
 	// Method
 	"textDocument/declaration",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DeclarationParams>();
+			auto& params = data.emplace<DeclarationParams>();
 
 			return ValueSetter{
 				// String
@@ -1566,7 +1703,7 @@ const Capability Capability::textDocumentDeclaration = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](Location& obj)
@@ -1595,27 +1732,39 @@ const Capability Capability::textDocumentDeclaration = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<Location, vector<Location>, vector<LocationLink>, Null>&>(data));
+			), data.get<variant<Location, vector<Location>, vector<LocationLink>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DeclarationParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<DeclarationParams>().workDoneToken;
+	}
 };
 
-const Capability Capability::textDocumentDefinition = {
+constexpr Capability Capability::textDocumentDefinition = {
 	// Method
 	"textDocument/definition",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DefinitionParams>();
+			auto& params = data.emplace<DefinitionParams>();
 
 			return ValueSetter{
 				// String
@@ -1646,7 +1795,7 @@ const Capability Capability::textDocumentDefinition = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](Location& obj)
@@ -1675,27 +1824,39 @@ const Capability Capability::textDocumentDefinition = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<Location, vector<Location>, vector<LocationLink>, Null>&>(data));
+			), data.get<variant<Location, vector<Location>, vector<LocationLink>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DefinitionParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<DefinitionParams>().workDoneToken;
+	}
 };
 
-const Capability Capability::textDocumentTypeDefinition = {
+constexpr Capability Capability::textDocumentTypeDefinition = {
 	// Method
 	"textDocument/typeDefinition",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<TypeDefinitionParams>();
+			auto& params = data.emplace<TypeDefinitionParams>();
 
 			return ValueSetter{
 				// String
@@ -1726,7 +1887,7 @@ const Capability Capability::textDocumentTypeDefinition = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](Location& obj)
@@ -1755,27 +1916,39 @@ const Capability Capability::textDocumentTypeDefinition = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<Location, vector<Location>, vector<LocationLink>, Null>&>(data));
+			), data.get<variant<Location, vector<Location>, vector<LocationLink>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<TypeDefinitionParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<TypeDefinitionParams>().workDoneToken;
+	}
 };
 
-const Capability Capability::textDocumentImplementation = {
+constexpr Capability Capability::textDocumentImplementation = {
 	// Method
 	"textDocument/implementation",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<ImplementationParams>();
+			auto& params = data.emplace<ImplementationParams>();
 
 			return ValueSetter{
 				// String
@@ -1806,7 +1979,7 @@ const Capability Capability::textDocumentImplementation = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](Location& obj)
@@ -1835,27 +2008,39 @@ const Capability Capability::textDocumentImplementation = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<Location, vector<Location>, vector<LocationLink>, Null>&>(data));
+			), data.get<variant<Location, vector<Location>, vector<LocationLink>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<ImplementationParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<ImplementationParams>().workDoneToken;
+	}
 };
 
-const Capability Capability::textDocumentReferences = {
+constexpr Capability Capability::textDocumentReferences = {
 	// Method
 	"textDocument/references",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<ReferenceParams>();
+			auto& params = data.emplace<ReferenceParams>();
 
 			return ValueSetter{
 				// String
@@ -1886,7 +2071,7 @@ const Capability Capability::textDocumentReferences = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<Location>& arr)
@@ -1902,27 +2087,42 @@ const Capability Capability::textDocumentReferences = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<Location>, Null>&>(data));
+			), data.get<variant<vector<Location>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<ReferenceParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<ReferenceParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::background
 };
 
-const Capability Capability::textDocumentDocumentHighlight = {
+constexpr Capability Capability::textDocumentDocumentHighlight = {
 	// Method
 	"textDocument/documentHighlight",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DocumentHighlightParams>();
+			auto& params = data.emplace<DocumentHighlightParams>();
 
 			return ValueSetter{
 				// String
@@ -1953,7 +2153,7 @@ const Capability Capability::textDocumentDocumentHighlight = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<DocumentHighlight>& arr)
@@ -1969,27 +2169,45 @@ const Capability Capability::textDocumentDocumentHighlight = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<DocumentHighlight>, Null>&>(data));
+			), data.get<variant<vector<DocumentHighlight>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DocumentHighlightParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<DocumentHighlightParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::normal,
+
+	// Superseded
+	true
 };
 
-const Capability Capability::textDocumentDocumentSymbol = {
+constexpr Capability Capability::textDocumentDocumentSymbol = {
 	// Method
 	"textDocument/documentSymbol",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DocumentSymbolParams>();
+			auto& params = data.emplace<DocumentSymbolParams>();
 
 			return ValueSetter{
 				// String
@@ -2020,7 +2238,7 @@ const Capability Capability::textDocumentDocumentSymbol = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<DocumentSymbol>& arr)
@@ -2045,27 +2263,45 @@ const Capability Capability::textDocumentDocumentSymbol = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<DocumentSymbol>, vector<SymbolInformation>, Null>&>(data));
+			), data.get<variant<vector<DocumentSymbol>, vector<SymbolInformation>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DocumentSymbolParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<DocumentSymbolParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::normal,
+
+	// Superseded
+	true
 };
 
-const Capability Capability::textDocumentCodeAction = {
+constexpr Capability Capability::textDocumentCodeAction = {
 	// Method
 	"textDocument/codeAction",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<CodeActionParams>();
+			auto& params = data.emplace<CodeActionParams>();
 
 			return ValueSetter{
 				// String
@@ -2096,7 +2332,7 @@ const Capability Capability::textDocumentCodeAction = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<variant<Command, CodeAction>>& arr)
@@ -2121,27 +2357,45 @@ const Capability Capability::textDocumentCodeAction = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<variant<Command, CodeAction>>, Null>&>(data));
+			), data.get<variant<vector<variant<Command, CodeAction>>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<CodeActionParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<CodeActionParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::normal,
+
+	// Superseded
+	true
 };
 
-const Capability Capability::textDocumentCodeLens = {
+constexpr Capability Capability::textDocumentCodeLens = {
 	// Method
 	"textDocument/codeLens",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<CodeLensParams>();
+			auto& params = data.emplace<CodeLensParams>();
 
 			return ValueSetter{
 				// String
@@ -2172,7 +2426,7 @@ const Capability Capability::textDocumentCodeLens = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<CodeLens>& arr)
@@ -2188,27 +2442,45 @@ const Capability Capability::textDocumentCodeLens = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<CodeLens>, Null>&>(data));
+			), data.get<variant<vector<CodeLens>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<CodeLensParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<CodeLensParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::background,
+
+	// Superseded
+	true
 };
 
-const Capability Capability::codeLensResolve = {
+constexpr Capability Capability::codeLensResolve = {
 	// Method
 	"codeLens/resolve",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<CodeLens>();
+			auto& params = data.emplace<CodeLens>();
 
 			return ValueSetter{
 				// String
@@ -2239,29 +2511,29 @@ const Capability Capability::codeLensResolve = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<CodeLens&>(data));
+			writer.Object(data.get<CodeLens>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	}}
 };
 
-const Capability Capability::textDocumentDocumentLink = {
+constexpr Capability Capability::textDocumentDocumentLink = {
 	// Method
 	"textDocument/documentLink",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DocumentLinkParams>();
+			auto& params = data.emplace<DocumentLinkParams>();
 
 			return ValueSetter{
 				// String
@@ -2292,7 +2564,7 @@ const Capability Capability::textDocumentDocumentLink = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<DocumentLink>& arr)
@@ -2308,27 +2580,45 @@ const Capability Capability::textDocumentDocumentLink = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<DocumentLink>, Null>&>(data));
+			), data.get<variant<vector<DocumentLink>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DocumentLinkParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<DocumentLinkParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::normal,
+
+	// Superseded
+	true
 };
 
-const Capability Capability::documentLinkResolve = {
+constexpr Capability Capability::documentLinkResolve = {
 	// Method
 	"documentLink/resolve",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DocumentLink>();
+			auto& params = data.emplace<DocumentLink>();
 
 			return ValueSetter{
 				// String
@@ -2359,29 +2649,29 @@ const Capability Capability::documentLinkResolve = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			writer.Object(any_cast<DocumentLink&>(data));
+			writer.Object(data.get<DocumentLink>());
 		},
 
 		// Reader
-		nullopt
+		nullptr
 	}}
 };
 
-const Capability Capability::textDocumentDocumentColor = {
+constexpr Capability Capability::textDocumentDocumentColor = {
 	// Method
 	"textDocument/documentColor",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DocumentColorParams>();
+			auto& params = data.emplace<DocumentColorParams>();
 
 			return ValueSetter{
 				// String
@@ -2412,9 +2702,9 @@ const Capability Capability::textDocumentDocumentColor = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			auto& arr = any_cast<vector<ColorInformation>&>(data);
+			auto& arr = data.get<vector<ColorInformation>>();
 
 			writer.StartArray();
 			for(auto& i: arr)
@@ -2425,23 +2715,41 @@ const Capability Capability::textDocumentDocumentColor = {
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DocumentColorParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<DocumentColorParams>().workDoneToken;
+	},
+
+	// Priority
+	Priority::normal,
+
+	// Superseded
+	true
 };
 
-const Capability Capability::textDocumentColorPresentation = {
+constexpr Capability Capability::textDocumentColorPresentation = {
 	// Method
 	"textDocument/colorPresentation",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<ColorPresentationParams>();
+			auto& params = data.emplace<ColorPresentationParams>();
 
 			return ValueSetter{
 				// String
@@ -2472,9 +2780,9 @@ const Capability Capability::textDocumentColorPresentation = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
-			auto& arr = any_cast<vector<ColorPresentation>&>(data);
+			auto& arr = data.get<vector<ColorPresentation>>();
 
 			writer.StartArray();
 			for(auto& i: arr)
@@ -2485,23 +2793,35 @@ const Capability Capability::textDocumentColorPresentation = {
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<ColorPresentationParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<ColorPresentationParams>().workDoneToken;
+	}
 };
 
-const Capability Capability::textDocumentFormatting = {
+constexpr Capability Capability::textDocumentFormatting = {
 	// Method
 	"textDocument/formatting",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DocumentFormattingParams>();
+			auto& params = data.emplace<DocumentFormattingParams>();
 
 			return ValueSetter{
 				// String
@@ -2532,7 +2852,7 @@ const Capability Capability::textDocumentFormatting = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<TextEdit>& arr)
@@ -2548,27 +2868,39 @@ const Capability Capability::textDocumentFormatting = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<TextEdit>, Null>&>(data));
+			), data.get<variant<vector<TextEdit>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DocumentFormattingParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<DocumentFormattingParams>().workDoneToken;
+	}
 };
 
-const Capability Capability::textDocumentRangeFormatting = {
+constexpr Capability Capability::textDocumentRangeFormatting = {
 	// Method
 	"textDocument/rangeFormatting",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DocumentRangeFormattingParams>();
+			auto& params = data.emplace<DocumentRangeFormattingParams>();
 
 			return ValueSetter{
 				// String
@@ -2599,7 +2931,7 @@ const Capability Capability::textDocumentRangeFormatting = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<TextEdit>& arr)
@@ -2615,27 +2947,39 @@ const Capability Capability::textDocumentRangeFormatting = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<TextEdit>, Null>&>(data));
+			), data.get<variant<vector<TextEdit>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DocumentRangeFormattingParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<DocumentRangeFormattingParams>().workDoneToken;
+	}
 };
 
-const Capability Capability::textDocumentOnTypeFormatting = {
+constexpr Capability Capability::textDocumentOnTypeFormatting = {
 	// Method
 	"textDocument/onTypeFormatting",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<DocumentOnTypeFormattingParams>();
+			auto& params = data.emplace<DocumentOnTypeFormattingParams>();
 
 			return ValueSetter{
 				// String
@@ -2666,7 +3010,7 @@ const Capability Capability::textDocumentOnTypeFormatting = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](vector<TextEdit>& arr)
@@ -2682,27 +3026,33 @@ const Capability Capability::textDocumentOnTypeFormatting = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<vector<TextEdit>, Null>&>(data));
+			), data.get<variant<vector<TextEdit>, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<DocumentOnTypeFormattingParams>().textDocument.uri;
+	}
 };
 
-const Capability Capability::textDocumentRename = {
+constexpr Capability Capability::textDocumentRename = {
 	// Method
 	"textDocument/rename",
 
 	// Request
 	{
 		// Writer
-		nullopt,
+		nullptr,
 
 		// Reader
-		[](JsonHandler& handler, optional<any>& data)
+		[](JsonHandler& handler, Envelope& data)
 		{
-			auto& params = data.emplace().emplace<RenameParams>();
+			auto& params = data.emplace<RenameParams>();
 
 			return ValueSetter{
 				// String
@@ -2733,7 +3083,7 @@ const Capability Capability::textDocumentRename = {
 	// Response
 	{{
 		// Writer
-		[](JsonWriter& writer, any& data)
+		[](JsonWriter& writer, Envelope& data)
 		{
 			visit(overload(
 				[&writer](WorkspaceEdit& obj)
@@ -2744,12 +3094,24 @@ const Capability Capability::textDocumentRename = {
 				{
 					writer.Null();
 				}
-			), any_cast<variant<WorkspaceEdit, Null>&>(data));
+			), data.get<variant<WorkspaceEdit, Null>>());
 		},
 
 		// Reader
-		nullopt
-	}}
+		nullptr
+	}},
+
+	// Document
+	[](Envelope& data) -> const DocumentUri&
+	{
+		return data.get<RenameParams>().textDocument.uri;
+	},
+
+	// Work done token
+	[](Envelope& data)
+	{
+		return data.get<RenameParams>().workDoneToken;
+	}
 };
 
 }
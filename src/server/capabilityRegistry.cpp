@@ -0,0 +1,357 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/capabilityRegistry.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace clsp
+{
+
+using namespace std;
+
+struct CapabilityRegistry::HazardOwner
+{
+	Hazard& hazard;
+
+	HazardOwner():
+		hazard(take())
+	{};
+
+	~HazardOwner()
+	{
+		hazard.snapshot.store(nullptr, memory_order_release);
+		hazard.used.store(false, memory_order_release);
+	};
+
+	/// Reuses the hazard of a thread that exited, or adds one.
+	static Hazard& take()
+	{
+		for(Hazard* h = hazards.load(memory_order_acquire); h != nullptr;
+			h = h->next)
+		{
+			bool used = false;
+
+			if(!h->used.load(memory_order_relaxed) &&
+				h->used.compare_exchange_strong(used, true))
+			{
+				return *h;
+			}
+		}
+
+		Hazard* h = new Hazard;
+
+		h->next = hazards.load(memory_order_relaxed);
+
+		while(!hazards.compare_exchange_weak(h->next, h));
+
+		return *h;
+	};
+};
+
+atomic<CapabilityRegistry::Hazard*> CapabilityRegistry::hazards = nullptr;
+
+CapabilityRegistry::Reader::Reader(const CapabilityRegistry& registry):
+	hazard(CapabilityRegistry::hazard()),
+	snapshot([this, &registry]() -> const Snapshot&
+	{
+		auto snapshot = registry.current.load(memory_order_acquire);
+
+		// Until the hazard is seen before the snapshot is replaced
+		for(;;)
+		{
+			hazard.snapshot.store(snapshot);
+
+			auto again = registry.current.load();
+
+			if(again == snapshot)
+			{
+				return *snapshot;
+			}
+
+			snapshot = again;
+		}
+	}())
+{};
+
+CapabilityRegistry::Reader::~Reader()
+{
+	hazard.snapshot.store(nullptr, memory_order_release);
+};
+
+CapabilityRegistry::CapabilityRegistry()
+{
+	auto snapshot = make_unique<Snapshot>();
+
+	snapshot->capabilities.resize(builtinCount);
+
+	current.store(snapshot.get(), memory_order_release);
+	latest = move(snapshot);
+};
+
+CapabilityRegistry::~CapabilityRegistry(){};
+
+CapabilityRegistry::Hazard& CapabilityRegistry::hazard()
+{
+	static thread_local HazardOwner owner;
+
+	return owner.hazard;
+}
+
+void CapabilityRegistry::reclaim()
+{
+	retired.erase(remove_if(retired.begin(), retired.end(),
+		[](const unique_ptr<const Snapshot>& snapshot)
+		{
+			for(Hazard* h = hazards.load(); h != nullptr; h = h->next)
+			{
+				if(h->snapshot.load() == snapshot.get())
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}), retired.end());
+}
+
+uint32_t CapabilityRegistry::hash(string_view method, uint32_t seed)
+{
+	// FNV-1a
+	uint32_t h = 2166136261u ^ seed;
+
+	for(char c: method)
+	{
+		h ^= static_cast<uint8_t>(c);
+		h *= 16777619u;
+	}
+
+	// The low bits only depend on the low bits, the slots use them
+	return h ^ (h >> 16);
+}
+
+const CapabilityRegistry::BuiltinTable& CapabilityRegistry::builtins()
+{
+	static const BuiltinTable table = []()
+	{
+		BuiltinTable table{{
+			&Capability::cancelRequest,
+			&Capability::progress,
+			&Capability::initialize,
+			&Capability::initialized,
+			&Capability::shutdown,
+			&Capability::exit,
+			&Capability::windowShowMessage,
+			&Capability::windowShowMessageRequest,
+			&Capability::windowLogMessage,
+			&Capability::windowWorkDoneProgressCreate,
+			&Capability::windowWorkDoneProgressCancel,
+			&Capability::telemetryEvent,
+			&Capability::clientRegisterCapability,
+			&Capability::clientUnregisterCapability,
+			&Capability::workspaceWorkspaceFolders,
+			&Capability::workspaceDidChangeWorkspaceFolders,
+			&Capability::workspaceDidChangeConfiguration,
+			&Capability::workspaceConfiguration,
+			&Capability::workspaceDidChangeWatchedFiles,
+			&Capability::workspaceSymbol,
+			&Capability::workspaceExecuteCommand,
+			&Capability::workspaceApplyEdit,
+			&Capability::textDocumentDidOpen,
+			&Capability::textDocumentDidChange,
+			&Capability::textDocumentWillSave,
+			&Capability::textDocumentWillSaveWaitUntil,
+			&Capability::textDocumentDidSave,
+			&Capability::textDocumentDidClose,
+			&Capability::textDocumentPublishDiagnostics,
+			&Capability::textDocumentCompletion,
+			&Capability::completionItemResolve,
+			&Capability::textDocumentHover,
+			&Capability::textDocumentSignatureHelp,
+			&Capability::textDocumentDeclaration,
+			&Capability::textDocumentDefinition,
+			&Capability::textDocumentTypeDefinition,
+			&Capability::textDocumentImplementation,
+			&Capability::textDocumentReferences,
+			&Capability::textDocumentDocumentHighlight,
+			&Capability::textDocumentDocumentSymbol,
+			&Capability::textDocumentCodeAction,
+			&Capability::textDocumentCodeLens,
+			&Capability::codeLensResolve,
+			&Capability::textDocumentDocumentLink,
+			&Capability::documentLinkResolve,
+			&Capability::textDocumentDocumentColor,
+			&Capability::textDocumentColorPresentation,
+			&Capability::textDocumentFormatting,
+			&Capability::textDocumentRangeFormatting,
+			&Capability::textDocumentOnTypeFormatting,
+			&Capability::textDocumentRename
+		}};
+
+		// About a hundred seeds are tried
+		for(;; table.seed++)
+		{
+			table.slots.fill(0);
+
+			bool collision = false;
+
+			for(size_t id = 0; id < builtinCount && !collision; id++)
+			{
+				auto& slot = table.slots[
+					hash(table.capabilities[id]->method, table.seed) &
+					(hashSize - 1)];
+
+				collision = slot != 0;
+				slot = id + 1;
+			}
+
+			if(!collision)
+			{
+				return table;
+			}
+		}
+	}();
+
+	return table;
+}
+
+optional<CapabilityRegistry::MethodId> CapabilityRegistry::builtinId(
+	string_view method)
+{
+	auto& table = builtins();
+
+	uint8_t slot = table.slots[hash(method, table.seed) & (hashSize - 1)];
+
+	if(slot != 0 && table.capabilities[slot - 1]->method == method)
+	{
+		return slot - 1;
+	}
+
+	return nullopt;
+}
+
+optional<CapabilityRegistry::MethodId> CapabilityRegistry::idOf(
+	const Snapshot& snapshot, string_view method)
+{
+	if(auto id = builtinId(method))
+	{
+		return id;
+	}
+
+	auto custom = snapshot.customIds.find(method);
+
+	if(custom != snapshot.customIds.end())
+	{
+		return custom->second;
+	}
+
+	return nullopt;
+}
+
+optional<CapabilityRegistry::MethodId> CapabilityRegistry::idOf(
+	string_view method) const
+{
+	Reader reader(*this);
+
+	return idOf(reader.snapshot, method);
+}
+
+void CapabilityRegistry::add(Capability capability)
+{
+	lock_guard lock(writeMutex);
+
+	// The capabilities are shared with the old snapshots
+	auto snapshot = make_unique<Snapshot>(*latest);
+
+	auto id = idOf(*snapshot, capability.method);
+
+	// The capability views a name that lives as long as the registry
+	if(!id.has_value())
+	{
+		capability.method = names.emplace_front(capability.method);
+	}
+	else
+	{
+		capability.method = *id < builtinCount?
+			builtins().capabilities[*id]->method:
+			latest->capabilities[*id]->method;
+	}
+
+	auto& kept = added.emplace_front(move(capability));
+
+	if(!id.has_value())
+	{
+		id = snapshot->capabilities.size();
+
+		snapshot->customIds.emplace(kept.method, *id);
+		snapshot->capabilities.emplace_back();
+	}
+
+	snapshot->capabilities[*id] = &kept;
+
+	// The readers that can still see the old one have their hazard set
+	current.store(snapshot.get());
+	retired.push_back(exchange(latest, move(snapshot)));
+
+	reclaim();
+}
+
+const Capability* CapabilityRegistry::find(string_view method) const
+{
+	Reader reader(*this);
+
+	auto id = idOf(reader.snapshot, method);
+
+	if(!id.has_value())
+	{
+		return nullptr;
+	}
+
+	return reader.snapshot.capabilities[*id];
+}
+
+const Capability* CapabilityRegistry::find(MethodId id) const
+{
+	Reader reader(*this);
+
+	if(id >= reader.snapshot.capabilities.size())
+	{
+		return nullptr;
+	}
+
+	return reader.snapshot.capabilities[id];
+}
+
+string_view CapabilityRegistry::nameOf(MethodId id) const
+{
+	// The built-in ones are known even if they aren't added
+	if(id < builtinCount)
+	{
+		return builtins().capabilities[id]->method;
+	}
+
+	auto capability = find(id);
+
+	if(capability == nullptr)
+	{
+		return string_view();
+	}
+
+	return capability->method;
+}
+
+}
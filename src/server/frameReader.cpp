@@ -0,0 +1,447 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <libclsp/server/frameReader.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <strings.h>
+
+#include <libclsp/server/byteScanner.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+FrameReader::FrameReader(){};
+FrameReader::~FrameReader(){};
+
+void FrameReader::restoreTerminator()
+{
+	if(terminator.has_value())
+	{
+		buffer[terminator->first] = terminator->second;
+		terminator.reset();
+	}
+}
+
+bool FrameReader::isShared() const
+{
+	if(buffer.use_count() > 1)
+	{
+		return true;
+	}
+
+	// The writes of the thread that released the last body are seen
+	atomic_thread_fence(memory_order_acquire);
+
+	return false;
+}
+
+void FrameReader::reallocate(size_t size)
+{
+	shared_ptr<char[]> bigger(new char[size]);
+
+	if(end > begin)
+	{
+		memcpy(bigger.get(), buffer.get() + begin, end - begin);
+	}
+
+	end  -= begin;
+	begin = 0;
+
+	buffer   = move(bigger);
+	capacity = size;
+}
+
+void FrameReader::setMaxFrameSize(size_t size)
+{
+	maxFrameSize = size;
+}
+
+bool FrameReader::isInvalid() const
+{
+	return invalid;
+}
+
+optional<size_t> FrameReader::parseLength(const char* first,
+	const char* last) const
+{
+	auto isBlank = [](char c)
+	{
+		return c == ' ' || c == '\t';
+	};
+
+	while(first < last && isBlank(*first))
+	{
+		first++;
+	}
+
+	// Only digits, a sign like in "-1" is invalid
+	if(first == last || *first < '0' || *first > '9')
+	{
+		return nullopt;
+	}
+
+	size_t length = 0;
+
+	for(; first < last && *first >= '0' && *first <= '9'; first++)
+	{
+		size_t digit = *first - '0';
+
+		// Checked before the digit is added, so it can't overflow even with
+		// the largest maximum.
+		if(digit > maxFrameSize || length > (maxFrameSize - digit) / 10)
+		{
+			return nullopt;
+		}
+
+		length = length * 10 + digit;
+	}
+
+	while(first < last && isBlank(*first))
+	{
+		first++;
+	}
+
+	// Trailing garbage
+	if(first != last)
+	{
+		return nullopt;
+	}
+
+	return length;
+}
+
+bool FrameReader::parseHeader(const char* first, const char* last,
+	optional<size_t>& length) const
+{
+	const char lineEnd[] = "\r\n";
+	const char lengthName[] = "Content-Length:";
+
+	// Header fields
+	for(auto line = first; line < last;)
+	{
+		auto fieldEnd = search(line, last, lineEnd, lineEnd + 2);
+
+		if(fieldEnd - line > (long)sizeof(lengthName) - 1 &&
+			strncasecmp(line, lengthName, sizeof(lengthName) - 1) == 0)
+		{
+			length = parseLength(line + sizeof(lengthName) - 1, fieldEnd);
+
+			if(!length.has_value())
+			{
+				return false;
+			}
+		}
+
+		line = fieldEnd + 2;
+	}
+
+	return true;
+}
+
+bool FrameReader::readHeader()
+{
+	while(!invalid)
+	{
+		const char* first = buffer.get() + begin;
+		const char* last  = buffer.get() + end;
+
+		const char* headerLast = ByteScanner::findHeaderEnd(
+			first + headerScanned, last);
+
+		if(headerLast == last) // Incomplete header
+		{
+			// The last 3 bytes can start the end of the header
+			headerScanned = max<size_t>(end - begin, 3) - 3;
+			return false;
+		}
+
+		optional<size_t> length;
+
+		if(!parseHeader(first, headerLast, length))
+		{
+			invalid = true;
+			return false;
+		}
+
+		begin = headerLast + 4 - buffer.get();
+		headerScanned = 0;
+
+		// A header without a length is skipped
+		if(length.has_value())
+		{
+			bodyLength = length;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+pair<char*, size_t> FrameReader::prepare()
+{
+	restoreTerminator();
+
+	bool shared = isShared();
+
+	if(begin == end && !shared)
+	{
+		begin = end = 0;
+	}
+
+	size_t wanted = minRead;
+
+	if(bodyLength.has_value() && *bodyLength > end - begin)
+	{
+		wanted = max(wanted, *bodyLength - (end - begin));
+	}
+
+	// The spare byte for the terminator is not part of the free space
+	if(capacity < end + wanted + 1)
+	{
+		if(shared)
+		{
+			// The taken bodies keep the old buffer until they are released
+			reallocate(max(capacity, end - begin + wanted + 1));
+		}
+		else
+		{
+			// The consumed bytes are reused first
+			if(begin > 0)
+			{
+				memmove(buffer.get(), buffer.get() + begin, end - begin);
+
+				end  -= begin;
+				begin = 0;
+			}
+
+			if(capacity < end + wanted + 1)
+			{
+				reallocate(max(capacity * 2, end + wanted + 1));
+			}
+		}
+	}
+
+	return {buffer.get() + end, capacity - end - 1};
+}
+
+void FrameReader::commit(size_t size)
+{
+	end += size;
+}
+
+void FrameReader::feed(const char* data, size_t size)
+{
+	while(size > 0)
+	{
+		auto [space, spaceSize] = prepare();
+
+		size_t copied = min(size, spaceSize);
+
+		memcpy(space, data, copied);
+		commit(copied);
+
+		data += copied;
+		size -= copied;
+	}
+}
+
+void FrameReader::commit(shared_ptr<char> bytes, size_t size)
+{
+	lent = move(bytes);
+	lentSize = size;
+}
+
+void FrameReader::skipLent(size_t size)
+{
+	lentSize -= size;
+
+	// The memory goes back to the transport with the last body in it
+	lent = lentSize > 0? shared_ptr<char>(lent, lent.get() + size): nullptr;
+}
+
+void FrameReader::completeFromLent()
+{
+	size_t size = lentSize;
+
+	if(bodyLength.has_value())
+	{
+		size = min(size, *bodyLength - (end - begin));
+	}
+	else
+	{
+		// Up to the end of the header, or everything if it's split
+		const char* first = lent.get();
+		const char* last  = ByteScanner::findHeaderEnd(first, first + size);
+
+		if(last != first + size)
+		{
+			size = last + 4 - first;
+		}
+	}
+
+	feed(lent.get(), size);
+	skipLent(size);
+}
+
+optional<pair<shared_ptr<char>, size_t>> FrameReader::takeLent()
+{
+	const char* first = lent.get();
+	const char* last  = first + lentSize;
+
+	const char* headerLast = ByteScanner::findHeaderEnd(first, last);
+
+	// The rest of the header comes with the next bytes
+	if(headerLast == last)
+	{
+		feed(first, lentSize);
+		skipLent(lentSize);
+
+		return nullopt;
+	}
+
+	optional<size_t> length;
+
+	if(!parseHeader(first, headerLast, length))
+	{
+		invalid = true;
+		return nullopt;
+	}
+
+	skipLent(headerLast + 4 - first);
+
+	// A header without a length is skipped
+	if(!length.has_value())
+	{
+		return nullopt;
+	}
+
+	if(*length <= lentSize)
+	{
+		auto body = lent;
+
+		skipLent(*length);
+
+		return {{move(body), *length}};
+	}
+
+	// The body is completed in the buffer
+	bodyLength = length;
+
+	feed(lent.get(), lentSize);
+	skipLent(lentSize);
+
+	return nullopt;
+}
+
+optional<size_t> FrameReader::consume()
+{
+	restoreTerminator();
+
+	if(!bodyLength.has_value() && !readHeader())
+	{
+		return nullopt;
+	}
+
+	if(end - begin < *bodyLength)
+	{
+		return nullopt;
+	}
+
+	size_t body = begin;
+
+	begin += *bodyLength;
+	bodyLength.reset();
+
+	return body;
+}
+
+optional<pair<char*, size_t>> FrameReader::next()
+{
+	auto body = consume();
+
+	if(!body.has_value())
+	{
+		return nullopt;
+	}
+
+	// In-situ parsing needs a null terminated string
+	terminator = {begin, buffer[begin]};
+	buffer[begin] = '\0';
+
+	return {{buffer.get() + *body, begin - *body}};
+}
+
+optional<pair<shared_ptr<char>, size_t>> FrameReader::take()
+{
+	while(!invalid)
+	{
+		auto body = consume();
+
+		// The byte after the body is the next header, so it isn't terminated
+		if(body.has_value())
+		{
+			return {{shared_ptr<char>(buffer, buffer.get() + *body),
+				begin - *body}};
+		}
+
+		if(lentSize == 0)
+		{
+			return nullopt;
+		}
+
+		// A frame started in the buffer is completed there
+		if(begin < end || bodyLength.has_value())
+		{
+			completeFromLent();
+			continue;
+		}
+
+		if(auto lentBody = takeLent())
+		{
+			return lentBody;
+		}
+	}
+
+	return nullopt;
+}
+
+void FrameReader::clear()
+{
+	begin = end = 0;
+	headerScanned = 0;
+	invalid = false;
+
+	// The old session may still parse its last bodies
+	if(isShared())
+	{
+		buffer.reset();
+		capacity = 0;
+	}
+
+	bodyLength.reset();
+	terminator.reset();
+
+	lent.reset();
+	lentSize = 0;
+}
+
+}
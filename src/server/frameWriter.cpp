@@ -0,0 +1,314 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <libclsp/server/frameWriter.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace clsp
+{
+
+using namespace std;
+
+FrameWriter::FrameWriter(){};
+
+FrameWriter::~FrameWriter()
+{
+	stopping = true;
+
+	wakeWriter();
+
+	if(writer.joinable())
+	{
+		writer.join();
+	}
+
+	// The frames pushed while the writer stopped
+	Frame* frame = frames.exchange(nullptr);
+
+	while(frame != nullptr)
+	{
+		Frame* next = frame->next;
+
+		delete frame;
+		frame = next;
+	}
+};
+
+void FrameWriter::wakeWriter()
+{
+	// The writer either sees the change or this sees it waiting.
+	atomic_thread_fence(memory_order_seq_cst);
+
+	if(writerWaiting.load(memory_order_relaxed))
+	{
+		lock_guard lock(waitMutex);
+
+		writerCondition.notify_one();
+	}
+}
+
+void FrameWriter::request(uint64_t count)
+{
+	uint64_t current = requested.load(memory_order_relaxed);
+
+	while(current < count &&
+		!requested.compare_exchange_weak(current, count, memory_order_release,
+			memory_order_relaxed));
+
+	wakeWriter();
+}
+
+void FrameWriter::push(unique_ptr<JsonWriter> body, bool deferred)
+{
+	// Nothing writes the frames without a transport
+	if(!writing.load(memory_order_acquire) ||
+		failed.load(memory_order_relaxed))
+	{
+		return;
+	}
+
+	Frame* frame = new Frame;
+
+	frame->headerSize = snprintf(frame->header, sizeof(frame->header),
+		"Content-Length: %zu\r\n\r\n", body->GetSize());
+	frame->body = move(body);
+
+	size_t size = frame->headerSize + frame->body->GetSize();
+
+	Frame* head = frames.load(memory_order_relaxed);
+
+	do
+	{
+		frame->next = head;
+	}
+	while(!frames.compare_exchange_weak(head, frame, memory_order_release,
+		memory_order_relaxed));
+
+	uint64_t count = pushed.fetch_add(1, memory_order_acq_rel) + 1;
+
+	// The first frame of a batch
+	if(head == nullptr)
+	{
+		oldest.store(chrono::steady_clock::now().time_since_epoch().count(),
+			memory_order_relaxed);
+	}
+
+	size_t waiting = batchSize.fetch_add(size, memory_order_relaxed) + size;
+	auto latency   = flushLatency.load(memory_order_relaxed);
+
+	if(waiting >= maxBatchSize || (!deferred && latency == 0))
+	{
+		request(count);
+	}
+	else if(head == nullptr && latency > 0)
+	{
+		// The writer starts to count the latency
+		wakeWriter();
+	}
+}
+
+void FrameWriter::flush()
+{
+	request(pushed.load(memory_order_acquire));
+}
+
+void FrameWriter::drain()
+{
+	if(!writing.load(memory_order_acquire))
+	{
+		return;
+	}
+
+	uint64_t target = pushed.load(memory_order_acquire);
+
+	request(target);
+
+	unique_lock lock(waitMutex);
+
+	drainers++;
+
+	atomic_thread_fence(memory_order_seq_cst);
+
+	drainCondition.wait(lock, [this, target]()
+	{
+		return written.load(memory_order_acquire) >= target;
+	});
+
+	drainers--;
+}
+
+bool FrameWriter::writeBatch()
+{
+	Frame* frame = frames.exchange(nullptr, memory_order_acquire);
+
+	if(frame == nullptr)
+	{
+		return false;
+	}
+
+	// The frames are taken newest first
+	Frame* batch = nullptr;
+	size_t count = 0;
+
+	while(frame != nullptr)
+	{
+		Frame* next = frame->next;
+
+		frame->next = batch;
+		batch = frame;
+
+		frame = next;
+		count++;
+	}
+
+	vector<iovec> parts;
+	parts.reserve(count * 2);
+
+	size_t size = 0;
+
+	for(frame = batch; frame != nullptr; frame = frame->next)
+	{
+		parts.push_back({frame->header, frame->headerSize});
+		parts.push_back({(void*)frame->body->GetString(), frame->body->GetSize()});
+
+		size += frame->headerSize + frame->body->GetSize();
+	}
+
+	batchSize.fetch_sub(size, memory_order_relaxed);
+
+	Transport* output = transport.load(memory_order_acquire);
+
+	// The transport resumes its partial writes, a failure is final
+	if(output != nullptr && !failed.load(memory_order_relaxed) &&
+		!output->writev(parts.data(), parts.size()))
+	{
+		failed.store(true, memory_order_release);
+
+		// The reader stops instead of answering to nobody
+		output->interrupt();
+	}
+
+	while(batch != nullptr)
+	{
+		Frame* next = batch->next;
+
+		delete batch;
+		batch = next;
+	}
+
+	written.fetch_add(count, memory_order_release);
+
+	atomic_thread_fence(memory_order_seq_cst);
+
+	if(drainers.load(memory_order_relaxed) > 0)
+	{
+		lock_guard lock(waitMutex);
+
+		drainCondition.notify_all();
+	}
+
+	return true;
+}
+
+void FrameWriter::writeLoop()
+{
+	// Frames must be written without waiting more
+	auto requestedOrStopping = [this]()
+	{
+		return stopping.load(memory_order_acquire) ||
+			requested.load(memory_order_acquire) >
+			written.load(memory_order_relaxed);
+	};
+
+	while(true)
+	{
+		auto latency = chrono::microseconds(
+			flushLatency.load(memory_order_relaxed));
+
+		bool waiting = frames.load(memory_order_relaxed) != nullptr;
+
+		chrono::steady_clock::time_point deadline(chrono::steady_clock::duration(
+			oldest.load(memory_order_relaxed)));
+
+		deadline += latency;
+
+		bool due = requestedOrStopping() || (waiting && latency.count() > 0 &&
+			chrono::steady_clock::now() >= deadline);
+
+		if(due)
+		{
+			if(!writeBatch() && stopping.load(memory_order_acquire))
+			{
+				return;
+			}
+
+			continue;
+		}
+
+		unique_lock lock(waitMutex);
+
+		writerWaiting = true;
+
+		atomic_thread_fence(memory_order_seq_cst);
+
+		if(waiting && latency.count() > 0)
+		{
+			writerCondition.wait_until(lock, deadline, requestedOrStopping);
+		}
+		else
+		{
+			// A frame that starts the latency also wakes it up
+			writerCondition.wait(lock, [this, &requestedOrStopping]()
+			{
+				return requestedOrStopping() ||
+					(flushLatency.load(memory_order_relaxed) > 0 &&
+					frames.load(memory_order_relaxed) != nullptr);
+			});
+		}
+
+		writerWaiting = false;
+	}
+}
+
+bool FrameWriter::hasFailed() const
+{
+	return failed.load(memory_order_acquire);
+}
+
+void FrameWriter::setTransport(Transport* transport)
+{
+	drain();
+
+	this->transport.store(transport, memory_order_release);
+	failed.store(false, memory_order_release);
+
+	if(transport != nullptr && !writing.exchange(true))
+	{
+		writer = thread(&FrameWriter::writeLoop, this);
+	}
+}
+
+void FrameWriter::setFlushLatency(chrono::microseconds latency)
+{
+	flushLatency.store(latency.count(), memory_order_relaxed);
+
+	wakeWriter();
+}
+
+}
@@ -0,0 +1,199 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/idleScheduler.hpp>
+
+#include <libclsp/server/timerQueue.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+IdleScheduler::IdleScheduler(ThreadPool& pool, chrono::milliseconds delay):
+	pool(pool),
+	delay(Clock::duration(delay).count()),
+	lastActivity(Clock::now().time_since_epoch().count())
+{};
+
+IdleScheduler::~IdleScheduler()
+{
+	unique_lock lock(idleMutex);
+
+	stopping = true;
+	period.cancel();
+	queue.clear();
+
+	// If it can't be cancelled it's running, it releases itself.
+	if(timer.has_value() && TimerQueue::shared().cancel(*timer))
+	{
+		timer = nullopt;
+		release();
+	}
+
+	pendingCondition.wait(lock, [this]()
+	{
+		return pending == 0;
+	});
+};
+
+void IdleScheduler::post(IdleTask task)
+{
+	lock_guard lock(idleMutex);
+
+	if(stopping)
+	{
+		return;
+	}
+
+	if(idle)
+	{
+		start(move(task));
+	}
+	else
+	{
+		queue.push_back(move(task));
+		armTimer();
+	}
+}
+
+void IdleScheduler::activity()
+{
+	lastActivity.store(Clock::now().time_since_epoch().count(),
+		memory_order_relaxed);
+
+	if(!idle.load(memory_order_acquire))
+	{
+		return;
+	}
+
+	lock_guard lock(idleMutex);
+
+	if(idle)
+	{
+		// The running tasks come back to the queue
+		idle = false;
+		period.cancel();
+		period = CancellationToken();
+	}
+}
+
+bool IdleScheduler::isIdle() const
+{
+	return idle.load(memory_order_acquire);
+}
+
+void IdleScheduler::setDelay(chrono::milliseconds delay)
+{
+	this->delay.store(Clock::duration(delay).count(), memory_order_relaxed);
+}
+
+void IdleScheduler::armTimer()
+{
+	if(timer.has_value() || stopping)
+	{
+		return;
+	}
+
+	pending++;
+
+	Clock::time_point due(Clock::duration(
+		lastActivity.load(memory_order_relaxed) +
+		delay.load(memory_order_relaxed)));
+
+	timer = TimerQueue::shared().schedule(due, [this]()
+	{
+		wake();
+	});
+}
+
+void IdleScheduler::wake()
+{
+	lock_guard lock(idleMutex);
+
+	timer = nullopt;
+
+	if(!stopping && !queue.empty())
+	{
+		Clock::time_point due(Clock::duration(
+			lastActivity.load(memory_order_relaxed) +
+			delay.load(memory_order_relaxed)));
+
+		if(Clock::now() < due)
+		{
+			// Input arrived since it was scheduled
+			armTimer();
+		}
+		else
+		{
+			idle = true;
+
+			auto tasks = move(queue);
+			queue.clear();
+
+			for(auto& task: tasks)
+			{
+				start(move(task));
+			}
+		}
+	}
+
+	release();
+}
+
+void IdleScheduler::start(IdleTask task)
+{
+	pending++;
+
+	pool.submit([this, task = move(task), token = period]() mutable
+	{
+		// Input may have arrived while it was queued
+		bool done = !token.isCancelled() && task(token);
+
+		finish(move(task), done, token);
+	}, Priority::background);
+}
+
+void IdleScheduler::finish(IdleTask task, bool done, CancellationToken token)
+{
+	lock_guard lock(idleMutex);
+
+	if(!done && !stopping)
+	{
+		// A step of a task in the same idle period
+		if(idle && !token.isCancelled())
+		{
+			start(move(task));
+		}
+		else
+		{
+			queue.push_back(move(task));
+			armTimer();
+		}
+	}
+
+	release();
+}
+
+void IdleScheduler::release()
+{
+	if(--pending == 0)
+	{
+		pendingCondition.notify_all();
+	}
+}
+
+}
@@ -0,0 +1,539 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <libclsp/server/incomingMessage.hpp>
+
+#include <libclsp/server/byteScanner.hpp>
+#include <libclsp/server/server.hpp>
+#include <libclsp/types/genericObject.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+IncomingMessage::IncomingMessage(Server& server):
+	server(server)
+{};
+
+IncomingMessage::~IncomingMessage(){};
+
+optional<variant<Number, String>> IncomingMessage::requestId() const
+{
+	optional<variant<Number, String>> resu;
+
+	if(id.has_value())
+	{
+		visit(overload
+		(
+			[&resu](Number n)
+			{
+				resu = n;
+			},
+			[&resu](const String &str)
+			{
+				resu = str;
+			},
+			[](Null){}
+		), *id);
+	}
+
+	return resu;
+}
+
+ValueSetter IncomingMessage::paramsSetter(JsonHandler& handler)
+{
+	// The reader depends on the method
+	if(!method.has_value())
+	{
+		return deferSetter(handler, &IncomingMessage::paramsSetter);
+	}
+
+	auto capability = server.findCapability(*method);
+
+	// Unknown methods are answered later
+	if(capability == nullptr || capability->params.reader == nullptr)
+	{
+		return skipSetter(handler);
+	}
+
+	return capability->params.reader(handler, params);
+}
+
+ValueSetter IncomingMessage::resultSetter(JsonHandler& handler)
+{
+	// The reader depends on the method of the request with this id
+	auto key = requestId();
+
+	if(!key.has_value())
+	{
+		return deferSetter(handler, &IncomingMessage::resultSetter);
+	}
+
+	// The request is completed by the dispatch, this only looks it up
+	auto capability = server.sentCapability(*key);
+
+	if(capability == nullptr ||
+		!capability->result.has_value() ||
+		capability->result->reader == nullptr)
+	{
+		return skipSetter(handler);
+	}
+
+	return capability->result->reader(handler, result);
+}
+
+ValueSetter IncomingMessage::lazySetter(JsonHandler& handler,
+	ValueSetter (IncomingMessage::*getSetter)(JsonHandler&))
+{
+	return ValueSetter{
+		// String
+		[this, &handler, getSetter](String str)
+		{
+			auto setter = (this->*getSetter)(handler);
+
+			if(setter.setString.has_value())
+			{
+				setter.setString.value()(str);
+			}
+			else
+			{
+				invalidParams = true;
+			}
+		},
+
+		// Number
+		[this, &handler, getSetter](Number n)
+		{
+			auto setter = (this->*getSetter)(handler);
+
+			if(setter.setNumber.has_value())
+			{
+				setter.setNumber.value()(n);
+			}
+			else
+			{
+				invalidParams = true;
+			}
+		},
+
+		// Boolean
+		[this, &handler, getSetter](Boolean b)
+		{
+			auto setter = (this->*getSetter)(handler);
+
+			if(setter.setBoolean.has_value())
+			{
+				setter.setBoolean.value()(b);
+			}
+			else
+			{
+				invalidParams = true;
+			}
+		},
+
+		// Null
+		[this, &handler, getSetter]()
+		{
+			auto setter = (this->*getSetter)(handler);
+
+			if(setter.setNull.has_value())
+			{
+				setter.setNull.value()();
+			}
+			else
+			{
+				invalidParams = true;
+			}
+		},
+
+		// Array
+		[this, &handler, getSetter]()
+		{
+			auto setter = (this->*getSetter)(handler);
+
+			if(setter.setArray.has_value())
+			{
+				setter.setArray.value()();
+			}
+			else
+			{
+				invalidParams = true;
+				skipSetter(handler).setArray.value()();
+			}
+		},
+
+		// Object
+		[this, &handler, getSetter]()
+		{
+			auto setter = (this->*getSetter)(handler);
+
+			if(setter.setObject.has_value())
+			{
+				setter.setObject.value()();
+			}
+			else
+			{
+				invalidParams = true;
+				skipSetter(handler).setObject.value()();
+			}
+		}
+	};
+}
+
+ValueSetter IncomingMessage::skipSetter(JsonHandler& handler)
+{
+	return ValueSetter{
+		// String
+		[](String){},
+
+		// Number
+		[](Number){},
+
+		// Boolean
+		[](Boolean){},
+
+		// Null
+		[](){},
+
+		// Array
+		[this, &handler]()
+		{
+			auto* maker = new ArrayMaker(skipped.emplace<Array>());
+
+			handler.pushInitializer();
+			maker->fillInitializer(handler.objectStack.top());
+		},
+
+		// Object
+		[this, &handler]()
+		{
+			auto obj = make_shared<GenericObject>();
+
+			skipped = Object(obj);
+
+			handler.pushInitializer();
+			obj->fillInitializer(handler.objectStack.top());
+		}
+	};
+}
+
+ValueSetter IncomingMessage::deferSetter(JsonHandler& handler,
+	ValueSetter (IncomingMessage::*getSetter)(JsonHandler&))
+{
+	// The scalars are written again as JSON
+	auto deferScalar = [this, getSetter](auto value)
+	{
+		JsonWriter writer;
+		writer.Value(value);
+
+		deferred.push_back({getSetter,
+			String(writer.GetString(), writer.GetSize())});
+	};
+
+	// The objects and the arrays are copied before the parser reaches
+	// their members. Their first byte was just taken.
+	auto deferRaw = [this, &handler, getSetter]()
+	{
+		if(handler.stream == nullptr)
+		{
+			invalidParams = true;
+			return;
+		}
+
+		auto& stream = *handler.stream;
+
+		const char* first = stream.src - 1;
+		const char* last = ByteScanner::findValueEnd(first, stream.last);
+
+		deferred.push_back({getSetter, String(first, last)});
+	};
+
+	return ValueSetter{
+		// String
+		[deferScalar](String str)
+		{
+			deferScalar(str);
+		},
+
+		// Number
+		[deferScalar](Number n)
+		{
+			deferScalar(n);
+		},
+
+		// Boolean
+		[deferScalar](Boolean b)
+		{
+			deferScalar(b);
+		},
+
+		// Null
+		[deferScalar]()
+		{
+			deferScalar(Null());
+		},
+
+		// Array
+		[this, &handler, deferRaw]()
+		{
+			deferRaw();
+			skipSetter(handler).setArray.value()();
+		},
+
+		// Object
+		[this, &handler, deferRaw]()
+		{
+			deferRaw();
+			skipSetter(handler).setObject.value()();
+		}
+	};
+}
+
+void IncomingMessage::parseDeferred()
+{
+	// A value whose member is still missing is dropped
+	auto pending = move(deferred);
+
+	for(auto& value: pending)
+	{
+		JsonHandler handler;
+
+		handler.objectStack.emplace().extraSetter =
+			lazySetter(handler, value.getSetter);
+
+		InsituBodyStream stream(value.raw.data(), value.raw.size());
+		Reader reader;
+
+		handler.stream = &stream;
+
+		if(reader.Parse<kParseInsituFlag>(stream, handler).IsError())
+		{
+			invalidParams = true;
+		}
+	}
+
+	deferred.clear();
+}
+
+void IncomingMessage::fillInitializer(ObjectInitializer& initializer)
+{
+	auto* handler = initializer.handler;
+
+	auto& setterMap = initializer.setterMap;
+
+	// Value setters
+
+	// jsonrpc:
+	setterMap.emplace(
+		jsonrpcKey,
+		ValueSetter{
+			// String
+			[](String){},
+
+			// Number
+			nullopt,
+
+			// Boolean
+			nullopt,
+
+			// Null
+			nullopt,
+
+			// Array
+			nullopt,
+
+			// Object
+			nullopt
+		}
+	);
+
+	// id?:
+	setterMap.emplace(
+		idKey,
+		ValueSetter{
+			// String
+			[this](String str)
+			{
+				id = str;
+			},
+
+			// Number
+			[this](Number n)
+			{
+				id = n;
+			},
+
+			// Boolean
+			nullopt,
+
+			// Null
+			[this]()
+			{
+				id = Null();
+			},
+
+			// Array
+			nullopt,
+
+			// Object
+			nullopt
+		}
+	);
+
+	// method?:
+	setterMap.emplace(
+		methodKey,
+		ValueSetter{
+			// String
+			[this](String str)
+			{
+				method = str;
+			},
+
+			// Number
+			nullopt,
+
+			// Boolean
+			nullopt,
+
+			// Null
+			nullopt,
+
+			// Array
+			nullopt,
+
+			// Object
+			nullopt
+		}
+	);
+
+	// params?:
+	setterMap.emplace(
+		paramsKey,
+		lazySetter(*handler, &IncomingMessage::paramsSetter)
+	);
+
+	// result?:
+	setterMap.emplace(
+		resultKey,
+		lazySetter(*handler, &IncomingMessage::resultSetter)
+	);
+
+	// error?:
+	setterMap.emplace(
+		errorKey,
+		ValueSetter{
+			// String
+			nullopt,
+
+			// Number
+			nullopt,
+
+			// Boolean
+			nullopt,
+
+			// Null
+			nullopt,
+
+			// Array
+			nullopt,
+
+			// Object
+			[this, handler]()
+			{
+				error.emplace();
+
+				handler->pushInitializer();
+				error->fillInitializer(handler->objectStack.top());
+			}
+		}
+	);
+
+	// This
+	initializer.object = this;
+}
+
+
+IncomingFrame::IncomingFrame(Server& server):
+	server(server)
+{};
+
+IncomingFrame::~IncomingFrame(){};
+
+void IncomingFrame::fillInitializer(ObjectInitializer& initializer)
+{
+	auto* handler = initializer.handler;
+
+	batch = true;
+
+	// The entries don't have keys
+	initializer.extraSetter = ValueSetter{
+		// String
+		[this](String)
+		{
+			messages.emplace_back();
+		},
+
+		// Number
+		[this](Number)
+		{
+			messages.emplace_back();
+		},
+
+		// Boolean
+		[this](Boolean)
+		{
+			messages.emplace_back();
+		},
+
+		// Null
+		[this]()
+		{
+			messages.emplace_back();
+		},
+
+		// Array
+		[this, handler]()
+		{
+			messages.emplace_back();
+
+			// The array is parsed and discarded
+			auto* maker = new ArrayMaker(skipped);
+
+			handler->pushInitializer();
+			maker->fillInitializer(handler->objectStack.top());
+		},
+
+		// Object
+		[this, handler]()
+		{
+			auto& message = messages.emplace_back(
+				make_unique<IncomingMessage>(server));
+
+			message->batched = true;
+
+			handler->pushInitializer();
+			message->fillInitializer(handler->objectStack.top());
+		}
+	};
+
+	// This
+	initializer.object = this;
+}
+
+}
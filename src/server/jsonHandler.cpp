@@ -51,13 +51,13 @@ bool JsonHandler::Null()
 	{
 		auto& extraSetter = topObject.extraSetter;
 
-		if(extraSetter.has_value())
+		if(extraSetter.has_value() && extraSetter->setNull.has_value())
 		{
 			setNull = extraSetter->setNull.value();
 		}
 		else
 		{
-			// Key not found and no extra members on the object
+			// Key not found and no extra members of this type
 			return false;
 		}
 	}
@@ -97,13 +97,13 @@ bool JsonHandler::Bool(bool b)
 	{
 		auto& extraSetter = topObject.extraSetter;
 
-		if(extraSetter.has_value())
+		if(extraSetter.has_value() && extraSetter->setBoolean.has_value())
 		{
 			setBoolean = extraSetter->setBoolean.value();
 		}
 		else
 		{
-			// Key not found and no extra members on the object
+			// Key not found and no extra members of this type
 			return false;
 		}
 	}
@@ -143,13 +143,13 @@ bool JsonHandler::Number(clsp::Number n)
 	{
 		auto& extraSetter = topObject.extraSetter;
 
-		if(extraSetter.has_value())
+		if(extraSetter.has_value() && extraSetter->setNumber.has_value())
 		{
 			setNumber = extraSetter->setNumber.value();
 		}
 		else
 		{
-			// Key not found and no extra members on the object
+			// Key not found and no extra members of this type
 			return false;
 		}
 	}
@@ -186,7 +186,7 @@ bool JsonHandler::Double(double d)
 	return Number(d);
 }
 
-bool JsonHandler::String(const char* str, SizeType, bool)
+bool JsonHandler::String(const char* str, SizeType length, bool)
 {
 	function<void(clsp::String)> setString;
 
@@ -214,20 +214,21 @@ bool JsonHandler::String(const char* str, SizeType, bool)
 	{
 		auto& extraSetter = topObject.extraSetter;
 
-		if(extraSetter.has_value())
+		if(extraSetter.has_value() && extraSetter->setString.has_value())
 		{
 			setString = extraSetter->setString.value();
 		}
 		else
 		{
-			// Key not found and no extra members on the object
+			// Key not found and no extra members of this type
 			return false;
 		}
 	}
 
 	//TODO add exceptions
 
-	setString(str);
+	// The strings can have null characters
+	setString(clsp::String(str, length));
 
 	return true;
 }
@@ -260,13 +261,13 @@ bool JsonHandler::StartObject()
 	{
 		auto& extraSetter = topObject.extraSetter;
 
-		if(extraSetter.has_value())
+		if(extraSetter.has_value() && extraSetter->setObject.has_value())
 		{
 			setObject = extraSetter->setObject.value();
 		}
 		else
 		{
-			// Key not found and no extra members on the object
+			// Key not found and no extra members of this type
 			return false;
 		}
 	}
@@ -278,9 +279,9 @@ bool JsonHandler::StartObject()
 	return true;
 }
 
-bool JsonHandler::Key(const char* str, SizeType, bool)
+bool JsonHandler::Key(const char* str, SizeType length, bool)
 {
-	lastKey = str;
+	lastKey.assign(str, length);
 
 	return true;
 }
@@ -330,13 +331,13 @@ bool JsonHandler::StartArray()
 	{
 		auto& extraSetter = topArray.extraSetter;
 
-		if(extraSetter.has_value())
+		if(extraSetter.has_value() && extraSetter->setArray.has_value())
 		{
 			setArray = extraSetter->setArray.value();
 		}
 		else
 		{
-			// Key not found and no extra members on the object
+			// Key not found and no extra members of this type
 			return false;
 		}
 	}
@@ -380,4 +381,43 @@ void JsonHandler::pushInitializer()
 	});
 }
 
+InsituBodyStream::InsituBodyStream(char* body, size_t size):
+	src(body),
+	dst(nullptr),
+	head(body),
+	last(body + size)
+{};
+
+InsituBodyStream::Ch InsituBodyStream::Peek() const
+{
+	return src < last? *src: '\0';
+}
+
+InsituBodyStream::Ch InsituBodyStream::Take()
+{
+	return src < last? *src++: '\0';
+}
+
+size_t InsituBodyStream::Tell() const
+{
+	return src - head;
+}
+
+InsituBodyStream::Ch* InsituBodyStream::PutBegin()
+{
+	return dst = src;
+}
+
+void InsituBodyStream::Put(Ch c)
+{
+	*dst++ = c;
+}
+
+void InsituBodyStream::Flush(){};
+
+size_t InsituBodyStream::PutEnd(Ch* begin)
+{
+	return dst - begin;
+}
+
 }
@@ -0,0 +1,359 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/recordingTransport.hpp>
+
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The first bytes of a session log
+struct LogHeader
+{
+	char magic[8];
+	uint64_t startTime;
+};
+
+/// The header of each record
+struct LogRecord
+{
+	uint64_t time;
+	uint32_t size;
+	uint8_t direction;
+	uint8_t padding[3];
+};
+
+static_assert(sizeof(LogHeader) == 16 && sizeof(LogRecord) == 16,
+	"The log layout must not have compiler padding");
+
+constexpr static char logMagic[8] = {'c','l','s','p','l','o','g','1'};
+
+constexpr static uint8_t endDirection = 0;
+constexpr static uint8_t inputDirection = 1;
+constexpr static uint8_t outputDirection = 2;
+
+/// The log grows in steps of this size
+constexpr static size_t logGrowth = 16 << 20;
+
+/// Rounds size up to the record alignment.
+constexpr static size_t aligned(size_t size)
+{
+	return (size + 7) & ~size_t(7);
+}
+
+RecordingTransport::RecordingTransport(Transport& transport, String path):
+	transport(transport),
+	start(chrono::steady_clock::now())
+{
+	fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+	if(fd == -1)
+	{
+		return;
+	}
+
+	capacity = logGrowth;
+
+	if(ftruncate(fd, capacity) == -1)
+	{
+		return;
+	}
+
+	void* mapping = mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+		MAP_SHARED, fd, 0);
+
+	if(mapping == MAP_FAILED)
+	{
+		return;
+	}
+
+	log = (char*)mapping;
+
+	timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+
+	LogHeader header;
+	memcpy(header.magic, logMagic, sizeof(logMagic));
+	header.startTime = uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+
+	memcpy(log, &header, sizeof(header));
+	end = sizeof(header);
+};
+
+RecordingTransport::~RecordingTransport()
+{
+	if(log != nullptr)
+	{
+		munmap(log, capacity);
+	}
+
+	if(fd != -1)
+	{
+		// Drop the unused part of the last growth
+		if(log != nullptr)
+		{
+			(void)ftruncate(fd, end);
+		}
+
+		close(fd);
+	}
+};
+
+bool RecordingTransport::isValid() const
+{
+	return log != nullptr;
+}
+
+void RecordingTransport::append(uint8_t direction, const iovec* parts,
+	size_t count)
+{
+	if(log == nullptr)
+	{
+		return;
+	}
+
+	uint64_t time = chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now() - start).count();
+
+	size_t size = 0;
+
+	for(size_t i = 0; i < count; i++)
+	{
+		size += parts[i].iov_len;
+	}
+
+	if(size > UINT32_MAX)
+	{
+		return;
+	}
+
+	lock_guard lock(logMutex);
+
+	// The end record must always fit after this one
+	size_t needed = end + sizeof(LogRecord) + aligned(size) + sizeof(LogRecord);
+
+	if(needed > capacity)
+	{
+		size_t newCapacity = aligned(needed) + logGrowth;
+
+		if(ftruncate(fd, newCapacity) == -1)
+		{
+			return;
+		}
+
+		void* mapping = mremap(log, capacity, newCapacity, MREMAP_MAYMOVE);
+
+		if(mapping == MAP_FAILED)
+		{
+			return;
+		}
+
+		log = (char*)mapping;
+		capacity = newCapacity;
+	}
+
+	// The bytes go first, so a reader of a crashed log never sees a record
+	// with garbage. The new pages of the file are already zeros.
+	char* data = log + end + sizeof(LogRecord);
+
+	for(size_t i = 0; i < count; i++)
+	{
+		memcpy(data, parts[i].iov_base, parts[i].iov_len);
+		data += parts[i].iov_len;
+	}
+
+	LogRecord record = {time, uint32_t(size), direction, {}};
+	memcpy(log + end, &record, sizeof(record));
+
+	end += sizeof(LogRecord) + aligned(size);
+}
+
+ssize_t RecordingTransport::read(char* buffer, size_t size)
+{
+	ssize_t n = transport.read(buffer, size);
+
+	if(n > 0)
+	{
+		iovec part = {buffer, size_t(n)};
+		append(inputDirection, &part, 1);
+	}
+
+	return n;
+}
+
+bool RecordingTransport::write(const char* data, size_t size)
+{
+	iovec part = {(void*)data, size};
+	append(outputDirection, &part, 1);
+
+	return transport.write(data, size);
+}
+
+bool RecordingTransport::writev(const iovec* parts, size_t count)
+{
+	append(outputDirection, parts, count);
+
+	return transport.writev(parts, count);
+}
+
+void RecordingTransport::interrupt()
+{
+	transport.interrupt();
+}
+
+bool RecordingTransport::wait()
+{
+	return transport.wait();
+}
+
+ReplayTransport::ReplayTransport(String path, bool realTime):
+	realTime(realTime)
+{
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+	if(fd == -1)
+	{
+		return;
+	}
+
+	struct stat status;
+
+	if(fstat(fd, &status) == 0 && size_t(status.st_size) >= sizeof(LogHeader))
+	{
+		void* mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE,
+			fd, 0);
+
+		if(mapping != MAP_FAILED)
+		{
+			if(memcmp(mapping, logMagic, sizeof(logMagic)) == 0)
+			{
+				log = (const char*)mapping;
+				size = status.st_size;
+				next = sizeof(LogHeader);
+
+				madvise(mapping, size, MADV_SEQUENTIAL);
+			}
+			else
+			{
+				munmap(mapping, status.st_size);
+			}
+		}
+	}
+
+	close(fd);
+};
+
+ReplayTransport::~ReplayTransport()
+{
+	if(log != nullptr)
+	{
+		munmap((void*)log, size);
+	}
+};
+
+bool ReplayTransport::isValid() const
+{
+	return log != nullptr;
+}
+
+size_t ReplayTransport::writtenSize() const
+{
+	return written;
+}
+
+bool ReplayTransport::nextInput()
+{
+	while(next + sizeof(LogRecord) <= size)
+	{
+		LogRecord record;
+		memcpy(&record, log + next, sizeof(record));
+
+		if(record.direction == endDirection)
+		{
+			break;
+		}
+
+		size_t recordEnd = next + sizeof(LogRecord) + aligned(record.size);
+
+		// A truncated log
+		if(recordEnd > size)
+		{
+			break;
+		}
+
+		const char* data = log + next + sizeof(LogRecord);
+		next = recordEnd;
+
+		if(record.direction != inputDirection || record.size == 0)
+		{
+			continue;
+		}
+
+		if(realTime)
+		{
+			if(!firstTime.has_value())
+			{
+				firstTime = record.time;
+				replayStart = chrono::steady_clock::now();
+			}
+
+			this_thread::sleep_until(replayStart +
+				chrono::nanoseconds(record.time - *firstTime));
+		}
+
+		pending = data;
+		pendingSize = record.size;
+
+		return true;
+	}
+
+	return false;
+}
+
+ssize_t ReplayTransport::read(char* buffer, size_t size)
+{
+	if(pendingSize == 0 && !nextInput())
+	{
+		return 0;
+	}
+
+	size_t n = min(size, pendingSize);
+
+	memcpy(buffer, pending, n);
+	pending += n;
+	pendingSize -= n;
+
+	return n;
+}
+
+bool ReplayTransport::write(const char*, size_t size)
+{
+	written += size;
+
+	return log != nullptr;
+}
+
+}
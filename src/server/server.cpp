@@ -16,111 +16,1660 @@
 
 #include <libclsp/server/server.hpp>
 
+#include <cerrno>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+#include <libclsp/server/byteScanner.hpp>
+#include <libclsp/server/incomingMessage.hpp>
+#include <libclsp/server/spscQueue.hpp>
+#include <libclsp/server/timerQueue.hpp>
+#include <libclsp/server/uringTransport.hpp>
+#include <libclsp/types/cancelParams.hpp>
+#include <libclsp/types/notificationMessage.hpp>
+#include <libclsp/types/requestMessage.hpp>
+#include <libclsp/types/responseMessage.hpp>
+#include <libclsp/types/workDoneProgress.hpp>
+
 namespace clsp
 {
 
-using namespace std;
+using namespace std;
+
+void Server::startIO()
+{
+	startIO(IOBackend::readWrite);
+}
+
+void Server::startIO(IOBackend backend)
+{
+	if(backend == IOBackend::ioUring)
+	{
+		UringTransport uring;
+
+		if(uring.isValid())
+		{
+			startIO(uring);
+			return;
+		}
+	}
+
+	FdTransport stdio;
+
+	startIO(stdio);
+}
+
+void Server::startIO(Transport& transport)
+{
+	connect(transport);
+
+	// The bodies keep their part of the reader buffer
+	SpscQueue<pair<shared_ptr<char>, size_t>> bodies(pipelineDepth);
+
+	SpscQueue<unique_ptr<IncomingFrame>> messages(pipelineDepth);
+
+	// Parse stage
+	thread parser([this, &bodies, &messages]()
+	{
+		while(auto body = bodies.pop())
+		{
+			auto message = parse(body->first.get(), body->second);
+
+			if(message != nullptr)
+			{
+				messages.push(move(message));
+			}
+		}
+
+		messages.close();
+	});
+
+	// Dispatch stage
+	thread dispatcher([this, &transport, &bodies, &messages]()
+	{
+		while(auto message = messages.pop())
+		{
+			// The messages after the exit notification are dropped
+			if(!running)
+			{
+				continue;
+			}
+
+			dispatchingServer = this;
+
+			schedule(move(*message));
+
+			// The responses of the queued messages are written together
+			if(messages.empty() && bodies.empty())
+			{
+				dispatchingServer = nullptr;
+				frameWriter.flush();
+			}
+
+			if(!running)
+			{
+				transport.interrupt();
+			}
+		}
+
+		dispatchingServer = nullptr;
+		frameWriter.flush();
+	});
+
+	// The transports that read into their own memory lend it, then the
+	// bodies in it aren't copied
+	bool lending = true;
+
+	// Read stage
+	while(running)
+	{
+		shared_ptr<char> lent;
+		ssize_t size = -1;
+
+		if(lending)
+		{
+			size = transport.lend(lent);
+			lending = size >= 0 || errno != ENOTSUP;
+		}
+
+		if(!lending)
+		{
+			auto [space, spaceSize] = frameReader.prepare();
+
+			size = transport.read(space, spaceSize);
+		}
+
+		// A non-blocking input waits for its bytes instead of spinning
+		if(size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			if(transport.wait())
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		// End of the input
+		if(size <= 0)
+		{
+			break;
+		}
+
+		if(lent != nullptr)
+		{
+			frameReader.commit(move(lent), size);
+		}
+		else
+		{
+			frameReader.commit(size);
+		}
+
+		// The background work waits for the client to stop
+		idleScheduler.activity();
+
+		while(auto body = frameReader.take())
+		{
+			bodies.push(move(*body));
+		}
+
+		// A bad Content-Length or a failed write ends the session
+		if(frameReader.isInvalid() || frameWriter.hasFailed())
+		{
+			break;
+		}
+	}
+
+	bodies.close();
+
+	parser.join();
+	dispatcher.join();
+
+	// The lent bytes go back before the transport ends
+	frameReader.clear();
+
+	disconnect();
+}
+
+void Server::connect(Transport& transport)
+{
+	this->transport = &transport;
+	frameWriter.setTransport(&transport);
+
+	frameReader.clear();
+	running = true;
+}
+
+bool Server::readInput()
+{
+	auto [space, spaceSize] = frameReader.prepare();
+
+	ssize_t size = transport->read(space, spaceSize);
+
+	if(size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+	{
+		// Nothing to read yet
+		return running;
+	}
+
+	// End of the input
+	if(size <= 0)
+	{
+		running = false;
+		return false;
+	}
+
+	frameReader.commit(size);
+
+	// The background work waits for the client to stop
+	idleScheduler.activity();
+
+	// The socket loop only parses, even the ordered messages run in the pool
+	if(ordered == nullptr)
+	{
+		ordered = make_shared<Strand>(pool, [this](bool)
+		{
+			taskDone();
+		});
+	}
+
+	dispatchingServer = this;
+
+	while(running)
+	{
+		auto body = frameReader.next();
+
+		if(!body.has_value())
+		{
+			break;
+		}
+
+		auto frame = parse(body->first, body->second);
+
+		if(frame != nullptr)
+		{
+			schedule(move(frame));
+		}
+	}
+
+	dispatchingServer = nullptr;
+
+	// The responses of this read
+	frameWriter.flush();
+
+	// A bad Content-Length or a failed write ends the session
+	if(frameReader.isInvalid() || frameWriter.hasFailed())
+	{
+		running = false;
+	}
+
+	return running;
+}
+
+void Server::disconnect()
+{
+	running = false;
+
+	// The client can't answer anymore
+	failResults();
+
+	// Their responses are still written
+	waitTasks();
+
+	frameWriter.setTransport(nullptr);
+	this->transport = nullptr;
+}
+
+void Server::receive(char* body, size_t size)
+{
+	auto frame = parse(body, size);
+
+	if(frame != nullptr)
+	{
+		dispatch(move(frame));
+	}
+}
+
+unique_ptr<IncomingFrame> Server::parse(char* body, size_t size)
+{
+	auto frame = make_unique<IncomingFrame>(*this);
+	JsonHandler handler;
+
+	// The message or the batch is the root value
+	handler.objectStack.emplace().extraSetter = ValueSetter{
+		// String
+		nullopt,
+
+		// Number
+		nullopt,
+
+		// Boolean
+		nullopt,
+
+		// Null
+		nullopt,
+
+		// Array
+		[&handler, &frame]()
+		{
+			handler.pushInitializer();
+			frame->fillInitializer(handler.objectStack.top());
+		},
+
+		// Object
+		[this, &handler, &frame]()
+		{
+			auto& message = frame->messages.emplace_back(
+				make_unique<IncomingMessage>(*this));
+
+			handler.pushInitializer();
+			message->fillInitializer(handler.objectStack.top());
+		}
+	};
+
+	InsituBodyStream stream(body, size);
+	Reader reader;
+
+	// The params found before the method copy their raw JSON
+	handler.stream = &stream;
+
+	// The whole body is validated at once, so the parser only checks the
+	// encoding of the invalid ones to find where the error is.
+	auto result = ByteScanner::isValidUtf8(body, size)?
+		reader.Parse<kParseInsituFlag>(stream, handler):
+		reader.Parse<kParseInsituFlag|kParseValidateEncodingFlag>(stream,
+			handler);
+
+	bool parsed = !result.IsError();
+
+	// The handler stops the parser when a value doesn't fit its member, so
+	// the JSON read until then is valid. Any other error is in the syntax
+	// or the encoding, and the members read can't be trusted.
+	bool rejected = result.Code() == kParseErrorTermination;
+
+	// A batch that isn't parsed completely has a single response
+	if(rejected && !frame->batch && !frame->messages.empty())
+	{
+		auto& message = frame->messages.front();
+		auto id = message->requestId();
+
+		// The request can still be answered
+		if(id.has_value() && message->method.has_value())
+		{
+			addRequest(*id, *message->method, RequestKind::fromClient);
+			respond(*id, ResponseError(ErrorCodes::InvalidParams,
+				"Invalid params", nullopt));
+		}
+		else if(!message->method.has_value() && !id.has_value())
+		{
+			frameWriter.push(makeResponse(Null(), ResponseError(
+				ErrorCodes::ParseError, "Parse error", nullopt)), deferred());
+		}
+
+		return nullptr;
+	}
+
+	if(!parsed)
+	{
+		frameWriter.push(makeResponse(Null(), ResponseError(
+			ErrorCodes::ParseError, "Parse error", nullopt)), deferred());
+
+		return nullptr;
+	}
+
+	if(frame->messages.empty())
+	{
+		frameWriter.push(makeResponse(Null(), ResponseError(
+			ErrorCodes::InvalidRequest, "Empty batch", nullopt)), deferred());
+
+		return nullptr;
+	}
+
+	// The members that pick the readers are known now
+	for(auto& message: frame->messages)
+	{
+		if(message != nullptr)
+		{
+			message->parseDeferred();
+		}
+	}
+
+	return frame;
+}
+
+bool Server::deferred() const
+{
+	return dispatchingServer == this;
+}
+
+void Server::schedule(unique_ptr<IncomingFrame> frame)
+{
+	auto& message = frame->messages.front();
+
+	// The initialization and the responses keep their order
+	if(frame->batch || !initialized || message == nullptr ||
+		!message->method.has_value())
+	{
+		dispatchInOrder(move(frame));
+		return;
+	}
+
+	bool request = message->requestId().has_value();
+
+	auto capability = findCapability(*message->method);
+
+	auto document = capability != nullptr?
+		documentOf(*message, *capability): nullptr;
+
+	Priority priority = capability != nullptr?
+		capability->priority: Priority::normal;
+
+	optional<ThreadPool::Clock::time_point> deadline;
+
+	// It can be cancelled while it's queued
+	if(request)
+	{
+		deadline = receiveRequest(*message, capability, document);
+	}
+	else if(document != nullptr &&
+		*message->method == Capability::textDocumentDidChange.method)
+	{
+		supersede(*document);
+	}
+
+	// The ordered messages still queued run first
+	if((!request && document == nullptr) ||
+		(ordered != nullptr && !ordered->idle()))
+	{
+		dispatchInOrder(move(frame));
+		return;
+	}
+
+	{
+		lock_guard lock(tasksMutex);
+
+		pendingTasks++;
+	}
+
+	// function<> must be copyable
+	shared_ptr<IncomingFrame> shared = move(frame);
+
+	if(document == nullptr)
+	{
+		pool.submit([this, shared]()
+		{
+			dispatch(*shared->messages.front());
+
+			taskDone();
+		}, priority, deadline);
+
+		return;
+	}
+
+	lock_guard lock(strandsMutex);
+
+	auto& strand = strands[*document];
+
+	if(strand == nullptr)
+	{
+		// It's removed when it has nothing to run
+		strand = make_shared<Strand>(pool, [this, uri = *document](bool idle)
+		{
+			if(idle)
+			{
+				lock_guard lock(strandsMutex);
+
+				auto strand = strands.find(uri);
+
+				if(strand != strands.end() && strand->second->idle())
+				{
+					strands.erase(strand);
+				}
+			}
+
+			taskDone();
+		});
+	}
+
+	// The notifications change the document, the requests only read it
+	strand->post([this, shared]()
+	{
+		dispatch(*shared->messages.front());
+	}, request, priority, deadline);
+}
+
+void Server::dispatchInOrder(unique_ptr<IncomingFrame> frame)
+{
+	if(ordered == nullptr)
+	{
+		dispatch(move(frame));
+		return;
+	}
+
+	{
+		lock_guard lock(tasksMutex);
+
+		pendingTasks++;
+	}
+
+	// function<> must be copyable
+	shared_ptr<IncomingFrame> shared = move(frame);
+
+	ordered->post([this, shared]()
+	{
+		if(shared->batch)
+		{
+			dispatchBatch(shared, 0);
+		}
+		else
+		{
+			dispatch(*shared->messages.front());
+		}
+
+		// The socket loop closes the session when it sees the input end
+		if(!running)
+		{
+			transport->interrupt();
+		}
+	});
+}
+
+const DocumentUri* Server::documentOf(IncomingMessage& message,
+	const Capability& capability)
+{
+	if(!message.params.has_value() || message.invalidParams ||
+		capability.document == nullptr)
+	{
+		return nullptr;
+	}
+
+	return &(*capability.document)(message.params);
+}
+
+void Server::taskDone()
+{
+	lock_guard lock(tasksMutex);
+
+	if(--pendingTasks == 0)
+	{
+		tasksCondition.notify_all();
+	}
+}
+
+void Server::waitTasks()
+{
+	unique_lock lock(tasksMutex);
+
+	tasksCondition.wait(lock, [this]()
+	{
+		return pendingTasks == 0;
+	});
+}
+
+void Server::dispatch(unique_ptr<IncomingFrame> frame)
+{
+	if(frame->batch)
+	{
+		dispatchBatch(move(frame), 0);
+	}
+	else
+	{
+		dispatch(*frame->messages.front());
+	}
+}
+
+void Server::dispatchBatch(shared_ptr<IncomingFrame> frame, size_t first)
+{
+	auto& messages = frame->messages;
+
+	// Requests that can run with the ones next to them
+	auto independent = [this](unique_ptr<IncomingMessage>& message)
+	{
+		return initialized && message != nullptr &&
+			message->method.has_value() && message->requestId().has_value();
+	};
+
+	// The batch is answered after the dispatcher moves on, disconnect()
+	// waits for its response.
+	if(first == 0)
+	{
+		lock_guard lock(tasksMutex);
+
+		pendingTasks++;
+	}
+
+	while(first < messages.size() && running)
+	{
+		size_t last = first;
+
+		while(last < messages.size() && independent(messages[last]))
+		{
+			last++;
+		}
+
+		if(last - first > 1)
+		{
+			// The last request to finish dispatches the rest of the batch
+			auto remaining = make_shared<atomic<size_t>>(last - first);
+
+			for(size_t i = first; i < last; i++)
+			{
+				pool.submit([this, frame, remaining, i, last]()
+				{
+					dispatch(*frame->messages[i]);
+
+					if(--*remaining == 0)
+					{
+						dispatchBatch(frame, last);
+					}
+				});
+			}
+
+			return;
+		}
+
+		// A single request or a message that waits for the others
+		if(messages[first] != nullptr)
+		{
+			dispatch(*messages[first]);
+		}
+
+		first++;
+	}
+
+	auto writer = make_unique<JsonWriter>();
+	bool empty = true;
+
+	writer->StartArray();
+
+	for(auto& message: messages)
+	{
+		unique_ptr<JsonWriter> response;
+
+		if(message == nullptr)
+		{
+			response = makeResponse(Null(), ResponseError(
+				ErrorCodes::InvalidRequest, "Invalid request", nullopt));
+		}
+		else
+		{
+			response = move(message->response);
+		}
+
+		if(response != nullptr)
+		{
+			writer->RawValue(response->GetString(), response->GetSize(),
+				kObjectType);
+
+			empty = false;
+		}
+	}
+
+	writer->EndArray();
+
+	// A batch of notifications has no response
+	if(!empty)
+	{
+		frameWriter.push(move(writer), deferred());
+	}
+
+	taskDone();
+}
+
+void Server::dispatch(IncomingMessage& message)
+{
+	try
+	{
+		invoke(message);
+	}
+	catch(const exception& error)
+	{
+		fail(message, error.what());
+	}
+	catch(...)
+	{
+		fail(message, "unknown exception");
+	}
+}
+
+void Server::fail(IncomingMessage& message, const char* what)
+{
+	auto id = message.requestId();
+
+	cerr << "libclsp: " << message.method.value_or("a response") <<
+		" threw: " << what << endl;
+
+	// Nothing is sent if it threw after its response
+	if(message.method.has_value() && id.has_value())
+	{
+		respond(message, ResponseError(ErrorCodes::InternalError,
+			"Internal error", nullopt));
+	}
+}
+
+void Server::invoke(IncomingMessage& message)
+{
+	auto id = message.requestId();
+
+	// Request
+	if(message.method.has_value() && id.has_value())
+	{
+		String& method = *message.method;
+
+		// The ones that run in the pool are received when they're queued
+		if(!message.received)
+		{
+			receiveRequest(message, findCapability(method));
+		}
+
+		if(!initialized && method != Capability::initialize.method)
+		{
+			respond(message, ResponseError(ErrorCodes::ServerNotInitialized,
+				"The server is not initialized", nullopt));
+			return;
+		}
+
+		if(message.invalidParams)
+		{
+			respond(message, ResponseError(ErrorCodes::InvalidParams,
+				"Invalid params", nullopt));
+			return;
+		}
+
+		optional<variant<RequestHandler, AsyncRequestHandler,
+			WritingRequestHandler>> handler;
+
+		shared->handlerMutex.lock_shared();
+
+		auto handlerPair = shared->requestHandlerMap.find(method);
+		if(handlerPair != shared->requestHandlerMap.end())
+		{
+			handler = handlerPair->second;
+		}
+
+		shared->handlerMutex.unlock_shared();
+
+		if(!handler.has_value())
+		{
+			respond(message, ResponseError(ErrorCodes::MethodNotFound,
+				"Method not found: " + method, nullopt));
+			return;
+		}
+
+		// Cancelled while it was queued. An expired one still runs, its
+		// handler sees the cancellation and returns what it has.
+		if(message.cancellation.isCancelled() &&
+			!message.cancellation.isExpired())
+		{
+			respond(message, ResponseError(ErrorCodes::RequestCancelled,
+				"Request cancelled", nullopt));
+			return;
+		}
+
+		bool initialize = method == Capability::initialize.method;
+
+		if(auto* writingRequestHandler =
+			get_if<WritingRequestHandler>(&*handler))
+		{
+			RequestMessage request(*this, *id, method, move(message.params),
+				nullopt);
+
+			request.cancellation = message.cancellation;
+
+			if((*writingRequestHandler)(message, request) && initialize)
+			{
+				initialized = true;
+			}
+
+			return;
+		}
+
+		if(auto* asyncRequestHandler = get_if<AsyncRequestHandler>(&*handler))
+		{
+			auto request = make_shared<RequestMessage>(*this, *id, method,
+				move(message.params), nullopt);
+
+			request->cancellation = message.cancellation;
+
+			// The server waits for the response before it disconnects
+			{
+				lock_guard lock(tasksMutex);
+
+				pendingTasks++;
+			}
+
+			// Set by the result handler, or by a handler that throws
+			auto finished = make_shared<atomic<bool>>(false);
+
+			try
+			{
+				(*asyncRequestHandler)(request, [this, id = *id, initialize,
+					cancellation = message.cancellation, finished](
+						variant<any, ResponseError> resultOrError)
+				{
+					if(finished->exchange(true))
+					{
+						return;
+					}
+
+					if(cancellation.isCancelled() && !cancellation.isExpired())
+					{
+						resultOrError = ResponseError(
+							ErrorCodes::RequestCancelled, "Request cancelled",
+							nullopt);
+					}
+
+					if(initialize && holds_alternative<any>(resultOrError))
+					{
+						initialized = true;
+					}
+
+					respond(id, move(resultOrError));
+
+					taskDone();
+				});
+			}
+			catch(...)
+			{
+				// The result handler won't be waited for
+				if(!finished->exchange(true))
+				{
+					taskDone();
+				}
+
+				throw;
+			}
+
+			return;
+		}
+
+		RequestMessage request(*this, *id, method, move(message.params),
+			nullopt);
+
+		request.cancellation = message.cancellation;
+
+		auto resultOrError = get<RequestHandler>(*handler)(request);
+
+		if(initialize && holds_alternative<any>(resultOrError))
+		{
+			initialized = true;
+		}
+
+		respond(message, move(resultOrError));
+	}
+	// Notification
+	else if(message.method.has_value())
+	{
+		String& method = *message.method;
+
+		bool exit = method == Capability::exit.method;
+
+		bool valid = !message.invalidParams && message.params.has_value();
+
+		if(initialized && valid && method == Capability::cancelRequest.method)
+		{
+			cancelRequest(message.params.get<CancelParams>().id);
+		}
+
+		if(initialized && valid &&
+			method == Capability::windowWorkDoneProgressCancel.method)
+		{
+			cancelProgress(
+				message.params.get<WorkDoneProgressCancelParams>().token);
+		}
+
+		if((initialized || exit) && !message.invalidParams)
+		{
+			optional<NotificationHandler> notificationHandler;
+
+			shared->handlerMutex.lock_shared();
+
+			auto handlerPair = shared->notificationHandlerMap.find(method);
+			if(handlerPair != shared->notificationHandlerMap.end())
+			{
+				notificationHandler = handlerPair->second;
+			}
+
+			shared->handlerMutex.unlock_shared();
+
+			if(notificationHandler.has_value())
+			{
+				NotificationMessage notification(*this, method,
+					move(message.params));
+
+				(*notificationHandler)(notification);
+			}
+		}
+
+		if(exit)
+		{
+			running = false;
+		}
+	}
+	// Response
+	else if(id.has_value())
+	{
+		// Completed here and not by the parser, which may run in its own
+		// thread
+		completeRequest(*id, RequestKind::toClient);
+
+		receiveResult(message);
+	}
+}
+
+void Server::receiveResult(IncomingMessage& message)
+{
+	optional<ResultHandler> resultHandler = takeResult(*message.requestId());
+
+	if(!resultHandler.has_value())
+	{
+		return;
+	}
+
+	if(message.error.has_value())
+	{
+		(*resultHandler)(move(*message.error));
+	}
+	else if(message.result.has_value())
+	{
+		(*resultHandler)(message.result.toAny());
+	}
+	else
+	{
+		// A null result or one without a reader
+		(*resultHandler)(any());
+	}
+}
+
+optional<ResultHandler> Server::takeResult(variant<Number, String> id)
+{
+	optional<PendingResult> pending;
+
+	resultHandlerMutex.lock();
+
+	auto pendingPair = resultHandlerMap.find(id);
+	if(pendingPair != resultHandlerMap.end())
+	{
+		pending = move(pendingPair->second);
+		resultHandlerMap.erase(pendingPair);
+	}
+
+	resultHandlerMutex.unlock();
+
+	if(!pending.has_value())
+	{
+		return nullopt;
+	}
+
+	// If it can't be cancelled it's running, it won't find the request
+	// and it ends its task.
+	if(pending->timer.has_value() && TimerQueue::shared().cancel(*pending->timer))
+	{
+		taskDone();
+	}
+
+	return move(pending->handler);
+}
+
+void Server::timeoutResult(variant<Number, String> id)
+{
+	optional<ResultHandler> resultHandler;
+
+	resultHandlerMutex.lock();
+
+	auto pendingPair = resultHandlerMap.find(id);
+	if(pendingPair != resultHandlerMap.end())
+	{
+		resultHandler = move(pendingPair->second.handler);
+		resultHandlerMap.erase(pendingPair);
+	}
+
+	resultHandlerMutex.unlock();
+
+	if(resultHandler.has_value())
+	{
+		completeRequest(id, RequestKind::toClient);
+
+		NotificationMessage cancel(*this,
+			String(Capability::cancelRequest.method), nullopt);
+
+		cancel.params.emplace<CancelParams>(id);
+
+		send(cancel);
+
+		(*resultHandler)(ResponseError(ErrorCodes::RequestCancelled,
+			"The request timed out", nullopt));
+	}
+
+	taskDone();
+}
+
+void Server::failResults()
+{
+	resultHandlerMutex.lock();
+
+	vector<variant<Number, String>> ids;
 
-void Server::startIO()
+	for(auto& [id, pending]: resultHandlerMap)
+	{
+		ids.push_back(id);
+	}
+
+	resultHandlerMutex.unlock();
+
+	for(auto& id: ids)
+	{
+		optional<ResultHandler> resultHandler = takeResult(id);
+
+		if(!resultHandler.has_value())
+		{
+			continue;
+		}
+
+		completeRequest(id, RequestKind::toClient);
+
+		(*resultHandler)(ResponseError(ErrorCodes::RequestCancelled,
+			"The session ended", nullopt));
+	}
+}
+
+unique_ptr<JsonWriter> Server::makeResponse(variant<Number, String, Null> id,
+	variant<any, ResponseError> resultOrError)
 {
-	// TODO
+	auto writer = make_unique<JsonWriter>();
+
+	visit(overload
+	(
+		[this, &id, &writer](any& result)
+		{
+			ResponseMessage response(*this, id, move(result));
+
+			response.write(*writer);
+		},
+		[this, &id, &writer](ResponseError& error)
+		{
+			ResponseMessage response(*this, id, move(error));
+
+			response.write(*writer);
+		}
+	), resultOrError);
+
+	return writer;
 }
 
-void Server::addCapability(Capability capability)
+optional<ThreadPool::Clock::time_point> Server::receiveRequest(
+	IncomingMessage& message, const Capability* capability,
+	const DocumentUri* document)
 {
-	capabilityMutex.lock();
+	auto id = *message.requestId();
+
+	optional<ProgressToken> workDoneToken;
+
+	if(message.params.has_value() && !message.invalidParams &&
+		capability != nullptr && capability->workDoneToken != nullptr)
+	{
+		workDoneToken = (*capability->workDoneToken)(message.params);
+	}
+
+	optional<ThreadPool::Clock::time_point> deadline;
+
+	// A batch is answered at once
+	if(capability != nullptr && capability->deadline.has_value() &&
+		!message.batched)
+	{
+		deadline = ThreadPool::Clock::now() + *capability->deadline;
+	}
+
+	message.received = true;
+
+	bool superseded = capability != nullptr && capability->superseded &&
+		document != nullptr;
+
+	size_t documentHash = superseded? hash<DocumentUri>()(*document): 0;
+
+	auto method = shared->capabilities.idOf(*message.method)
+		.value_or(CapabilityRegistry::unknownMethod);
+
+	requestRecievedTable.emplace(id, ReceivedRequest{
+		method, ThreadPool::Clock::now(), CancellationToken(),
+		message.batched, false, workDoneToken, documentHash, superseded,
+		nullopt},
+		[this, &message, &deadline, &id](ReceivedRequest& request, bool added)
+		{
+			message.cancellation = request.cancellation;
+
+			if(!added || !deadline.has_value())
+			{
+				return;
+			}
+
+			// The server waits for the timer
+			{
+				lock_guard lock(tasksMutex);
+
+				pendingTasks++;
+			}
+
+			// It waits for the shard lock before looking for the request
+			request.deadlineTimer = TimerQueue::shared().schedule(
+				*deadline,
+				[this, id]()
+				{
+					expireRequest(id);
+				});
+		});
+
+	if(workDoneToken.has_value())
+	{
+		lock_guard lock(progressMutex);
 
-	capabiliyMap.emplace(capability.method, capability);
+		progressMap.insert_or_assign(*workDoneToken, ProgressCancellation{
+			message.cancellation, id});
+	}
 
-	capabilityMutex.unlock();
+	return deadline;
 }
 
-optional<Capability> Server::getCapability(String method)
+void Server::expireRequest(variant<Number, String> id)
+{
+	optional<CapabilityRegistry::MethodId> method;
+
+	requestRecievedTable.update(id, [&method](ReceivedRequest& request)
+	{
+		if(!request.answered)
+		{
+			request.cancellation.expire();
+			request.deadlineTimer = nullopt;
+
+			method = request.method;
+		}
+	});
+
+	if(method.has_value())
+	{
+		auto capability = shared->capabilities.find(*method);
+
+		// A fast incomplete answer instead of a late one
+		if(capability != nullptr && capability->expiredResult != nullptr &&
+			claimResponse(id))
+		{
+			variant<Number, String, Null> responseId;
+
+			visit([&responseId](auto& i)
+			{
+				responseId = i;
+			}, id);
+
+			frameWriter.push(makeResponse(responseId,
+				(*capability->expiredResult)()), deferred());
+		}
+	}
+
+	taskDone();
+}
+
+void Server::supersede(const DocumentUri& document)
+{
+	vector<variant<Number, String>> stale;
+
+	size_t documentHash = hash<DocumentUri>()(document);
+
+	requestRecievedTable.forEach(
+		[&stale, documentHash](variant<Number, String> id,
+			ReceivedRequest& request)
+		{
+			if(request.superseded && !request.answered && !request.batched &&
+				request.documentHash == documentHash)
+			{
+				request.cancellation.cancel();
+				request.answered = true;
+
+				stale.push_back(move(id));
+			}
+		});
+
+	for(auto& id: stale)
+	{
+		variant<Number, String, Null> responseId;
+
+		visit([&responseId](auto& i)
+		{
+			responseId = i;
+		}, id);
+
+		frameWriter.push(makeResponse(responseId, ResponseError(
+			ErrorCodes::ContentModified, "Content modified", nullopt)),
+			deferred());
+	}
+}
+
+bool Server::claimResponse(variant<Number, String> id)
+{
+	bool claimed = false;
+
+	requestRecievedTable.update(id, [&claimed](ReceivedRequest& request)
+	{
+		if(!request.answered)
+		{
+			request.answered = true;
+			claimed = true;
+		}
+	});
+
+	return claimed;
+}
+
+void Server::respond(variant<Number, String> id,
+	variant<any, ResponseError> resultOrError)
+{
+	// Cancelled requests are already answered
+	if(!claimResponse(id))
+	{
+		return;
+	}
+
+	variant<Number, String, Null> responseId;
+
+	visit([&responseId](auto& i)
+	{
+		responseId = i;
+	}, id);
+
+	frameWriter.push(makeResponse(responseId, move(resultOrError)),
+		deferred());
+}
+
+void Server::respond(IncomingMessage& message,
+	variant<any, ResponseError> resultOrError)
 {
-	optional<Capability> resu;
+	if(message.cancellation.isCancelled() &&
+		!message.cancellation.isExpired())
+	{
+		resultOrError = ResponseError(ErrorCodes::RequestCancelled,
+			"Request cancelled", nullopt);
+	}
+
+	if(!message.batched)
+	{
+		respond(*message.requestId(), move(resultOrError));
+		return;
+	}
+
+	auto id = *message.requestId();
+
+	if(!claimResponse(id))
+	{
+		return;
+	}
+
+	variant<Number, String, Null> responseId;
+
+	visit([&responseId](auto& i)
+	{
+		responseId = i;
+	}, id);
+
+	message.response = makeResponse(responseId, move(resultOrError));
+}
+
+void Server::writeResponse(IncomingMessage& message,
+	const ResultWriter& resultWriter)
+{
+	if(message.cancellation.isCancelled() &&
+		!message.cancellation.isExpired())
+	{
+		respond(message, ResponseError(ErrorCodes::RequestCancelled,
+			"Request cancelled", nullopt));
+		return;
+	}
+
+	auto id = *message.requestId();
+
+	if(!claimResponse(id))
+	{
+		return;
+	}
+
+	variant<Number, String, Null> responseId;
+
+	visit([&responseId](auto& i)
+	{
+		responseId = i;
+	}, id);
+
+	auto writer = make_unique<JsonWriter>();
 
-	capabilityMutex.lock_shared();
+	ResponseMessage response(*this, responseId, resultWriter);
 
-	auto capability = capabiliyMap.find(method);
+	response.write(*writer);
 
-	if(capability != capabiliyMap.end())
+	if(message.batched)
 	{
-		resu = capability->second;
+		message.response = move(writer);
 	}
 	else
 	{
-		resu = nullopt;
+		frameWriter.push(move(writer), deferred());
 	}
+}
+
+void Server::send(Message& message)
+{
+	auto writer = make_unique<JsonWriter>();
 
-	capabilityMutex.unlock_shared();
+	message.write(*writer);
 
-	return resu;
+	frameWriter.push(move(writer), deferred());
+}
+
+void Server::setFlushLatency(chrono::microseconds latency)
+{
+	frameWriter.setFlushLatency(latency);
+}
+
+void Server::setMaxFrameSize(size_t size)
+{
+	frameReader.setMaxFrameSize(size);
+}
+
+void Server::onRequest(String method, RequestHandler handler)
+{
+	shared->handlerMutex.lock();
+
+	shared->requestHandlerMap.insert_or_assign(method, handler);
+
+	shared->handlerMutex.unlock();
+}
+
+void Server::onAsyncRequest(String method, AsyncRequestHandler handler)
+{
+	shared->handlerMutex.lock();
+
+	shared->requestHandlerMap.insert_or_assign(method, handler);
+
+	shared->handlerMutex.unlock();
+}
+
+void Server::onWritingRequest(String method, WritingRequestHandler handler)
+{
+	shared->handlerMutex.lock();
+
+	shared->requestHandlerMap.insert_or_assign(method, handler);
+
+	shared->handlerMutex.unlock();
+}
+
+void Server::sendRequest(String method, Envelope params,
+	ResultHandler handler,
+	optional<chrono::milliseconds> timeout)
+{
+	// Other threads don't wait for this one
+	variant<Number, String> id = Number(++lastId);
+
+	resultHandlerMutex.lock();
+
+	// disconnect() takes the handlers after running is unset
+	if(!running)
+	{
+		resultHandlerMutex.unlock();
+
+		handler(ResponseError(ErrorCodes::RequestCancelled,
+			"The session ended", nullopt));
+		return;
+	}
+
+	PendingResult pending{move(handler), nullopt};
+
+	if(timeout.has_value())
+	{
+		// The destructor waits for the timer
+		{
+			lock_guard lock(tasksMutex);
+			pendingTasks++;
+		}
+
+		// It waits for this mutex before looking for the request
+		pending.timer = TimerQueue::shared().schedule(
+			TimerQueue::Clock::now() + *timeout,
+			[this, id]()
+			{
+				timeoutResult(id);
+			});
+	}
+
+	requestSentTable.emplace(id, SentRequest{
+		shared->capabilities.idOf(method).value_or(
+			CapabilityRegistry::unknownMethod),
+		ThreadPool::Clock::now()});
+	resultHandlerMap.emplace(id, move(pending));
+
+	resultHandlerMutex.unlock();
+
+	RequestMessage request(*this, id, method, move(params), nullopt);
+
+	send(request);
+}
+
+future<variant<any, ResponseError>> Server::sendRequest(String method,
+	Envelope params,
+	optional<chrono::milliseconds> timeout)
+{
+	// function<> must be copyable
+	auto resultPromise = make_shared<promise<variant<any, ResponseError>>>();
+
+	auto result = resultPromise->get_future();
+
+	sendRequest(move(method), move(params),
+		[resultPromise](variant<any, ResponseError> resultOrError)
+		{
+			resultPromise->set_value(move(resultOrError));
+		},
+		timeout);
+
+	return result;
+}
+
+unique_ptr<Server> Server::openSession()
+{
+	// The constructor is private
+	return unique_ptr<Server>(new Server(shared, pool));
+}
+
+ThreadPool& Server::getThreadPool()
+{
+	return pool;
+}
+
+IdleScheduler& Server::getIdleScheduler()
+{
+	return idleScheduler;
+}
+
+void Server::onNotification(String method, NotificationHandler handler)
+{
+	shared->handlerMutex.lock();
+
+	shared->notificationHandlerMap.insert_or_assign(method, handler);
+
+	shared->handlerMutex.unlock();
+}
+
+void Server::addCapability(Capability capability)
+{
+	shared->capabilities.add(move(capability));
+}
+
+optional<Capability> Server::getCapability(String method)
+{
+	auto capability = shared->capabilities.find(method);
+
+	if(capability == nullptr)
+	{
+		return nullopt;
+	}
+
+	return *capability;
+}
+
+const Capability* Server::findCapability(string_view method) const
+{
+	return shared->capabilities.find(method);
+}
+
+const Capability* Server::sentCapability(variant<Number, String> id)
+{
+	auto method = CapabilityRegistry::unknownMethod;
+
+	requestSentTable.update(id, [&method](SentRequest& request)
+	{
+		method = request.method;
+	});
+
+	return shared->capabilities.find(method);
+}
+
+void Server::cancelRequest(variant<Number, String> id)
+{
+	bool answer = false;
+
+	requestRecievedTable.update(id, [&answer](ReceivedRequest& request)
+	{
+		request.cancellation.cancel();
+
+		// A batch is answered at once when it ends
+		if(!request.batched && !request.answered)
+		{
+			request.answered = true;
+			answer = true;
+		}
+	});
+
+	if(answer)
+	{
+		variant<Number, String, Null> responseId;
+
+		visit([&responseId](auto& i)
+		{
+			responseId = i;
+		}, id);
+
+		frameWriter.push(makeResponse(responseId, ResponseError(
+			ErrorCodes::RequestCancelled, "Request cancelled", nullopt)),
+			deferred());
+	}
+}
+
+void Server::cancelProgress(ProgressToken token)
+{
+	optional<variant<Number, String>> request;
+
+	{
+		lock_guard lock(progressMutex);
+
+		auto progress = progressMap.find(token);
+
+		if(progress == progressMap.end())
+		{
+			return;
+		}
 
+		progress->second.cancellation.cancel();
+		request = progress->second.request;
+	}
+
+	if(request.has_value())
+	{
+		cancelRequest(*request);
+	}
+}
+
+CancellationToken Server::addProgress(ProgressToken token)
+{
+	lock_guard lock(progressMutex);
+
+	return progressMap.insert_or_assign(token,
+		ProgressCancellation{CancellationToken(), nullopt}).first->second
+		.cancellation;
+}
+
+void Server::removeProgress(ProgressToken token)
+{
+	lock_guard lock(progressMutex);
+
+	progressMap.erase(token);
 }
 
 void Server::addRequest(variant<Number, String> id,
 	String method,
 	RequestKind kind)
 {
+	auto methodId = shared->capabilities.idOf(method)
+		.value_or(CapabilityRegistry::unknownMethod);
+
+	auto start = ThreadPool::Clock::now();
+
 	switch(kind)
 	{
 		case RequestKind::toClient:
-			requestSentMutex.lock();
-
-			requestSentMap.emplace(id, method);
-
-			requestSentMutex.unlock();
+			requestSentTable.emplace(id, SentRequest{methodId, start});
 			break;
 
 		case RequestKind::fromClient:
-			requestRecievedMutex.lock();
+		{
+			ReceivedRequest request;
 
-			requestRecievedMap.emplace(id, method);
+			request.method       = methodId;
+			request.start        = start;
+			request.cancellation = CancellationToken();
 
-			requestRecievedMutex.unlock();
+			requestRecievedTable.emplace(id, move(request));
 			break;
+		}
 	}
 }
 
-String Server::completeRequest(variant<Number, String> id, RequestKind kind)
+string_view Server::completeRequest(variant<Number, String> id,
+	RequestKind kind)
 {
-	String resu;
+	string_view resu;
+
+	optional<SentRequest> sent;
+	optional<ReceivedRequest> received;
 
-	map<variant<Number, String>, String>::iterator mapIterator;
+	optional<ProgressToken> workDoneToken;
+	optional<uint64_t> deadlineTimer;
 
 	switch(kind)
 	{
 		case RequestKind::toClient:
-			requestSentMutex.lock();
-
-			mapIterator = requestSentMap.find(id);
-			if(mapIterator != requestSentMap.end())
+			sent = requestSentTable.take(id);
+			if(sent.has_value())
 			{
-				resu = mapIterator->second;
-				requestSentMap.erase(mapIterator);
+				resu = shared->capabilities.nameOf(sent->method);
 			}
-
-			requestSentMutex.unlock();
 			break;
 
 		case RequestKind::fromClient:
-			requestRecievedMutex.lock();
+			received = requestRecievedTable.take(id);
+			if(received.has_value())
+			{
+				resu = shared->capabilities.nameOf(received->method);
+				workDoneToken = move(received->workDoneToken);
+				deadlineTimer = received->deadlineTimer;
+			}
 
-			mapIterator = requestRecievedMap.find(id);
-			if(mapIterator != requestRecievedMap.end())
+			// If it can't be cancelled it's running, it won't find the
+			// request and it ends its task.
+			if(deadlineTimer.has_value() &&
+				TimerQueue::shared().cancel(*deadlineTimer))
 			{
-				resu = mapIterator->second;
-				requestRecievedMap.erase(mapIterator);
+				taskDone();
 			}
 
-			requestRecievedMutex.unlock();
+			// The progress ends with the request
+			if(workDoneToken.has_value())
+			{
+				lock_guard lock(progressMutex);
+
+				auto progress = progressMap.find(*workDoneToken);
+
+				if(progress != progressMap.end() &&
+					progress->second.request == id)
+				{
+					progressMap.erase(progress);
+				}
+			}
 			break;
 	}
 
 	return resu;
 }
 
-Server::Server(){};
-Server::~Server(){};
+Server::Server():
+	Server(ThreadPool::shared())
+{};
+
+Server::Server(ThreadPool& pool):
+	Server(make_shared<Shared>(), pool)
+{
+	// Needed to parse the cancellations
+	addCapability(Capability::cancelRequest);
+	addCapability(Capability::windowWorkDoneProgressCancel);
+};
+
+Server::Server(shared_ptr<Shared> shared, ThreadPool& pool):
+	shared(move(shared)),
+	pool(pool),
+	idleScheduler(pool)
+{};
+
+Server::~Server()
+{
+	// Their timers are tasks
+	failResults();
+
+	waitTasks();
+};
 
 }
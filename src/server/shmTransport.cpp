@@ -0,0 +1,548 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/shmTransport.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The header of the shared memory object.
+struct alignas(64) ShmTransport::Segment
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t capacity;
+
+	atomic<int32_t> serverPid;
+	atomic<int32_t> clientPid;
+};
+
+/// A single-producer/single-consumer byte ring.
+/// The positions only grow, the index in the data is position%capacity.
+struct alignas(64) ShmTransport::Ring
+{
+	// Written by the producer
+	alignas(64) atomic<uint64_t> tail;
+	atomic<uint32_t> dataSequence;
+	atomic<uint32_t> consumerWaiting;
+	atomic<uint32_t> closed;
+
+	// Written by the consumer
+	alignas(64) atomic<uint64_t> head;
+	atomic<uint32_t> spaceSequence;
+	atomic<uint32_t> producerWaiting;
+};
+
+static_assert(atomic<uint32_t>::is_always_lock_free &&
+	sizeof(atomic<uint32_t>) == sizeof(uint32_t),
+	"The futex words must be plain 32 bits integers");
+
+/// "clsp" in ASCII
+constexpr static uint32_t shmMagic = 0x70736c63;
+constexpr static uint32_t shmVersion = 1;
+
+/// The iterations spent spinning before sleeping on a futex
+constexpr static int spinCount = 256;
+
+/// How often a sleeping side checks if the other one is still alive
+constexpr static timespec peerCheckPeriod = {1, 0};
+
+/// Sleeps while the futex word has the given value, and the wake word of
+/// this process too if there's one.
+/// The object is shared between processes, so it's not a private futex.
+static void futexWait(atomic<uint32_t>& word, uint32_t value,
+	atomic<uint32_t>* wake, uint32_t wakeValue)
+{
+	if(wake != nullptr)
+	{
+		futex_waitv waiters[2] = {};
+
+		waiters[0].uaddr = (uintptr_t)&word;
+		waiters[0].val   = value;
+		waiters[0].flags = FUTEX_32;
+
+		waiters[1].uaddr = (uintptr_t)wake;
+		waiters[1].val   = wakeValue;
+		waiters[1].flags = FUTEX_32 | FUTEX_PRIVATE_FLAG;
+
+		// The timeout of futex_waitv is absolute
+		timespec timeout;
+
+		clock_gettime(CLOCK_MONOTONIC, &timeout);
+		timeout.tv_sec += peerCheckPeriod.tv_sec;
+
+		// Linux 5.16, before it the wake word isn't waited on
+		if(syscall(SYS_futex_waitv, waiters, 2, 0, &timeout,
+			CLOCK_MONOTONIC) >= 0 || errno != ENOSYS)
+		{
+			return;
+		}
+	}
+
+	syscall(SYS_futex, &word, FUTEX_WAIT, value, &peerCheckPeriod,
+		nullptr, 0);
+}
+
+static void futexWake(atomic<uint32_t>& word, int operation = FUTEX_WAKE)
+{
+	syscall(SYS_futex, &word, operation, 1, nullptr, nullptr, 0);
+}
+
+/// True if the process may still be running.
+static bool processAlive(pid_t pid)
+{
+	return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+static void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#endif
+}
+
+/// Waits until the condition is true or the futex word changes.
+/// The waiting flag tells the other side to wake this one up. The wake
+/// word, when given, is changed by this process to stop the wait.
+template<class Condition>
+static void waitFor(atomic<uint32_t>& sequence, atomic<uint32_t>& waiting,
+	Condition condition, atomic<uint32_t>* wake = nullptr)
+{
+	for(int i = 0; i < spinCount; i++)
+	{
+		if(condition())
+		{
+			return;
+		}
+
+		cpuRelax();
+	}
+
+	uint32_t value = sequence.load(memory_order_acquire);
+	uint32_t wakeValue = wake != nullptr? wake->load(memory_order_acquire): 0;
+
+	waiting.store(1, memory_order_seq_cst);
+
+	// Checks again after publishing the flag, so no wake up is lost.
+	if(!condition())
+	{
+		futexWait(sequence, value, wake, wakeValue);
+	}
+
+	waiting.store(0, memory_order_relaxed);
+}
+
+/// Publishes a change to the other side.
+static void notify(atomic<uint32_t>& sequence, atomic<uint32_t>& waiting)
+{
+	sequence.fetch_add(1, memory_order_seq_cst);
+
+	if(waiting.load(memory_order_seq_cst))
+	{
+		futexWake(sequence);
+	}
+}
+
+/// Rounds up to a power of two.
+static size_t ceilPow2(size_t size)
+{
+	size_t resu = 4096;
+
+	while(resu < size)
+	{
+		resu <<= 1;
+	}
+
+	return resu;
+}
+
+ShmTransport::ShmTransport(String name, Side side, size_t capacity):
+	name(name),
+	side(side)
+{
+	// The size of a ring and its data, it keeps the next ring aligned.
+	auto ringSpan = [](size_t capacity){
+		return sizeof(Ring) + capacity;
+	};
+
+	int fd;
+
+	if(side == Side::server)
+	{
+		this->capacity = ceilPow2(capacity);
+
+		fd = shm_open(name.c_str(), O_RDWR|O_CREAT|O_EXCL|O_CLOEXEC, 0600);
+
+		// Only the object left by a server that died is replaced, a live
+		// one keeps it
+		if(fd < 0 && errno == EEXIST && !serverAlive(name))
+		{
+			shm_unlink(name.c_str());
+
+			fd = shm_open(name.c_str(), O_RDWR|O_CREAT|O_EXCL|O_CLOEXEC,
+				0600);
+		}
+
+		mappingSize = sizeof(Segment) + 2*ringSpan(this->capacity);
+
+		if(fd < 0)
+		{
+			return;
+		}
+
+		// A new object is filled with zeros, so the rings are empty.
+		if(ftruncate(fd, mappingSize) < 0)
+		{
+			::close(fd);
+			shm_unlink(name.c_str());
+			return;
+		}
+	}
+	else
+	{
+		fd = shm_open(name.c_str(), O_RDWR|O_CLOEXEC, 0);
+
+		struct stat status;
+
+		if(fd < 0)
+		{
+			return;
+		}
+
+		if(fstat(fd, &status) < 0 || (size_t)status.st_size < sizeof(Segment))
+		{
+			::close(fd);
+			return;
+		}
+
+		mappingSize = status.st_size;
+	}
+
+	void* memory = mmap(nullptr, mappingSize, PROT_READ|PROT_WRITE,
+		MAP_SHARED, fd, 0);
+
+	::close(fd);
+
+	if(memory == MAP_FAILED)
+	{
+		if(side == Side::server)
+		{
+			shm_unlink(name.c_str());
+		}
+		return;
+	}
+
+	Segment* mapped = (Segment*)memory;
+
+	if(side == Side::server)
+	{
+		mapped->magic    = shmMagic;
+		mapped->version  = shmVersion;
+		mapped->capacity = this->capacity;
+		mapped->serverPid.store(getpid(), memory_order_release);
+	}
+	else
+	{
+		this->capacity = mapped->capacity;
+
+		if(mapped->magic != shmMagic || mapped->version != shmVersion ||
+			mappingSize != sizeof(Segment) + 2*ringSpan(this->capacity))
+		{
+			munmap(memory, mappingSize);
+			return;
+		}
+
+		mapped->clientPid.store(getpid(), memory_order_release);
+	}
+
+	char* clientRing = (char*)memory + sizeof(Segment);
+	char* serverRing = clientRing + ringSpan(this->capacity);
+
+	Ring* toServer = (Ring*)clientRing;
+	Ring* toClient = (Ring*)serverRing;
+
+	if(side == Side::server)
+	{
+		input  = toServer;
+		output = toClient;
+	}
+	else
+	{
+		input  = toClient;
+		output = toServer;
+	}
+
+	inputData  = (char*)input + sizeof(Ring);
+	outputData = (char*)output + sizeof(Ring);
+
+	segment = mapped;
+};
+
+ShmTransport::ShmTransport(String name, Side side):
+	ShmTransport(name, side, defaultCapacity)
+{};
+
+ShmTransport::~ShmTransport()
+{
+	if(segment != nullptr)
+	{
+		close();
+
+		munmap(segment, mappingSize);
+
+		if(side == Side::server)
+		{
+			shm_unlink(name.c_str());
+		}
+	}
+};
+
+bool ShmTransport::serverAlive(const String& name)
+{
+	int fd = shm_open(name.c_str(), O_RDONLY|O_CLOEXEC, 0);
+
+	if(fd < 0)
+	{
+		return errno != ENOENT;
+	}
+
+	struct stat status;
+
+	bool alive = true;
+
+	if(fstat(fd, &status) == 0 && (size_t)status.st_size >= sizeof(Segment))
+	{
+		void* memory = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED,
+			fd, 0);
+
+		if(memory != MAP_FAILED)
+		{
+			auto* mapped = (const Segment*)memory;
+
+			pid_t pid = mapped->serverPid.load(memory_order_acquire);
+
+			// The pid is written last, without it the server is starting
+			alive = mapped->magic != shmMagic || pid == 0 ||
+				processAlive(pid);
+
+			munmap(memory, sizeof(Segment));
+		}
+	}
+
+	::close(fd);
+
+	return alive;
+}
+
+bool ShmTransport::isValid() const
+{
+	return segment != nullptr;
+}
+
+bool ShmTransport::peerAlive() const
+{
+	pid_t pid = side == Side::server?
+		segment->clientPid.load(memory_order_acquire):
+		segment->serverPid.load(memory_order_acquire);
+
+	// The client may not be connected yet.
+	if(pid == 0)
+	{
+		return true;
+	}
+
+	return processAlive(pid);
+}
+
+ssize_t ShmTransport::read(char* buffer, size_t size)
+{
+	if(segment == nullptr)
+	{
+		errno = EBADF;
+		return -1;
+	}
+
+	uint64_t head = input->head.load(memory_order_relaxed);
+	uint64_t tail;
+
+	while(true)
+	{
+		tail = input->tail.load(memory_order_acquire);
+
+		if(tail != head)
+		{
+			break;
+		}
+
+		if(input->closed.load(memory_order_acquire))
+		{
+			// The closed flag is set after the last bytes.
+			tail = input->tail.load(memory_order_acquire);
+
+			if(tail != head)
+			{
+				break;
+			}
+
+			return 0;
+		}
+
+		if(!peerAlive() || interrupted.load(memory_order_acquire))
+		{
+			return 0;
+		}
+
+		waitFor(input->dataSequence, input->consumerWaiting, [&]{
+			return input->tail.load(memory_order_acquire) != head ||
+				input->closed.load(memory_order_acquire) ||
+				interrupted.load(memory_order_acquire);
+		}, &wakeSequence);
+	}
+
+	size_t readSize = min<uint64_t>(size, tail - head);
+	size_t index    = head & (capacity - 1);
+	size_t first    = min(readSize, capacity - index);
+
+	memcpy(buffer, inputData + index, first);
+	memcpy(buffer + first, inputData, readSize - first);
+
+	input->head.store(head + readSize, memory_order_release);
+
+	notify(input->spaceSequence, input->producerWaiting);
+
+	return readSize;
+}
+
+bool ShmTransport::write(const char* data, size_t size)
+{
+	iovec part = {(void*)data, size};
+
+	return writev(&part, 1);
+}
+
+bool ShmTransport::writev(const iovec* parts, size_t count)
+{
+	if(segment == nullptr)
+	{
+		return false;
+	}
+
+	lock_guard<mutex> lock(outputMutex);
+
+	if(output->closed.load(memory_order_relaxed))
+	{
+		return false;
+	}
+
+	uint64_t tail = output->tail.load(memory_order_relaxed);
+
+	for(size_t i = 0; i < count; i++)
+	{
+		const char* data = (const char*)parts[i].iov_base;
+		size_t size      = parts[i].iov_len;
+
+		while(size > 0)
+		{
+			uint64_t head = output->head.load(memory_order_acquire);
+			size_t space  = capacity - (tail - head);
+
+			if(space == 0)
+			{
+				// Publishes what's already copied before sleeping.
+				output->tail.store(tail, memory_order_release);
+				notify(output->dataSequence, output->consumerWaiting);
+
+				if(!peerAlive())
+				{
+					return false;
+				}
+
+				waitFor(output->spaceSequence, output->producerWaiting, [&]{
+					return output->head.load(memory_order_acquire) != head;
+				});
+
+				continue;
+			}
+
+			size_t writeSize = min(size, space);
+			size_t index     = tail & (capacity - 1);
+			size_t first     = min(writeSize, capacity - index);
+
+			memcpy(outputData + index, data, first);
+			memcpy(outputData, data + first, writeSize - first);
+
+			tail += writeSize;
+			data += writeSize;
+			size -= writeSize;
+		}
+	}
+
+	// Every part is published at once.
+	output->tail.store(tail, memory_order_release);
+	notify(output->dataSequence, output->consumerWaiting);
+
+	return true;
+}
+
+void ShmTransport::interrupt()
+{
+	if(segment == nullptr)
+	{
+		return;
+	}
+
+	interrupted.store(true, memory_order_release);
+
+	// The words of the ring belong to the other side, the reader also
+	// waits on this one
+	wakeSequence.fetch_add(1, memory_order_seq_cst);
+	futexWake(wakeSequence, FUTEX_WAKE_PRIVATE);
+
+	// Without futex_waitv it only sleeps on the ring. Waking it doesn't
+	// change the word, a lost wake up waits a peer check period.
+	futexWake(input->dataSequence);
+}
+
+void ShmTransport::close()
+{
+	if(segment == nullptr)
+	{
+		return;
+	}
+
+	lock_guard<mutex> lock(outputMutex);
+
+	output->closed.store(1, memory_order_release);
+	notify(output->dataSequence, output->consumerWaiting);
+}
+
+}
@@ -0,0 +1,528 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <libclsp/server/socketServer.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace clsp
+{
+
+using namespace std;
+
+SocketTransport::SocketTransport(int socketFd, int epollFd,
+	size_t maxPending):
+	socketFd(socketFd),
+	epollFd(epollFd),
+	maxPending(maxPending)
+{};
+
+SocketTransport::~SocketTransport(){};
+
+void SocketTransport::watch(bool writable)
+{
+	epoll_event event{};
+
+	event.events  = EPOLLIN;
+	event.data.fd = socketFd;
+
+	if(writable)
+	{
+		event.events |= EPOLLOUT;
+	}
+
+	epoll_ctl(epollFd, EPOLL_CTL_MOD, socketFd, &event);
+}
+
+bool SocketTransport::keep(const char* first, const char* last)
+{
+	if(pending.size() + (last - first) <= maxPending)
+	{
+		pending.insert(pending.end(), first, last);
+		return true;
+	}
+
+	vector<char>().swap(pending);
+	dropped = true;
+
+	shutdown(socketFd, SHUT_RDWR);
+
+	return false;
+}
+
+ssize_t SocketTransport::read(char* buffer, size_t size)
+{
+	ssize_t resu;
+
+	do
+	{
+		resu = recv(socketFd, buffer, size, 0);
+	}
+	while(resu < 0 && errno == EINTR);
+
+	return resu;
+}
+
+void SocketTransport::interrupt()
+{
+	shutdown(socketFd, SHUT_RD);
+}
+
+bool SocketTransport::write(const char* data, size_t size)
+{
+	iovec part{(void*)data, size};
+
+	return writev(&part, 1);
+}
+
+bool SocketTransport::writev(const iovec* parts, size_t count)
+{
+	lock_guard lock(pendingMutex);
+
+	if(dropped)
+	{
+		return false;
+	}
+
+	// The order of the bytes must be kept
+	bool blocked = !pending.empty();
+
+	while(count > 0 && !blocked)
+	{
+		msghdr message{};
+
+		message.msg_iov    = (iovec*)parts;
+		message.msg_iovlen = min<size_t>(count, IOV_MAX);
+
+		ssize_t written = sendmsg(socketFd, &message, MSG_NOSIGNAL);
+
+		if(written < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+
+			if(errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				blocked = true;
+				break;
+			}
+
+			return false;
+		}
+
+		// Skips the parts written
+		while(count > 0 && (size_t)written >= parts->iov_len)
+		{
+			written -= parts->iov_len;
+
+			parts++;
+			count--;
+		}
+
+		// The rest of a part written partially waits
+		if(written > 0)
+		{
+			const char* rest = (const char*)parts->iov_base + written;
+
+			if(!keep(rest, (const char*)parts->iov_base + parts->iov_len))
+			{
+				return false;
+			}
+
+			parts++;
+			count--;
+
+			blocked = true;
+		}
+	}
+
+	for(size_t i = 0; i < count; i++)
+	{
+		const char* part = (const char*)parts[i].iov_base;
+
+		if(!keep(part, part + parts[i].iov_len))
+		{
+			return false;
+		}
+	}
+
+	if(!pending.empty())
+	{
+		watch(true);
+	}
+
+	return true;
+}
+
+bool SocketTransport::flush()
+{
+	lock_guard lock(pendingMutex);
+
+	size_t sent = 0;
+
+	while(sent < pending.size())
+	{
+		ssize_t written = send(socketFd, pending.data() + sent,
+			pending.size() - sent, MSG_NOSIGNAL);
+
+		if(written < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+
+			if(errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				break;
+			}
+
+			return false;
+		}
+
+		sent += written;
+	}
+
+	pending.erase(pending.begin(), pending.begin() + sent);
+
+	if(pending.empty())
+	{
+		watch(false);
+	}
+
+	return true;
+}
+
+
+SocketServer::SocketServer(function<unique_ptr<Server>()> serverMaker):
+	serverMaker(serverMaker),
+	epollFd(epoll_create1(EPOLL_CLOEXEC)),
+	wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+	epoll_event event{};
+
+	event.events  = EPOLLIN;
+	event.data.fd = wakeFd;
+
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+	reaper = thread(&SocketServer::reap, this);
+};
+
+SocketServer::SocketServer(Server& host):
+	SocketServer([&host]()
+	{
+		return host.openSession();
+	})
+{};
+
+SocketServer::~SocketServer()
+{
+	while(!connections.empty())
+	{
+		close(connections.begin()->first);
+	}
+
+	closedMutex.lock();
+	reaping = false;
+	closedMutex.unlock();
+
+	closedCondition.notify_one();
+	reaper.join();
+
+	for(int listenFd: listenFds)
+	{
+		::close(listenFd);
+	}
+
+	::close(wakeFd);
+	::close(epollFd);
+};
+
+void SocketServer::setMaxPending(size_t size)
+{
+	maxPending = size;
+}
+
+bool SocketServer::startListening(int socketFd)
+{
+	epoll_event event{};
+
+	event.events  = EPOLLIN;
+	event.data.fd = socketFd;
+
+	if(listen(socketFd, SOMAXCONN) < 0 ||
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, socketFd, &event) < 0)
+	{
+		::close(socketFd);
+		return false;
+	}
+
+	listenFds.push_back(socketFd);
+
+	return true;
+}
+
+int SocketServer::listenTcp(uint16_t port)
+{
+	int socketFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+	if(socketFd < 0)
+	{
+		return -1;
+	}
+
+	int reuse = 1;
+	setsockopt(socketFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	sockaddr_in address{};
+
+	address.sin_family      = AF_INET;
+	address.sin_port        = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	socklen_t addressSize = sizeof(address);
+
+	if(bind(socketFd, (sockaddr*)&address, addressSize) < 0 ||
+		getsockname(socketFd, (sockaddr*)&address, &addressSize) < 0)
+	{
+		::close(socketFd);
+		return -1;
+	}
+
+	if(!startListening(socketFd))
+	{
+		return -1;
+	}
+
+	return ntohs(address.sin_port);
+}
+
+bool SocketServer::listenUnix(String path)
+{
+	sockaddr_un address{};
+
+	if(path.size() >= sizeof(address.sun_path))
+	{
+		return false;
+	}
+
+	int socketFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+	if(socketFd < 0)
+	{
+		return false;
+	}
+
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, path.c_str());
+
+	unlink(path.c_str());
+
+	if(bind(socketFd, (sockaddr*)&address, sizeof(address)) < 0)
+	{
+		::close(socketFd);
+		return false;
+	}
+
+	return startListening(socketFd);
+}
+
+void SocketServer::accept(int listenFd)
+{
+	while(true)
+	{
+		int socketFd = accept4(listenFd, nullptr, nullptr,
+			SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+		if(socketFd < 0)
+		{
+			// EAGAIN when there are no more clients
+			return;
+		}
+
+		auto server = serverMaker();
+
+		if(server == nullptr)
+		{
+			::close(socketFd);
+			continue;
+		}
+
+		epoll_event event{};
+
+		event.events  = EPOLLIN;
+		event.data.fd = socketFd;
+
+		auto& connection = connections[socketFd];
+
+		connection.transport = make_unique<SocketTransport>(socketFd, epollFd,
+			maxPending);
+		connection.server    = move(server);
+
+		connection.server->connect(*connection.transport);
+
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, socketFd, &event);
+	}
+}
+
+void SocketServer::close(int socketFd)
+{
+	auto connection = connections.find(socketFd);
+
+	if(connection != connections.end())
+	{
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, socketFd, nullptr);
+
+		// The socket stays open until the session ends, so its number
+		// isn't given to a new client while the old responses are written.
+		closedMutex.lock();
+		closed.emplace_back(socketFd, move(connection->second));
+		closedMutex.unlock();
+
+		closedCondition.notify_one();
+
+		connections.erase(connection);
+	}
+}
+
+void SocketServer::reap()
+{
+	unique_lock lock(closedMutex);
+
+	while(true)
+	{
+		closedCondition.wait(lock, [this]()
+		{
+			return !closed.empty() || !reaping;
+		});
+
+		if(closed.empty())
+		{
+			return;
+		}
+
+		auto batch = move(closed);
+		closed.clear();
+
+		lock.unlock();
+
+		for(auto& [socketFd, connection]: batch)
+		{
+			connection.server->disconnect();
+			connection.server.reset();
+			connection.transport.reset();
+
+			::close(socketFd);
+		}
+
+		batch.clear();
+
+		lock.lock();
+	}
+}
+
+void SocketServer::run()
+{
+	constexpr int maxEvents = 64;
+
+	epoll_event events[maxEvents];
+
+	running = true;
+
+	while(running)
+	{
+		int count = epoll_wait(epollFd, events, maxEvents, -1);
+
+		if(count < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		for(int i = 0; i < count; i++)
+		{
+			int fd = events[i].data.fd;
+
+			if(fd == wakeFd)
+			{
+				uint64_t value;
+				::read(wakeFd, &value, sizeof(value));
+
+				continue;
+			}
+
+			if(find(listenFds.begin(), listenFds.end(), fd) != listenFds.end())
+			{
+				accept(fd);
+				continue;
+			}
+
+			auto connection = connections.find(fd);
+
+			// Closed by an earlier event
+			if(connection == connections.end())
+			{
+				continue;
+			}
+
+			bool alive = true;
+
+			if(events[i].events & EPOLLOUT)
+			{
+				alive = connection->second.transport->flush();
+			}
+
+			if(alive && events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+			{
+				alive = connection->second.server->readInput();
+			}
+
+			if(!alive)
+			{
+				close(fd);
+			}
+		}
+	}
+}
+
+void SocketServer::stop()
+{
+	running = false;
+
+	uint64_t value = 1;
+	::write(wakeFd, &value, sizeof(value));
+}
+
+}
@@ -0,0 +1,130 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/strand.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+Strand::Strand(ThreadPool& pool, function<void(bool)> finishHandler):
+	pool(pool),
+	finishHandler(finishHandler)
+{};
+
+Strand::~Strand(){};
+
+void Strand::post(ThreadPool::Task task, bool shared, Priority priority,
+	optional<ThreadPool::Clock::time_point> deadline)
+{
+	lock_guard lock(strandMutex);
+
+	queue.push_back({move(task), shared, priority, deadline});
+
+	startReady();
+}
+
+bool Strand::idle() const
+{
+	lock_guard lock(strandMutex);
+
+	return queue.empty() && sharedRunning == 0 && !exclusiveRunning;
+}
+
+void Strand::startReady()
+{
+	// The tasks started now go before the urgent ones behind them
+	Priority priority = Priority::background;
+	optional<ThreadPool::Clock::time_point> deadline;
+
+	for(auto& entry: queue)
+	{
+		priority = min(priority, entry.priority);
+
+		if(entry.deadline.has_value())
+		{
+			deadline = min(deadline.value_or(*entry.deadline), *entry.deadline);
+		}
+	}
+
+	while(!queue.empty() && !exclusiveRunning)
+	{
+		Entry& entry = queue.front();
+
+		if(entry.shared)
+		{
+			sharedRunning++;
+		}
+		else if(sharedRunning == 0)
+		{
+			exclusiveRunning = true;
+		}
+		else
+		{
+			// It waits for the shared ones before it
+			break;
+		}
+
+		pool.submit([self = shared_from_this(), task = move(entry.task),
+			shared = entry.shared]()
+		{
+			// The strand must not stay busy, the pool logs the exception
+			try
+			{
+				task();
+			}
+			catch(...)
+			{
+				self->finish(shared);
+				throw;
+			}
+
+			self->finish(shared);
+		}, priority, deadline);
+
+		queue.pop_front();
+	}
+}
+
+void Strand::finish(bool shared)
+{
+	bool nowIdle;
+
+	{
+		lock_guard lock(strandMutex);
+
+		if(shared)
+		{
+			sharedRunning--;
+		}
+		else
+		{
+			exclusiveRunning = false;
+		}
+
+		startReady();
+
+		nowIdle = queue.empty() && sharedRunning == 0 && !exclusiveRunning;
+	}
+
+	if(finishHandler)
+	{
+		finishHandler(nowIdle);
+	}
+}
+
+}
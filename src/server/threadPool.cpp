@@ -0,0 +1,358 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/threadPool.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace clsp
+{
+
+using namespace std;
+
+ThreadPool::ThreadPool(size_t workers)
+{
+	workers = max<size_t>(workers, 1);
+
+	for(size_t i = 0; i < workers; i++)
+	{
+		this->workers.push_back(make_unique<Worker>());
+	}
+
+	// After the vector is complete, the workers steal from each other
+	for(size_t i = 0; i < workers; i++)
+	{
+		this->workers[i]->runner = thread(&ThreadPool::work, this, i);
+	}
+};
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard lock(sleepMutex);
+
+		stopping = true;
+	}
+
+	sleepCondition.notify_all();
+
+	for(auto& worker: workers)
+	{
+		worker->runner.join();
+	}
+};
+
+ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool(max(thread::hardware_concurrency(), 2u));
+
+	return pool;
+}
+
+ThreadPool& ThreadPool::blocking()
+{
+	static ThreadPool pool(max(thread::hardware_concurrency(), 2u) * 2);
+
+	return pool;
+}
+
+size_t ThreadPool::size() const
+{
+	return workers.size();
+}
+
+void ThreadPool::push(size_t worker, Task task, Priority priority,
+	optional<Clock::time_point> deadline)
+{
+	size_t index = static_cast<size_t>(priority);
+
+	Entry entry{move(task), Clock::now(),
+		deadline.value_or(Clock::time_point::max())};
+
+	Worker& owner = *workers[worker];
+
+	{
+		lock_guard lock(owner.dequeMutex);
+
+		auto& tasks = owner.tasks[index];
+
+		// Most tasks have no deadline and go at the back
+		if(tasks.empty() || tasks.back().deadline <= entry.deadline)
+		{
+			tasks.push_back(move(entry));
+		}
+		else
+		{
+			auto position = upper_bound(tasks.begin(), tasks.end(), entry,
+				[](const Entry& a, const Entry& b)
+				{
+					return a.deadline < b.deadline;
+				});
+
+			tasks.insert(position, move(entry));
+		}
+
+		// A sleeping worker either sees the task or this sees it sleeping.
+		owner.queued++;
+	}
+
+	if(sleepers > 0)
+	{
+		lock_guard lock(sleepMutex);
+
+		sleepCondition.notify_one();
+	}
+}
+
+bool ThreadPool::hasTasks() const
+{
+	for(auto& worker: workers)
+	{
+		if(worker->queued > 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+optional<ThreadPool::Task> ThreadPool::takeAged(Worker& worker,
+	Clock::time_point now)
+{
+	// The oldest class first, the interactive tasks never wait anyway
+	for(size_t priority = priorityCount - 1; priority > 0; priority--)
+	{
+		auto& tasks = worker.tasks[priority];
+
+		// The tasks with a deadline come first and can hide older ones. The
+		// ones without it are in order, only the first of them is checked.
+		for(auto entry = tasks.begin(); entry != tasks.end(); entry++)
+		{
+			if(now - entry->submitted > agingLimit[priority])
+			{
+				Task task = move(entry->task);
+				tasks.erase(entry);
+
+				worker.queued--;
+
+				return task;
+			}
+
+			if(entry->deadline == Clock::time_point::max())
+			{
+				break;
+			}
+		}
+	}
+
+	return nullopt;
+}
+
+optional<ThreadPool::Task> ThreadPool::steal(size_t worker)
+{
+	size_t count = workers.size();
+
+	for(size_t priority = 0; priority < priorityCount; priority++)
+	{
+		for(size_t i = 1; i < count; i++)
+		{
+			Worker& victim = *workers[(worker + i) % count];
+
+			if(victim.queued.load(memory_order_relaxed) == 0)
+			{
+				continue;
+			}
+
+			lock_guard lock(victim.dequeMutex);
+
+			auto& tasks = victim.tasks[priority];
+
+			// The owner takes the front, so the back is rarely contended
+			if(!tasks.empty())
+			{
+				Task task = move(tasks.back().task);
+				tasks.pop_back();
+
+				victim.queued--;
+
+				return task;
+			}
+		}
+	}
+
+	return nullopt;
+}
+
+optional<ThreadPool::Task> ThreadPool::take(size_t worker)
+{
+	Worker& owner = *workers[worker];
+
+	if(owner.queued.load(memory_order_relaxed) > 0)
+	{
+		lock_guard lock(owner.dequeMutex);
+
+		if(auto task = takeAged(owner, Clock::now()))
+		{
+			return task;
+		}
+
+		for(auto& tasks: owner.tasks)
+		{
+			if(!tasks.empty())
+			{
+				Task task = move(tasks.front().task);
+				tasks.pop_front();
+
+				owner.queued--;
+
+				return task;
+			}
+		}
+	}
+
+	return steal(worker);
+}
+
+void ThreadPool::work(size_t worker)
+{
+	currentPool = this;
+	currentWorker = worker;
+
+	while(true)
+	{
+		if(auto task = take(worker))
+		{
+			execute(*task);
+			continue;
+		}
+
+		unique_lock lock(sleepMutex);
+
+		sleepers++;
+
+		sleepCondition.wait(lock, [this]()
+		{
+			return stopping || hasTasks();
+		});
+
+		sleepers--;
+
+		if(stopping && !hasTasks())
+		{
+			return;
+		}
+	}
+}
+
+void ThreadPool::execute(Task& task)
+{
+	try
+	{
+		task();
+	}
+	catch(const exception& error)
+	{
+		cerr << "libclsp: a task threw: " << error.what() << endl;
+	}
+	catch(...)
+	{
+		cerr << "libclsp: a task threw" << endl;
+	}
+}
+
+void ThreadPool::submit(Task task, Priority priority,
+	optional<Clock::time_point> deadline)
+{
+	if(currentPool == this)
+	{
+		push(currentWorker, move(task), priority, deadline);
+	}
+	else
+	{
+		push(nextWorker++ % workers.size(), move(task), priority, deadline);
+	}
+}
+
+void ThreadPool::run(vector<Task>& tasks, Priority priority)
+{
+	atomic<size_t> remaining = tasks.size();
+
+	mutex doneMutex;
+	condition_variable doneCondition;
+
+	bool worker = currentPool == this;
+
+	for(auto& task: tasks)
+	{
+		submit([this, &task, &remaining, &doneMutex, &doneCondition, worker]()
+		{
+			task();
+
+			// The waiter can't return before the mutex is released
+			lock_guard lock(doneMutex);
+
+			if(--remaining == 0)
+			{
+				doneCondition.notify_all();
+
+				// The worker waits with the sleeping ones
+				if(worker)
+				{
+					lock_guard sleepLock(sleepMutex);
+
+					sleepCondition.notify_all();
+				}
+			}
+		}, priority);
+	}
+
+	// A worker that waits would take one of the threads of its own tasks
+	if(worker)
+	{
+		while(remaining > 0)
+		{
+			if(auto task = take(currentWorker))
+			{
+				execute(*task);
+				continue;
+			}
+
+			unique_lock lock(sleepMutex);
+
+			// It's woken up by new tasks like the sleeping workers
+			sleepers++;
+
+			sleepCondition.wait(lock, [this, &remaining]()
+			{
+				return remaining == 0 || hasTasks();
+			});
+
+			sleepers--;
+		}
+	}
+
+	unique_lock lock(doneMutex);
+
+	doneCondition.wait(lock, [&remaining]()
+	{
+		return remaining == 0;
+	});
+}
+
+}
@@ -0,0 +1,124 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <libclsp/server/timerQueue.hpp>
+
+namespace clsp
+{
+
+using namespace std;
+
+TimerQueue::TimerQueue():
+	runner(&TimerQueue::run, this)
+{};
+
+TimerQueue::~TimerQueue()
+{
+	{
+		lock_guard lock(timersMutex);
+
+		stopping = true;
+	}
+
+	timersCondition.notify_all();
+
+	runner.join();
+};
+
+TimerQueue& TimerQueue::shared()
+{
+	static TimerQueue timers;
+
+	return timers;
+}
+
+uint64_t TimerQueue::schedule(Clock::time_point when,
+	function<void()> callback)
+{
+	uint64_t id;
+	bool first;
+
+	{
+		lock_guard lock(timersMutex);
+
+		id = ++lastId;
+
+		callbacks.emplace(id, move(callback));
+		auto timer = order.emplace(when, id);
+
+		first = timer == order.begin();
+	}
+
+	// The thread waits for an earlier time
+	if(first)
+	{
+		timersCondition.notify_all();
+	}
+
+	return id;
+}
+
+bool TimerQueue::cancel(uint64_t id)
+{
+	lock_guard lock(timersMutex);
+
+	// Its entry in order is skipped when it's due
+	return callbacks.erase(id) > 0;
+}
+
+void TimerQueue::run()
+{
+	unique_lock lock(timersMutex);
+
+	while(!stopping)
+	{
+		if(order.empty())
+		{
+			timersCondition.wait(lock);
+			continue;
+		}
+
+		auto next = order.begin();
+
+		if(next->first > Clock::now())
+		{
+			timersCondition.wait_until(lock, next->first);
+			continue;
+		}
+
+		uint64_t id = next->second;
+		order.erase(next);
+
+		auto timer = callbacks.find(id);
+
+		// Cancelled
+		if(timer == callbacks.end())
+		{
+			continue;
+		}
+
+		auto callback = move(timer->second);
+		callbacks.erase(timer);
+
+		lock.unlock();
+
+		callback();
+
+		lock.lock();
+	}
+}
+
+}
@@ -0,0 +1,214 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <libclsp/server/transport.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace clsp
+{
+
+using namespace std;
+
+Transport::Transport(){};
+Transport::~Transport(){};
+
+ssize_t Transport::lend(shared_ptr<char>&)
+{
+	errno = ENOTSUP;
+	return -1;
+}
+
+bool Transport::writev(const iovec* parts, size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		if(!write((const char*)parts[i].iov_base, parts[i].iov_len))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void Transport::interrupt()
+{
+}
+
+bool Transport::wait()
+{
+	return true;
+}
+
+
+FdTransport::FdTransport(int inFd, int outFd):
+	inFd(inFd),
+	outFd(outFd),
+	wakeFd(eventfd(0, EFD_CLOEXEC))
+{};
+
+FdTransport::FdTransport():
+	FdTransport(STDIN_FILENO, STDOUT_FILENO)
+{};
+
+FdTransport::~FdTransport()
+{
+	if(wakeFd >= 0)
+	{
+		close(wakeFd);
+	}
+};
+
+ssize_t FdTransport::read(char* buffer, size_t size)
+{
+	if(wakeFd >= 0)
+	{
+		pollfd fds[] = {
+			{inFd,   POLLIN, 0},
+			{wakeFd, POLLIN, 0}
+		};
+
+		while(poll(fds, 2, -1) < 0)
+		{
+			if(errno != EINTR)
+			{
+				return -1;
+			}
+		}
+
+		if(fds[1].revents & POLLIN)
+		{
+			return 0;
+		}
+	}
+
+	ssize_t resu;
+
+	do
+	{
+		resu = ::read(inFd, buffer, size);
+	}
+	while(resu < 0 && errno == EINTR);
+
+	return resu;
+}
+
+void FdTransport::interrupt()
+{
+	if(wakeFd >= 0)
+	{
+		uint64_t one = 1;
+
+		while(::write(wakeFd, &one, sizeof(one)) < 0 && errno == EINTR);
+	}
+}
+
+bool FdTransport::wait()
+{
+	pollfd fds[] = {
+		{inFd,   POLLIN, 0},
+		{wakeFd, POLLIN, 0}
+	};
+
+	// Without the eventfd only the input is polled
+	nfds_t count = wakeFd >= 0? 2: 1;
+
+	while(poll(fds, count, -1) < 0)
+	{
+		if(errno != EINTR)
+		{
+			return false;
+		}
+	}
+
+	return !(fds[1].revents & POLLIN);
+}
+
+bool FdTransport::write(const char* data, size_t size)
+{
+	while(size > 0)
+	{
+		ssize_t written = ::write(outFd, data, size);
+
+		if(written < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+
+			return false;
+		}
+
+		data += written;
+		size -= written;
+	}
+
+	return true;
+}
+
+bool FdTransport::writev(const iovec* parts, size_t count)
+{
+	while(count > 0)
+	{
+		ssize_t written = ::writev(outFd, parts, min<size_t>(count, IOV_MAX));
+
+		if(written < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+
+			return false;
+		}
+
+		// Skips the parts written
+		while(count > 0 && (size_t)written >= parts->iov_len)
+		{
+			written -= parts->iov_len;
+
+			parts++;
+			count--;
+		}
+
+		// The rest of a part written partially
+		if(written > 0)
+		{
+			if(!write((const char*)parts->iov_base + written,
+				parts->iov_len - written))
+			{
+				return false;
+			}
+
+			parts++;
+			count--;
+		}
+	}
+
+	return true;
+}
+
+}
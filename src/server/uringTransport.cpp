@@ -0,0 +1,831 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <libclsp/server/uringTransport.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace clsp
+{
+
+using namespace std;
+
+/// The user data of the poll of the wake up eventfd
+constexpr static uint64_t wakeTag = ~(uint64_t)0;
+
+/// The user data of the request that stops the completion thread
+constexpr static uint64_t stopTag = ~(uint64_t)1;
+
+/// IORING_OP_READ_MULTISHOT, Linux 6.7. Older headers don't have it.
+constexpr static uint8_t readMultishotOp = 49;
+
+/// The shared rings of an io_uring instance.
+/// There's no SQPOLL thread, so the kernel only reads the submission ring
+/// inside enter().
+struct UringTransport::Ring
+{
+	/// The io_uring descriptor
+	int fd = -1;
+
+	/// The memory with both rings
+	void* ringMemory = MAP_FAILED;
+	size_t ringSize = 0;
+
+	/// The submission entries
+	io_uring_sqe* sqes = (io_uring_sqe*)MAP_FAILED;
+	size_t sqesSize = 0;
+
+	// Submission ring
+	unsigned* sqHead;
+	unsigned* sqTail;
+	unsigned* sqArray;
+	unsigned sqMask;
+	unsigned sqEntries;
+
+	/// The tail with the entries not submitted yet
+	unsigned sqLocalTail;
+
+	// Completion ring
+	unsigned* cqHead;
+	unsigned* cqTail;
+	io_uring_cqe* cqes;
+	unsigned cqMask;
+
+	Ring(unsigned entries)
+	{
+		io_uring_params params{};
+
+		fd = syscall(__NR_io_uring_setup, entries, &params);
+
+		if(fd < 0)
+		{
+			return;
+		}
+
+		// Older kernels need one mmap per ring
+		if(!(params.features & IORING_FEAT_SINGLE_MMAP))
+		{
+			close(fd);
+			fd = -1;
+			return;
+		}
+
+		ringSize = max(
+			params.sq_off.array + params.sq_entries * sizeof(unsigned),
+			params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+
+		ringMemory = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+
+		sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+		sqes = (io_uring_sqe*)mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+
+		if(ringMemory == MAP_FAILED || sqes == MAP_FAILED)
+		{
+			close(fd);
+			fd = -1;
+			return;
+		}
+
+		char* memory = (char*)ringMemory;
+
+		sqHead    = (unsigned*)(memory + params.sq_off.head);
+		sqTail    = (unsigned*)(memory + params.sq_off.tail);
+		sqArray   = (unsigned*)(memory + params.sq_off.array);
+		sqMask    = *(unsigned*)(memory + params.sq_off.ring_mask);
+		sqEntries = params.sq_entries;
+
+		sqLocalTail = *sqTail;
+
+		cqHead = (unsigned*)(memory + params.cq_off.head);
+		cqTail = (unsigned*)(memory + params.cq_off.tail);
+		cqes   = (io_uring_cqe*)(memory + params.cq_off.cqes);
+		cqMask = *(unsigned*)(memory + params.cq_off.ring_mask);
+	}
+
+	~Ring()
+	{
+		if(sqes != MAP_FAILED)
+		{
+			munmap(sqes, sqesSize);
+		}
+
+		if(ringMemory != MAP_FAILED)
+		{
+			munmap(ringMemory, ringSize);
+		}
+
+		if(fd >= 0)
+		{
+			close(fd);
+		}
+	}
+
+	/// Returns a clean submission entry, or nullptr if the ring is full.
+	io_uring_sqe* next()
+	{
+		unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+
+		if(sqLocalTail - head >= sqEntries)
+		{
+			return nullptr;
+		}
+
+		unsigned index = sqLocalTail & sqMask;
+
+		sqArray[index] = index;
+		sqLocalTail++;
+
+		io_uring_sqe* sqe = &sqes[index];
+		memset(sqe, 0, sizeof(*sqe));
+
+		return sqe;
+	}
+
+	/// Submits the new entries and waits for minComplete completions.
+	/// Returns false on errors, with errno set.
+	bool enter(unsigned minComplete)
+	{
+		unsigned toSubmit = sqLocalTail - *sqTail;
+
+		__atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE);
+
+		unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+		while(true)
+		{
+			long submitted = syscall(__NR_io_uring_enter, fd, toSubmit,
+				minComplete, flags, nullptr, 0);
+
+			if(submitted >= 0)
+			{
+				return true;
+			}
+
+			if(errno != EINTR)
+			{
+				return false;
+			}
+
+			// The entries were not consumed by the interrupted call
+			toSubmit = sqLocalTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+		}
+	}
+
+	/// Waits for minComplete completions without submitting, so it can be
+	/// called while another thread fills the submission ring.
+	/// Returns false on errors, with errno set.
+	bool wait(unsigned minComplete)
+	{
+		while(syscall(__NR_io_uring_enter, fd, 0, minComplete,
+			IORING_ENTER_GETEVENTS, nullptr, 0) < 0)
+		{
+			if(errno != EINTR)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/// Takes the next completion. Returns false if there's none.
+	bool pop(io_uring_cqe& cqe)
+	{
+		unsigned head = *cqHead;
+
+		if(head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+		{
+			return false;
+		}
+
+		cqe = cqes[head & cqMask];
+
+		__atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+
+		return true;
+	}
+};
+
+
+UringTransport::UringTransport(int inFd, int outFd):
+	inputRing(make_unique<Ring>(bufferCount * 2)),
+	outputRing(make_unique<Ring>(64)),
+	inFd(inFd),
+	outFd(outFd)
+{
+	if(inputRing->fd < 0 || outputRing->fd < 0)
+	{
+		return;
+	}
+
+	void* memory = mmap(nullptr, bufferCount * bufferSize,
+		PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if(memory == MAP_FAILED)
+	{
+		return;
+	}
+
+	iovec buffers[bufferCount];
+
+	for(unsigned i = 0; i < bufferCount; i++)
+	{
+		buffers[i].iov_base = (char*)memory + i * bufferSize;
+		buffers[i].iov_len  = bufferSize;
+	}
+
+	// The registered buffers are the fallback of the buffer ring
+	if(syscall(__NR_io_uring_register, inputRing->fd,
+		IORING_REGISTER_BUFFERS, buffers, bufferCount) < 0)
+	{
+		munmap(memory, bufferCount * bufferSize);
+		return;
+	}
+
+	inputMemory = (char*)memory;
+
+	wakeFd = eventfd(0, EFD_CLOEXEC);
+
+	struct stat inStat;
+
+	socket = fstat(inFd, &inStat) == 0 && S_ISSOCK(inStat.st_mode);
+
+	bufferRing = mmap(nullptr, bufferCount * sizeof(io_uring_buf),
+		PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	io_uring_buf_reg registration{};
+
+	registration.ring_addr    = (uintptr_t)bufferRing;
+	registration.ring_entries = bufferCount;
+	registration.bgid         = 0;
+
+	if(bufferRing != MAP_FAILED &&
+		syscall(__NR_io_uring_register, inputRing->fd,
+			IORING_REGISTER_PBUF_RING, &registration, 1) == 0)
+	{
+		mode = InputMode::multishot;
+	}
+	else
+	{
+		// Kernels older than 5.19
+		if(bufferRing != MAP_FAILED)
+		{
+			munmap(bufferRing, bufferCount * sizeof(io_uring_buf));
+		}
+
+		bufferRing = nullptr;
+	}
+
+	for(unsigned i = 0; i < bufferCount; i++)
+	{
+		releaseBuffer(i);
+	}
+
+	completer = thread(&UringTransport::complete, this);
+};
+
+UringTransport::UringTransport():
+	UringTransport(STDIN_FILENO, STDOUT_FILENO)
+{};
+
+UringTransport::~UringTransport()
+{
+	if(completer.joinable())
+	{
+		unique_lock lock(outputMutex);
+
+		// The last responses are written before the transport ends
+		outputCondition.wait(lock, [this]()
+		{
+			return outputs.empty();
+		});
+
+		io_uring_sqe* sqe = outputRing->next();
+
+		sqe->opcode    = IORING_OP_NOP;
+		sqe->user_data = stopTag;
+
+		outputRing->enter(0);
+
+		lock.unlock();
+
+		completer.join();
+	}
+
+	// The rings are closed first, so the kernel stops using the buffers
+	inputRing.reset();
+	outputRing.reset();
+
+	if(bufferRing != nullptr)
+	{
+		munmap(bufferRing, bufferCount * sizeof(io_uring_buf));
+	}
+
+	if(inputMemory != nullptr)
+	{
+		munmap(inputMemory, bufferCount * bufferSize);
+	}
+
+	if(wakeFd >= 0)
+	{
+		close(wakeFd);
+	}
+};
+
+bool UringTransport::isValid() const
+{
+	return inputMemory != nullptr;
+}
+
+void UringTransport::releaseBuffer(unsigned buffer)
+{
+	if(mode == InputMode::fixed)
+	{
+		fixedBuffers.push_back(buffer);
+		return;
+	}
+
+	auto* ring = (io_uring_buf_ring*)bufferRing;
+
+	uint16_t tail = ring->tail;
+
+	io_uring_buf& entry = ring->bufs[tail & (bufferCount - 1)];
+
+	entry.addr = (uintptr_t)(inputMemory + buffer * bufferSize);
+	entry.len  = bufferSize;
+	entry.bid  = buffer;
+
+	__atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+
+	kernelBuffers++;
+}
+
+void UringTransport::releaseReturned()
+{
+	returnedMutex.lock();
+	auto buffers = move(returned);
+	returned.clear();
+	returnedMutex.unlock();
+
+	for(unsigned buffer: buffers)
+	{
+		releaseBuffer(buffer);
+	}
+}
+
+void UringTransport::unregisterBufferRing()
+{
+	io_uring_buf_reg registration{};
+
+	registration.bgid = 0;
+
+	syscall(__NR_io_uring_register, inputRing->fd,
+		IORING_UNREGISTER_PBUF_RING, &registration, 1);
+
+	munmap(bufferRing, bufferCount * sizeof(io_uring_buf));
+	bufferRing = nullptr;
+
+	// All the buffers were in the ring
+	mode = InputMode::fixed;
+	kernelBuffers = 0;
+
+	for(unsigned i = 0; i < bufferCount; i++)
+	{
+		releaseBuffer(i);
+	}
+}
+
+bool UringTransport::readAhead()
+{
+	releaseReturned();
+
+	bool noBuffer = mode == InputMode::fixed?
+		fixedBuffers.empty(): kernelBuffers == 0;
+
+	if(reading || inputEnd.has_value() || noBuffer)
+	{
+		return false;
+	}
+
+	io_uring_sqe* sqe = inputRing->next();
+
+	if(sqe == nullptr)
+	{
+		return false;
+	}
+
+	sqe->fd = inFd;
+
+	if(mode == InputMode::fixed)
+	{
+		unsigned buffer = fixedBuffers.front();
+		fixedBuffers.pop_front();
+
+		sqe->opcode    = IORING_OP_READ_FIXED;
+		sqe->addr      = (uintptr_t)(inputMemory + buffer * bufferSize);
+		sqe->len       = bufferSize;
+		sqe->off       = (uint64_t)-1;
+		sqe->buf_index = buffer;
+		sqe->user_data = buffer;
+	}
+	else
+	{
+		// The kernel picks the buffers, a multishot one keeps filling them
+		// until they run out
+		bool multishot = mode == InputMode::multishot;
+
+		if(socket)
+		{
+			sqe->opcode = IORING_OP_RECV;
+			sqe->ioprio = multishot? IORING_RECV_MULTISHOT: 0;
+		}
+		else
+		{
+			sqe->opcode = multishot? readMultishotOp: IORING_OP_READ;
+			sqe->len    = multishot? 0: bufferSize;
+			sqe->off    = (uint64_t)-1;
+		}
+
+		sqe->flags     = IOSQE_BUFFER_SELECT;
+		sqe->buf_group = 0;
+	}
+
+	reading = true;
+
+	return true;
+}
+
+void UringTransport::reap()
+{
+	io_uring_cqe cqe;
+
+	while(inputRing->pop(cqe))
+	{
+		// interrupt() was called
+		if(cqe.user_data == wakeTag)
+		{
+			inputEnd = 0;
+			continue;
+		}
+
+		optional<unsigned> buffer;
+
+		if(mode == InputMode::fixed)
+		{
+			reading = false;
+
+			buffer = cqe.user_data;
+		}
+		else
+		{
+			// The multishot read ended and must be submitted again
+			if(!(cqe.flags & IORING_CQE_F_MORE))
+			{
+				reading = false;
+			}
+
+			if(cqe.flags & IORING_CQE_F_BUFFER)
+			{
+				buffer = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+				kernelBuffers--;
+				ringUsed = true;
+			}
+
+			// Multishot receives need Linux 6.0 and multishot reads 6.7,
+			// the files that can't be polled don't have them either
+			if(mode == InputMode::multishot &&
+				(cqe.res == -EINVAL || cqe.res == -EBADFD))
+			{
+				mode = InputMode::single;
+				continue;
+			}
+
+			if(cqe.res == -ENOBUFS)
+			{
+				// The kernel never took a buffer of the full ring, it can't
+				// use them, like Linux 5.19 with receives
+				if(!ringUsed && kernelBuffers == bufferCount)
+				{
+					unregisterBufferRing();
+				}
+
+				// Otherwise they ran out, it's submitted again when one is
+				// back
+				continue;
+			}
+		}
+
+		if(cqe.res > 0 && buffer.has_value())
+		{
+			chunks.push_back({*buffer, 0, (size_t)cqe.res});
+			continue;
+		}
+
+		// Nothing was read into it
+		if(buffer.has_value())
+		{
+			releaseBuffer(*buffer);
+		}
+
+		if(cqe.res != -EAGAIN && cqe.res != -EINTR)
+		{
+			// End of the stream or an error
+			inputEnd = cqe.res;
+		}
+	}
+}
+
+bool UringTransport::waitChunk(ssize_t& result)
+{
+	reap();
+
+	while(chunks.empty())
+	{
+		if(inputEnd.has_value())
+		{
+			result = 0;
+
+			if(*inputEnd < 0)
+			{
+				errno = -*inputEnd;
+				result = -1;
+			}
+
+			return false;
+		}
+
+		readAhead();
+
+		// The buffers are lent, the reader releases them from another thread
+		if(!reading)
+		{
+			unique_lock lock(returnedMutex);
+
+			returnedCondition.wait(lock, [this]()
+			{
+				return !returned.empty() || interrupted;
+			});
+
+			if(interrupted)
+			{
+				inputEnd = 0;
+			}
+
+			continue;
+		}
+
+		// The wait also ends when interrupt() is called
+		if(wakeFd >= 0 && !wakePolled)
+		{
+			io_uring_sqe* sqe = inputRing->next();
+
+			if(sqe != nullptr)
+			{
+				sqe->opcode      = IORING_OP_POLL_ADD;
+				sqe->fd          = wakeFd;
+				sqe->poll_events = POLLIN;
+				sqe->user_data   = wakeTag;
+
+				wakePolled = true;
+			}
+		}
+
+		// Submits and waits in one call
+		if(!inputRing->enter(1))
+		{
+			result = -1;
+			return false;
+		}
+
+		reap();
+	}
+
+	// The kernel reads the next bytes while these are parsed. A multishot
+	// read is still in flight, so there's nothing to submit.
+	if(readAhead())
+	{
+		inputRing->enter(0);
+	}
+
+	return true;
+}
+
+ssize_t UringTransport::read(char* buffer, size_t size)
+{
+	ssize_t result;
+
+	if(!waitChunk(result))
+	{
+		return result;
+	}
+
+	Chunk& chunk = chunks.front();
+
+	size_t copied = min(size, chunk.end - chunk.begin);
+
+	memcpy(buffer, inputMemory + chunk.buffer * bufferSize + chunk.begin, copied);
+
+	chunk.begin += copied;
+
+	if(chunk.begin == chunk.end)
+	{
+		releaseBuffer(chunk.buffer);
+		chunks.pop_front();
+	}
+
+	return copied;
+}
+
+ssize_t UringTransport::lend(shared_ptr<char>& bytes)
+{
+	ssize_t result;
+
+	if(!waitChunk(result))
+	{
+		return result;
+	}
+
+	Chunk chunk = chunks.front();
+	chunks.pop_front();
+
+	// The buffer is given back by the thread that releases the last share
+	bytes = shared_ptr<char>(
+		inputMemory + chunk.buffer * bufferSize + chunk.begin,
+		[this, buffer = chunk.buffer](char*)
+		{
+			lock_guard lock(returnedMutex);
+
+			returned.push_back(buffer);
+			returnedCondition.notify_one();
+		});
+
+	return chunk.end - chunk.begin;
+}
+
+void UringTransport::interrupt()
+{
+	if(wakeFd >= 0)
+	{
+		uint64_t one = 1;
+
+		while(::write(wakeFd, &one, sizeof(one)) < 0 && errno == EINTR);
+	}
+
+	lock_guard lock(returnedMutex);
+
+	interrupted = true;
+	returnedCondition.notify_one();
+}
+
+bool UringTransport::write(const char* data, size_t size)
+{
+	iovec part{(void*)data, size};
+
+	return writev(&part, 1);
+}
+
+bool UringTransport::submitOutput()
+{
+	Output& output = outputs.front();
+
+	io_uring_sqe* sqe = outputRing->next();
+
+	if(sqe == nullptr)
+	{
+		return false;
+	}
+
+	sqe->opcode    = IORING_OP_WRITE;
+	sqe->fd        = outFd;
+	sqe->addr      = (uintptr_t)(output.bytes.data() + output.written);
+	sqe->len       = output.bytes.size() - output.written;
+	sqe->off       = (uint64_t)-1;
+	sqe->user_data = 0;
+
+	return outputRing->enter(0);
+}
+
+bool UringTransport::writev(const iovec* parts, size_t count)
+{
+	lock_guard lock(outputMutex);
+
+	if(outputFailed)
+	{
+		return false;
+	}
+
+	bool idle = outputs.empty();
+
+	// The parts wait together behind the write in flight
+	if(outputs.size() < 2)
+	{
+		outputs.emplace_back();
+	}
+
+	auto& bytes = outputs.back().bytes;
+
+	for(size_t i = 0; i < count; i++)
+	{
+		auto* first = (const char*)parts[i].iov_base;
+
+		bytes.insert(bytes.end(), first, first + parts[i].iov_len);
+	}
+
+	if(idle && !submitOutput())
+	{
+		outputFailed = true;
+		outputs.clear();
+
+		return false;
+	}
+
+	return true;
+}
+
+void UringTransport::complete()
+{
+	while(outputRing->wait(1))
+	{
+		lock_guard lock(outputMutex);
+
+		io_uring_cqe cqe;
+
+		while(outputRing->pop(cqe))
+		{
+			if(cqe.user_data == stopTag)
+			{
+				return;
+			}
+
+			if(outputs.empty())
+			{
+				continue;
+			}
+
+			if(cqe.res > 0)
+			{
+				Output& output = outputs.front();
+
+				// A short write is resumed where it stopped
+				output.written += cqe.res;
+
+				if(output.written == output.bytes.size())
+				{
+					outputs.pop_front();
+				}
+			}
+			else if(cqe.res != -EAGAIN && cqe.res != -EINTR)
+			{
+				outputFailed = true;
+				outputs.clear();
+			}
+
+			if(!outputs.empty() && !submitOutput())
+			{
+				outputFailed = true;
+				outputs.clear();
+			}
+		}
+
+		if(outputs.empty())
+		{
+			outputCondition.notify_all();
+		}
+	}
+
+	// The ring can't be waited on anymore
+	lock_guard lock(outputMutex);
+
+	outputFailed = true;
+	outputs.clear();
+	outputCondition.notify_all();
+}
+
+}
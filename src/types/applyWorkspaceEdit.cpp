@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String ApplyWorkspaceEditParams::labelKey = "label";
-const String ApplyWorkspaceEditParams::editKey  = "edit";
-
 ApplyWorkspaceEditParams::ApplyWorkspaceEditParams(optional<String> label,
 	WorkspaceEdit edit):
 		label(label),
@@ -48,9 +45,6 @@ void ApplyWorkspaceEditParams::partialWrite(JsonWriter &writer)
 }
 
 
-const String ApplyWorkspaceEditResponse::appliedKey       = "applied";
-const String ApplyWorkspaceEditResponse::failureReasonKey = "failureReason";
-
 ApplyWorkspaceEditResponse::ApplyWorkspaceEditResponse(Boolean applied,
 	optional<String> failureReason):
 		applied(applied),
@@ -21,8 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String CancelParams::idKey = "id";
-
 CancelParams::CancelParams(variant<Number, String> id):
 	id(id)
 {};
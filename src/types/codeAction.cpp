@@ -36,15 +36,6 @@ const CodeActionKind
 	CodeActionKind::SourceOrganizeImports = "source.organizeImports"s;
 
 
-const String CodeActionClientCapabilities::
-	dynamicRegistrationKey      = "dynamicRegistration";
-
-const String CodeActionClientCapabilities::
-	codeActionLiteralSupportKey = "codeActionLiteralSupport";
-
-const String CodeActionClientCapabilities::
-	isPreferredSupportKey       = "isPreferredSupport";
-
 CodeActionClientCapabilities::
 	CodeActionClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<CodeActionLiteralSupport> codeActionLiteralSupport,
@@ -156,9 +147,6 @@ void CodeActionClientCapabilities::
 }
 
 
-const String CodeActionClientCapabilities::CodeActionLiteralSupport::
-	codeActionKindKey = "codeActionKind";
-
 CodeActionClientCapabilities::CodeActionLiteralSupport::
 	CodeActionLiteralSupport(CodeActionKind codeActionKind):
 		codeActionKind(codeActionKind)
@@ -220,11 +208,6 @@ void CodeActionClientCapabilities::CodeActionLiteralSupport::
 	initializer.object = this;
 }
 
-const String CodeActionClientCapabilities::
-	CodeActionLiteralSupport::
-	CodeActionKind::
-		valueSetKey = "valueSet";
-
 CodeActionClientCapabilities::CodeActionLiteralSupport::CodeActionKind::
 	CodeActionKind(vector<clsp::CodeActionKind> valueSet):
 		valueSet(valueSet)
@@ -346,8 +329,6 @@ void CodeActionClientCapabilities::
 }
 
 
-const String CodeActionOptions::codeActionKindsKey = "codeActionKinds";
-
 CodeActionOptions::CodeActionOptions(optional<Boolean> workDoneProgress,
 	optional<vector<CodeActionKind>> codeActionKinds):
 		WorkDoneProgressOptions(workDoneProgress),
@@ -395,9 +376,6 @@ void CodeActionRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String CodeActionContext::diagnosticsKey = "diagnostics";
-const String CodeActionContext::onlyKey = "only";
-
 CodeActionContext::CodeActionContext(vector<Diagnostic> diagnostics,
 	optional<vector<CodeActionKind>> only):
 		diagnostics(diagnostics),
@@ -591,10 +569,6 @@ void CodeActionContext::OnlyMaker::
 }
 
 
-const String CodeActionParams::textDocumentKey = "textDocument";
-const String CodeActionParams::rangeKey        = "range";
-const String CodeActionParams::contextKey      = "context";
-
 CodeActionParams::CodeActionParams(optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
 	TextDocumentIdentifier textDocument,
@@ -726,13 +700,6 @@ void CodeActionParams::fillInitializer(ObjectInitializer& initializer)
 }
 
 
-const String CodeAction::titleKey       = "title";
-const String CodeAction::kindKey        = "kind";
-const String CodeAction::diagnosticsKey = "diagnostics";
-const String CodeAction::isPreferredKey = "isPreferred";
-const String CodeAction::editKey        = "edit";
-const String CodeAction::commandKey     = "command";
-
 CodeAction::CodeAction(String title,
 	optional<CodeActionKind> kind,
 	optional<vector<Diagnostic>> diagnostics,
@@ -21,10 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String CodeLensClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-
 CodeLensClientCapabilities::
 	CodeLensClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -70,8 +66,6 @@ void CodeLensClientCapabilities::fillInitializer(ObjectInitializer& initializer)
 	initializer.object = this;
 }
 
-const String CodeLensOptions::resolveProviderKey = "resolveProvider";
-
 CodeLensOptions::CodeLensOptions(optional<Boolean> workDoneProgress,
 	optional<Boolean> resolveProvider):
 		WorkDoneProgressOptions(workDoneProgress),
@@ -115,8 +109,6 @@ void CodeLensRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String CodeLensParams::textDocumentKey = "textDocument";
-
 CodeLensParams::CodeLensParams(optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
 	TextDocumentIdentifier textDocument):
@@ -179,10 +171,6 @@ void CodeLensParams::fillInitializer(ObjectInitializer& initializer)
 	initializer.object = this;
 }
 
-const String CodeLens::rangeKey   = "range";
-const String CodeLens::commandKey = "command";
-const String CodeLens::dataKey    = "data";
-
 CodeLens::CodeLens(Range range,
 	optional<Command> command,
 	optional<Any> data):
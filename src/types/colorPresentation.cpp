@@ -21,10 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String ColorPresentationParams::textDocumentKey = "textDocument";
-const String ColorPresentationParams::colorKey        = "color";
-const String ColorPresentationParams::rangeKey        = "range";
-
 ColorPresentationParams::ColorPresentationParams(optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
 	TextDocumentIdentifier textDocument,
@@ -156,10 +152,6 @@ void ColorPresentationParams::fillInitializer(ObjectInitializer& initializer)
 }
 
 
-const String ColorPresentation::labelKey               = "label";
-const String ColorPresentation::textEditKey            = "textEdit";
-const String ColorPresentation::additionalTextEditsKey = "additionalTextEdits";
-
 ColorPresentation::ColorPresentation(String label,
 	optional<TextEdit> textEdit,
 	optional<vector<TextEdit>> additionalTextEdits):
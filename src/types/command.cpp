@@ -22,10 +22,6 @@ namespace clsp
 
 using namespace std;
 
-const String Command::titleKey     = "title";
-const String Command::commandKey   = "command";
-const String Command::argumentsKey = "arguments";
-
 Command::Command(String title, String command, optional<Array> arguments):
 	title(title),
 	command(command),
@@ -22,10 +22,6 @@ namespace clsp
 
 using namespace std;
 
-const String CompletionOptions::triggerCharactersKey   = "triggerCharacters";
-const String CompletionOptions::allCommitCharactersKey = "allCommitCharacters";
-const String CompletionOptions::resolveProviderKey     = "resolveProvider";
-
 CompletionOptions::CompletionOptions(optional<Boolean> workDoneProgress,
 	optional<vector<String>> triggerCharacters,
 	optional<vector<String>> allCommitCharacters,
@@ -102,9 +98,6 @@ void CompletionRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String CompletionContext::triggerKindKey      = "triggerKind";
-const String CompletionContext::triggerCharacterKey = "triggerCharacter";
-
 CompletionContext::CompletionContext(CompletionTriggerKind triggerKind,
 	optional<String> triggerCharacter):
 		triggerKind(triggerKind),
@@ -194,8 +187,6 @@ void CompletionContext::fillInitializer(ObjectInitializer& initializer)
 	initializer.object = this;
 }
 
-const String CompletionParams::contextKey = "context";
-
 CompletionParams::CompletionParams(TextDocumentIdentifier textDocument,
 	Position position,
 	optional<ProgressToken> workDoneToken,
@@ -261,23 +252,6 @@ void CompletionParams::fillInitializer(ObjectInitializer& initializer)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
-const String CompletionItem::labelKey               = "label";
-const String CompletionItem::kindKey                = "kind";
-const String CompletionItem::tagsKey                = "tags";
-const String CompletionItem::detailKey              = "detail";
-const String CompletionItem::documentationKey       = "documentation";
-const String CompletionItem::deprecatedKey          = "deprecated";
-const String CompletionItem::preselectKey           = "preselect";
-const String CompletionItem::sortTextKey            = "sortText";
-const String CompletionItem::filterTextKey          = "filterText";
-const String CompletionItem::insertTextKey          = "insertText";
-const String CompletionItem::insertTextFormatKey    = "insertTextFormat";
-const String CompletionItem::textEditKey            = "textEdit";
-const String CompletionItem::additionalTextEditsKey = "additionalTextEdits";
-const String CompletionItem::commitCharactersKey    = "commitCharacters";
-const String CompletionItem::commandKey             = "command";
-const String CompletionItem::dataKey                = "data";
-
 CompletionItem::CompletionItem(String label,
 	optional<CompletionItemKind> kind,
 	optional<vector<CompletionItemTag>> tags,
@@ -1067,9 +1041,6 @@ void CompletionItem::CommitCharactersMaker::fillInitializer(ObjectInitializer& i
 }
 
 
-const String CompletionList::isIncompleteKey = "isIncomplete";
-const String CompletionList::itemsKey        = "items";
-
 CompletionList::CompletionList(Boolean isIncomplete,
 	vector<CompletionItem> items):
 		isIncomplete(isIncomplete),
@@ -1095,18 +1066,6 @@ void CompletionList::partialWrite(JsonWriter &writer)
 	writer.EndArray();
 }
 
-const String CompletionClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String CompletionClientCapabilities::
-	completionItemKey      = "completionItem";
-
-const String CompletionClientCapabilities::
-	completionItemKindKey  = "completionItemKind";
-
-const String CompletionClientCapabilities::
-	contextSupportKey      = "contextSupport";
-
 CompletionClientCapabilities::
 	CompletionClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<CompletionItem> completionItem,
@@ -1248,24 +1207,6 @@ void CompletionClientCapabilities::fillInitializer(ObjectInitializer& initialize
 }
 
 
-const String CompletionClientCapabilities::CompletionItem::
-	snippetSupportKey          = "snippetSupport";
-
-const String CompletionClientCapabilities::CompletionItem::
-	commitCharactersSupportKey = "commitCharactersSupport";
-
-const String CompletionClientCapabilities::CompletionItem::
-	documentationFormatKey     = "documentationFormat";
-
-const String CompletionClientCapabilities::CompletionItem::
-	deprecatedSupportKey       = "deprecatedSupport";
-
-const String CompletionClientCapabilities::CompletionItem::
-	preselectSupportKey        = "preselectSupport";
-
-const String CompletionClientCapabilities::CompletionItem::
-	tagSupportKey              = "tagSupport";
-
 CompletionClientCapabilities::CompletionItem::
 	CompletionItem(optional<Boolean> snippetSupport,
 		optional<Boolean> commitCharactersSupport,
@@ -1519,9 +1460,6 @@ void CompletionClientCapabilities::CompletionItem::DocumentationFormatMaker::
 }
 
 
-const string CompletionClientCapabilities::CompletionItem::TagSupport::
-	valueSetKey = "valueSet";
-
 CompletionClientCapabilities::CompletionItem::TagSupport::
 	TagSupport(vector<CompletionItemTag> valueSet):
 		valueSet(valueSet)
@@ -1639,9 +1577,6 @@ void CompletionClientCapabilities::CompletionItem::TagSupport::ValueSetMaker::
 	initializer.object = this;
 }
 
-const String CompletionClientCapabilities::CompletionItemKind::
-	valueSetKey = "valueSet";
-
 CompletionClientCapabilities::CompletionItemKind::
 	CompletionItemKind(optional<vector<clsp::CompletionItemKind>> valueSet):
 		valueSet(valueSet)
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String ConfigurationItem::scopeUriKey = "scopeUri";
-const String ConfigurationItem::sectionKey  = "section";
-
 ConfigurationItem::ConfigurationItem(optional<DocumentUri> scopeUri,
 	optional<String> section):
 		scopeUri(scopeUri),
@@ -51,8 +48,6 @@ void ConfigurationItem::partialWrite(JsonWriter &writer)
 }
 
 
-const String ConfigurationParams::itemsKey = "items";
-
 ConfigurationParams::ConfigurationParams(vector<ConfigurationItem> items):
 	items(items)
 {};
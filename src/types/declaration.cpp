@@ -21,12 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DeclarationClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String DeclarationClientCapabilities::
-	linkSupportKey         = "linkSupport";
-
 DeclarationClientCapabilities::
 	DeclarationClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<Boolean> linkSupport):
@@ -21,12 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DefinitionClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String DefinitionClientCapabilities::
-	linkSupportKey         = "linkSupport";
-
 DefinitionClientCapabilities::
 	DefinitionClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<Boolean> linkSupport):
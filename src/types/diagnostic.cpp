@@ -21,14 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String Diagnostic::rangeKey              = "range";
-const String Diagnostic::severityKey           = "severity";
-const String Diagnostic::codeKey               = "code";
-const String Diagnostic::sourceKey             = "source";
-const String Diagnostic::messageKey            = "message";
-const String Diagnostic::tagsKey               = "tags";
-const String Diagnostic::relatedInformationKey = "relatedInformation";
-
 Diagnostic::Diagnostic(Range range,
 	optional<DiagnosticSeverity> severity,
 	optional<variant<Number, String>> code,
@@ -451,9 +443,6 @@ void Diagnostic::RelatedInformationMaker::
 }
 
 
-const String DiagnosticRelatedInformation::locationKey = "location";
-const String DiagnosticRelatedInformation::messageKey  = "message";
-
 DiagnosticRelatedInformation::DiagnosticRelatedInformation(Location location,
 	String message):
 		location(location),
@@ -22,9 +22,6 @@ namespace clsp
 
 using namespace std;
 
-const String DidChangeConfigurationClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 DidChangeConfigurationClientCapabilities::
 	DidChangeConfigurationClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -77,8 +74,6 @@ void DidChangeConfigurationClientCapabilities::
 }
 
 
-const String DidChangeConfigurationParams::settingsKey = "settings";
-
 DidChangeConfigurationParams::DidChangeConfigurationParams(Any settings):
 	settings(settings)
 {};
@@ -21,8 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TextDocumentChangeRegistrationOptions::syncKindKey = "syncKind";
-
 TextDocumentChangeRegistrationOptions::TextDocumentChangeRegistrationOptions(
 	variant<DocumentSelector, Null> documentSelector,
 	TextDocumentSyncKind syncKind):
@@ -48,10 +46,6 @@ void TextDocumentChangeRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String TextDocumentContentChangeEvent::rangeKey       = "range";
-const String TextDocumentContentChangeEvent::rangeLengthKey = "rangeLength";
-const String TextDocumentContentChangeEvent::textKey        = "text";
-
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
@@ -175,9 +169,6 @@ void TextDocumentContentChangeEvent::
 
 #pragma GCC diagnostic pop
 
-const String DidChangeTextDocumentParams::textDocumentKey   = "textDocument";
-const String DidChangeTextDocumentParams::contentChangesKey = "contentChanges";
-
 DidChangeTextDocumentParams::
 	DidChangeTextDocumentParams(VersionedTextDocumentIdentifier textDocument,
 		vector<TextDocumentContentChangeEvent> contentChanges):
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DidChangeWatchedFilesClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 DidChangeWatchedFilesClientCapabilities::
 	DidChangeWatchedFilesClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -76,9 +73,6 @@ void DidChangeWatchedFilesClientCapabilities::
 }
 
 
-const String FileSystemWatcher::globPatternKey = "globPattern";
-const String FileSystemWatcher::kindKey        = "kind";
-
 FileSystemWatcher::FileSystemWatcher(String globPattern, optional<WatchKind> kind):
 	globPattern(globPattern),
 	kind(kind)
@@ -102,8 +96,6 @@ void FileSystemWatcher::partialWrite(JsonWriter &writer)
 }
 
 
-const String DidChangeWatchedFilesRegistrationOptions::watchersKey = "watchers";
-
 DidChangeWatchedFilesRegistrationOptions::
 	DidChangeWatchedFilesRegistrationOptions(vector<FileSystemWatcher> watchers):
 		watchers(watchers)
@@ -130,9 +122,6 @@ void DidChangeWatchedFilesRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String FileEvent::uriKey  = "uri";
-const String FileEvent::typeKey = "type";
-
 FileEvent::FileEvent(DocumentUri uri, FileChangeType type):
 	uri(uri),
 	type(type)
@@ -222,8 +211,6 @@ void FileEvent::fillInitializer(ObjectInitializer& initializer)
 }
 
 
-const String DidChangeWatchedFilesParams::changesKey = "changes";
-
 DidChangeWatchedFilesParams::DidChangeWatchedFilesParams(vector<FileEvent> changes):
 	changes(changes)
 {};
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String WorkspaceFoldersChangeEvent::addedKey   = "added";
-const String WorkspaceFoldersChangeEvent::removedKey = "removed";
-
 WorkspaceFoldersChangeEvent::WorkspaceFoldersChangeEvent(
 	vector<WorkspaceFolder> added,
 	vector<WorkspaceFolder> removed):
@@ -169,8 +166,6 @@ void WorkspaceFoldersChangeEvent::AddedRemovedMaker::
 }
 
 
-const String DidChangeWorkspaceFoldersParams::eventKey = "event";
-
 DidChangeWorkspaceFoldersParams::
 	DidChangeWorkspaceFoldersParams(WorkspaceFoldersChangeEvent event):
 		event(event)
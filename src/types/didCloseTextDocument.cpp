@@ -21,8 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DidCloseTextDocumentParams::textDocumentKey = "textDocument";
-
 DidCloseTextDocumentParams::
 	DidCloseTextDocumentParams(TextDocumentIdentifier textDocument):
 		textDocument(textDocument)
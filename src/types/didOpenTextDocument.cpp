@@ -21,8 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DidOpenTextDocumentParams::textDocumentKey = "textDocument";
-
 DidOpenTextDocumentParams::DidOpenTextDocumentParams(TextDocumentItem textDocument):
 	textDocument(textDocument)
 {};
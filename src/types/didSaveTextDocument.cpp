@@ -21,8 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String SaveOptions::includeTextKey = "includeText";
-
 SaveOptions::SaveOptions(optional<Boolean> includeText):
 	includeText(includeText)
 {};
@@ -41,8 +39,6 @@ void SaveOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String TextDocumentSaveRegistrationOptions::includeTextKey = "includeText";
-
 TextDocumentSaveRegistrationOptions::TextDocumentSaveRegistrationOptions(
 	variant<DocumentSelector, Null> documentSelector,
 	optional<Boolean> includeText):
@@ -67,9 +63,6 @@ void TextDocumentSaveRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String DidSaveTextDocumentParams::textDocumentKey = "textDocument";
-const String DidSaveTextDocumentParams::textKey         = "text";
-
 DidSaveTextDocumentParams::
 	DidSaveTextDocumentParams(TextDocumentIdentifier textDocument,
 		optional<String> text):
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DocumentColorClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 DocumentColorClientCapabilities::
 	DocumentColorClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -92,8 +89,6 @@ void DocumentColorRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String DocumentColorParams::textDocumentKey = "textDocument";
-
 DocumentColorParams::DocumentColorParams(optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
 	TextDocumentIdentifier textDocument):
@@ -157,11 +152,6 @@ void DocumentColorParams::fillInitializer(ObjectInitializer& initializer)
 }
 
 
-const String Color::redKey   = "red";
-const String Color::greenKey = "green";
-const String Color::blueKey  = "blue";
-const String Color::alphaKey = "alpha";
-
 Color::Color(Number red, Number green, Number blue, Number alpha):
 	red(red),
 	green(green),
@@ -321,9 +311,6 @@ void Color::partialWrite(JsonWriter &writer)
 }
 
 
-const String ColorInformation::rangeKey = "range";
-const String ColorInformation::colorKey = "color";
-
 ColorInformation::ColorInformation(Range range, Color color):
 	range(range),
 	color(color)
@@ -21,10 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DocumentFilter::languageKey = "language";
-const String DocumentFilter::schemeKey   = "scheme";
-const String DocumentFilter::patternKey  = "pattern";
-
 DocumentFilter::DocumentFilter(optional<String> language,
 	optional<String> scheme,
 	optional<String> pattern):
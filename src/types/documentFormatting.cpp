@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DocumentFormattingClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 DocumentFormattingClientCapabilities::
 	DocumentFormattingClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -89,21 +86,6 @@ void DocumentFormattingRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String FormattingOptions::
-	tabSizeKey                = "tabSize";
-
-const String FormattingOptions::
-	insertSpacesKey           = "insertSpaces";
-
-const String FormattingOptions::
-	trimTrailingWhitespaceKey = "trimTrailingWhitespace";
-
-const String FormattingOptions::
-	insertFinalNewlineKey     = "insertFinalNewline";
-
-const String FormattingOptions::
-	trimFinalNewlinesKey      = "trimFinalNewlines";
-
 FormattingOptions::FormattingOptions(Number tabSize,
 	Boolean insertSpaces,
 	optional<Boolean> trimTrailingWhitespace,
@@ -308,9 +290,6 @@ void FormattingOptions::fillInitializer(ObjectInitializer& initializer)
 }
 
 
-const String DocumentFormattingParams::textDocumentKey = "textDocument";
-const String DocumentFormattingParams::optionsKey      = "options";
-
 DocumentFormattingParams::DocumentFormattingParams(
 	optional<ProgressToken> workDoneToken,
 	TextDocumentIdentifier textDocument,
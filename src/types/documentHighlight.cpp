@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DocumentHighlightClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 DocumentHighlightClientCapabilities::
 	DocumentHighlightClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -109,9 +106,6 @@ void DocumentHighlightParams::fillInitializer(ObjectInitializer& initializer)
 }
 
 
-const String DocumentHighlight::rangeKey = "range";
-const String DocumentHighlight::kindKey  = "kind";
-
 DocumentHighlight::DocumentHighlight(Range range,
 	optional<DocumentHighlightKind> kind):
 		range(range),
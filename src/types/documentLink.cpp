@@ -21,12 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DocumentLinkClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String DocumentLinkClientCapabilities::
-	tooltipSupportKey      = "tooltipSupport";
-
 DocumentLinkClientCapabilities::
 	DocumentLinkClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<Boolean> tooltipSupport):
@@ -104,8 +98,6 @@ void DocumentLinkClientCapabilities::
 }
 
 
-const String DocumentLinkOptions::resolveProviderKey = "resolveProvider";
-
 DocumentLinkOptions::DocumentLinkOptions(optional<Boolean> workDoneProgress,
 	optional<Boolean> resolveProvider):
 		WorkDoneProgressOptions(workDoneProgress),
@@ -149,8 +141,6 @@ void DocumentLinkRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String DocumentLinkParams::textDocumentKey = "textDocument";
-
 DocumentLinkParams::DocumentLinkParams(optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
 	TextDocumentIdentifier textDocument):
@@ -213,11 +203,6 @@ void DocumentLinkParams::fillInitializer(ObjectInitializer& initializer)
 	initializer.object = this;
 }
 
-const String DocumentLink::rangeKey   = "range";
-const String DocumentLink::targetKey  = "target";
-const String DocumentLink::tooltipKey = "tooltip";
-const String DocumentLink::dataKey    = "data";
-
 DocumentLink::DocumentLink(Range range,
 	optional<DocumentUri> target,
 	optional<String> tooltip,
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DocumentOnTypeFormattingClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 DocumentOnTypeFormattingClientCapabilities::
 	DocumentOnTypeFormattingClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -76,12 +73,6 @@ void DocumentOnTypeFormattingClientCapabilities::
 }
 
 
-const String DocumentOnTypeFormattingOptions::
-	firstTriggerCharacterKey = "firstTriggerCharacter";
-
-const String DocumentOnTypeFormattingOptions::
-	moreTriggerCharacterKey  = "moreTriggerCharacter";
-
 DocumentOnTypeFormattingOptions::
 	DocumentOnTypeFormattingOptions(String firstTriggerCharacter,
 		optional<vector<String>> moreTriggerCharacter):
@@ -139,9 +130,6 @@ void DocumentOnTypeFormattingRegistrationOptions::
 }
 
 
-const String DocumentOnTypeFormattingParams::chKey           = "ch";
-const String DocumentOnTypeFormattingParams::optionsKey      = "options";
-
 DocumentOnTypeFormattingParams::DocumentOnTypeFormattingParams(
 	TextDocumentIdentifier textDocument,
 	Position position,
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DocumentRangeFormattingClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 DocumentRangeFormattingClientCapabilities::
 	DocumentRangeFormattingClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -99,10 +96,6 @@ void DocumentRangeFormattingRegistrationOptions::partialWrite(JsonWriter &writer
 }
 
 
-const String DocumentRangeFormattingParams::textDocumentKey = "textDocument";
-const String DocumentRangeFormattingParams::rangeKey        = "range";
-const String DocumentRangeFormattingParams::optionsKey      = "options";
-
 DocumentRangeFormattingParams::DocumentRangeFormattingParams(
 	optional<ProgressToken> workDoneToken,
 	TextDocumentIdentifier textDocument,
@@ -21,15 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String DocumentSymbolClientCapabilities::
-	dynamicRegistrationKey               = "dynamicRegistration";
-
-const String DocumentSymbolClientCapabilities::
-	symbolKindKey                        = "symbolKind";
-
-const String DocumentSymbolClientCapabilities::
-	hierarchicalDocumentSymbolSupportKey = "hierarchicalDocumentSymbolSupport";
-
 DocumentSymbolClientCapabilities::
 	DocumentSymbolClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<SymbolKind> symbolKind,
@@ -139,9 +130,6 @@ void DocumentSymbolClientCapabilities::
 	initializer.object = this;
 }
 
-const String DocumentSymbolClientCapabilities::SymbolKind::
-	valueSetKey = "valueSet";
-
 DocumentSymbolClientCapabilities::SymbolKind::
 	SymbolKind(optional<vector<clsp::SymbolKind>> valueSet):
 		valueSet(valueSet)
@@ -271,8 +259,6 @@ void DocumentSymbolRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String DocumentSymbolParams::textDocumentKey = "textDocument";
-
 DocumentSymbolParams::DocumentSymbolParams(optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
 	TextDocumentIdentifier textDocument):
@@ -337,14 +323,6 @@ void DocumentSymbolParams::fillInitializer(ObjectInitializer& initializer)
 	initializer.object = this;
 }
 
-const String DocumentSymbol::nameKey           = "name";
-const String DocumentSymbol::detailKey         = "detail";
-const String DocumentSymbol::kindKey           = "kind";
-const String DocumentSymbol::deprecatedKey     = "deprecated";
-const String DocumentSymbol::rangeKey          = "range";
-const String DocumentSymbol::selectionRangeKey = "selectionRange";
-const String DocumentSymbol::childrenKey       = "children";
-
 DocumentSymbol::DocumentSymbol(String name,
 	optional<String> detail,
 	SymbolKind kind,
@@ -410,12 +388,6 @@ void DocumentSymbol::partialWrite(JsonWriter &writer)
 }
 
 
-const String SymbolInformation::nameKey          = "name";
-const String SymbolInformation::kindKey          = "kind";
-const String SymbolInformation::deprecatedKey    = "deprecated";
-const String SymbolInformation::locationKey      = "location";
-const String SymbolInformation::containerNameKey = "containerName";
-
 SymbolInformation::SymbolInformation(String name,
 	SymbolKind kind,
 	optional<Boolean> deprecated,
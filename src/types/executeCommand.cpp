@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String ExecuteCommandClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 ExecuteCommandClientCapabilities::
 	ExecuteCommandClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -71,8 +68,6 @@ void ExecuteCommandClientCapabilities::
 }
 
 
-const String ExecuteCommandOptions::commandsKey = "commands";
-
 ExecuteCommandOptions::ExecuteCommandOptions(optional<Boolean> workDoneProgress,
 	vector<String> commands):
 		WorkDoneProgressOptions(workDoneProgress),
@@ -98,9 +93,6 @@ void ExecuteCommandOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String ExecuteCommandParams::commandKey   = "command";
-const String ExecuteCommandParams::argumentsKey = "arguments";
-
 ExecuteCommandParams::ExecuteCommandParams(optional<ProgressToken> workDoneToken,
 	String command,
 	optional<Array> arguments):
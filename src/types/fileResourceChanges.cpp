@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String CreateFileOptions::overwriteKey      = "overwrite";
-const String CreateFileOptions::ignoreIfExistsKey = "ignoreIfExists";
-
 CreateFileOptions::CreateFileOptions(optional<Boolean> overwrite,
 	optional<Boolean> ignoreIfExists):
 		overwrite(overwrite),
@@ -51,11 +48,6 @@ void CreateFileOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const pair<String, String> CreateFile::kind = {"kind", "create"};
-
-const String CreateFile::uriKey     = "uri";
-const String CreateFile::optionsKey = "options";
-
 CreateFile::CreateFile(DocumentUri uri, optional<CreateFileOptions> options):
 	uri(uri),
 	options(options)
@@ -83,9 +75,6 @@ void CreateFile::partialWrite(JsonWriter &writer)
 }
 
 
-const String RenameFileOptions::overwriteKey      = "overwrite";
-const String RenameFileOptions::ignoreIfExistsKey = "ignoreIfExists";
-
 RenameFileOptions::RenameFileOptions(optional<Boolean> overwrite,
 	optional<Boolean> ignoreIfExists):
 		overwrite(overwrite),
@@ -113,12 +102,6 @@ void RenameFileOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const pair<String, String> RenameFile::kind = {"kind", "rename"};
-
-const String RenameFile::oldUriKey  = "oldUri";
-const String RenameFile::newUriKey  = "newUri";
-const String RenameFile::optionsKey = "options";
-
 RenameFile::RenameFile(DocumentUri oldUri,
 	DocumentUri newUri,
 	optional<RenameFileOptions> options):
@@ -153,9 +136,6 @@ void RenameFile::partialWrite(JsonWriter &writer)
 }
 
 
-const String DeleteFileOptions::recursiveKey         = "recursive";
-const String DeleteFileOptions::ignoreIfNotExistsKey = "ignoreIfNotExists";
-
 DeleteFileOptions::DeleteFileOptions(optional<Boolean> recursive,
 	optional<Boolean> ignoreIfNotExists):
 		recursive(recursive),
@@ -183,11 +163,6 @@ void DeleteFileOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const pair<String, String> DeleteFile::kind = {"kind", "delete"};
-
-const String DeleteFile::uriKey     = "uri";
-const String DeleteFile::optionsKey = "options";
-
 DeleteFile::DeleteFile(DocumentUri uri, optional<DeleteFileOptions> options):
 	uri(uri),
 	options(options)
@@ -21,15 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String FoldingRangeClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String FoldingRangeClientCapabilities::
-	rangeLimitKey          = "rangeLimit";
-
-const String FoldingRangeClientCapabilities::
-	lineFoldingOnlyKey     = "lineFoldingOnly";
-
 FoldingRangeClientCapabilities::
 	FoldingRangeClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<Number> rangeLimit,
@@ -158,8 +149,6 @@ void FoldingRangeRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String FoldingRangeParams::textDocumentKey = "textDocument";
-
 FoldingRangeParams::FoldingRangeParams(optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
 	TextDocumentIdentifier textDocument):
@@ -235,12 +224,6 @@ const FoldingRangeKind FoldingRangeKind::Imports = "imports"s;
 const FoldingRangeKind FoldingRangeKind::Region  = "region"s;
 
 
-const String FoldingRange::startLineKey      = "startLine";
-const String FoldingRange::startCharacterKey = "startCharacter";
-const String FoldingRange::endLineKey        = "endLine";
-const String FoldingRange::endCharacterKey   = "endCharacter";
-const String FoldingRange::kindKey           = "kind";
-
 FoldingRange::FoldingRange(Number startLine,
 	optional<Number> startCharacter,
 	Number endLine,
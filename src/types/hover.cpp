@@ -21,12 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String HoverClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String HoverClientCapabilities::
-	contentFormatKey       = "contentFormat";
-
 HoverClientCapabilities::
 	HoverClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<vector<MarkupKind>> contentFormat):
@@ -199,9 +193,6 @@ void HoverParams::fillInitializer(ObjectInitializer& initializer)
 }
 
 
-const String _MarkedString::languageKey = "language";
-const String _MarkedString::valueKey    = "value";
-
 _MarkedString::_MarkedString(String language, String value):
 	language(language),
 	value(value)
@@ -225,9 +216,6 @@ void _MarkedString::partialWrite(JsonWriter &writer)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
-const String Hover::contentsKey = "contents";
-const String Hover::rangeKey    = "range";
-
 Hover::
 	Hover(variant<MarkedString, vector<MarkedString>, MarkupContent> contents,
 	optional<Range> range):
@@ -21,12 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String ImplementationClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String ImplementationClientCapabilities::
-	linkSupportKey         = "linkSupport";
-
 ImplementationClientCapabilities::
 	ImplementationClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<Boolean> linkSupport):
@@ -21,72 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TextDocumentClientCapabilities::
-	synchronizationKey    = "synchronization";
-
-const String TextDocumentClientCapabilities::
-	completionKey         = "completion";
-
-const String TextDocumentClientCapabilities::
-	hoverKey              = "hover";
-
-const String TextDocumentClientCapabilities::
-	signatureHelpKey      = "signatureHelp";
-
-const String TextDocumentClientCapabilities::
-	declarationKey        = "declaration";
-
-const String TextDocumentClientCapabilities::
-	definitionKey         = "definition";
-
-const String TextDocumentClientCapabilities::
-	typeDefinitionKey     = "typeDefinition";
-
-const String TextDocumentClientCapabilities::
-	implementationKey     = "implementation";
-
-const String TextDocumentClientCapabilities::
-	referencesKey         = "references";
-
-const String TextDocumentClientCapabilities::
-	documentHighlightKey  = "documentHighlight";
-
-const String TextDocumentClientCapabilities::
-	documentSymbolKey     = "documentSymbol";
-
-const String TextDocumentClientCapabilities::
-	codeActionKey         = "codeAction";
-
-const String TextDocumentClientCapabilities::
-	codeLensKey           = "codeLens";
-
-const String TextDocumentClientCapabilities::
-	documentLinkKey       = "documentLink";
-
-const String TextDocumentClientCapabilities::
-	colorProviderKey      = "colorProvider";
-
-const String TextDocumentClientCapabilities::
-	formattingKey         = "formatting";
-
-const String TextDocumentClientCapabilities::
-	rangeFormattingKey    = "rangeFormatting";
-
-const String TextDocumentClientCapabilities::
-	onTypeFormattingKey   = "onTypeFormatting";
-
-const String TextDocumentClientCapabilities::
-	renameKey             = "rename";
-
-const String TextDocumentClientCapabilities::
-	publishDiagnosticsKey = "publishDiagnostics";
-
-const String TextDocumentClientCapabilities::
-	foldingRangeKey       = "foldingRange";
-
-const String TextDocumentClientCapabilities::
-	selectionRangeKey     = "selectionRange";
-
 TextDocumentClientCapabilities::TextDocumentClientCapabilities(
 	optional<TextDocumentSyncClientCapabilities> synchronization,
 	optional<CompletionClientCapabilities> completion,
@@ -811,14 +745,10 @@ void TextDocumentClientCapabilities::
 }
 
 
-const String ClientCapabilities::workspaceKey    = "workspace";
-const String ClientCapabilities::textDocumentKey = "textDocument";
-const String ClientCapabilities::experimentalKey = "experimental";
-
 ClientCapabilities::ClientCapabilities(optional<Workspace> workspace,
 	optional<TextDocumentClientCapabilities> textDocument,
 	optional<Any> experimental,
-	map<Key, Any> extra):
+	map<String, Any> extra):
 		workspace(workspace),
 		textDocument(textDocument),
 		experimental(experimental),
@@ -1004,30 +934,6 @@ void ClientCapabilities::fillInitializer(ObjectInitializer& initializer)
 	initializer.object = this;
 }
 
-const String ClientCapabilities::Workspace::
-	applyEditKey              = "applyEdit";
-
-const String ClientCapabilities::Workspace::
-	workspaceEditKey          = "workspaceEdit";
-
-const String ClientCapabilities::Workspace::
-	didChangeConfigurationKey = "didChangeConfiguration";
-
-const String ClientCapabilities::Workspace::
-	didChangeWatchedFilesKey  = "didChangeWatchedFiles";
-
-const String ClientCapabilities::Workspace::
-	symbolKey                 = "symbol";
-
-const String ClientCapabilities::Workspace::
-	executeCommandKey         = "executeCommand";
-
-const String ClientCapabilities::Workspace::
-	workspaceFoldersKey       = "workspaceFolders";
-
-const String ClientCapabilities::Workspace::
-	configurationKey          = "configuration";
-
 ClientCapabilities::Workspace::Workspace(optional<Boolean> applyEdit,
 	optional<WorkspaceEditClientCapabilities> workspaceEdit,
 	optional<DidChangeConfigurationClientCapabilities> didChangeConfiguration,
@@ -1328,15 +1234,6 @@ const TraceKind TraceKind::Messages = _TraceKind::Messages;
 const TraceKind TraceKind::Verbose  = _TraceKind::Verbose;
 
 
-const String InitializeParams::processIdKey             = "processId";
-const String InitializeParams::clientInfoKey            = "clientInfo";
-const String InitializeParams::rootPathKey              = "rootPath";
-const String InitializeParams::rootUriKey               = "rootUri";
-const String InitializeParams::initializationOptionsKey = "initializationOptions";
-const String InitializeParams::capabilitiesKey          = "capabilities";
-const String InitializeParams::traceKey                 = "trace";
-const String InitializeParams::workspaceFoldersKey      = "workspaceFolders";
-
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
@@ -1727,9 +1624,6 @@ void InitializeParams::WorkspaceFoldersMaker::
 }
 
 
-const String InitializeParams::ClientInfo::nameKey    = "name";
-const String InitializeParams::ClientInfo::versionKey = "version";
-
 InitializeParams::ClientInfo::ClientInfo(String name, optional<String> version):
 	name(name),
 	version(version)
@@ -1808,81 +1702,6 @@ void InitializeParams::ClientInfo::
 	initializer.object = this;
 }
 
-const String ServerCapabilities::
-	textDocumentSyncKey                 = "textDocumentSync";
-
-const String ServerCapabilities::
-	completionProviderKey               = "completionProvider";
-
-const String ServerCapabilities::
-	hoverProviderKey                    = "hoverProvider";
-
-const String ServerCapabilities::
-	signatureHelpProviderKey            = "signatureHelpProvider";
-
-const String ServerCapabilities::
-	declarationProviderKey              = "declarationProvider";
-
-const String ServerCapabilities::
-	definitionProviderKey               = "definitionProvider";
-
-const String ServerCapabilities::
-	typeDefinitionProviderKey           = "typeDefinitionProvider";
-
-const String ServerCapabilities::
-	implementationProviderKey           = "implementationProvider";
-
-const String ServerCapabilities::
-	referencesProviderKey               = "referencesProvider";
-
-const String ServerCapabilities::
-	documentHighlightProviderKey        = "documentHighlightProvider";
-
-const String ServerCapabilities::
-	documentSymbolProviderKey           = "documentSymbolProvider";
-
-const String ServerCapabilities::
-	codeActionProviderKey               = "codeActionProvider";
-
-const String ServerCapabilities::
-	codeLensProviderKey                 = "codeLensProvider";
-
-const String ServerCapabilities::
-	documentLinkProviderKey             = "documentLinkProvider";
-
-const String ServerCapabilities::
-	colorProviderKey                    = "colorProvider";
-
-const String ServerCapabilities::
-	documentFormattingProviderKey       = "documentFormattingProvider";
-
-const String ServerCapabilities::
-	documentRangeFormattingProviderKey  = "documentRangeFormattingProvider";
-
-const String ServerCapabilities::
-	documentOnTypeFormattingProviderKey = "documentOnTypeFormattingProvider";
-
-const String ServerCapabilities::
-	renameProviderKey                   = "renameProvider";
-
-const String ServerCapabilities::
-	foldingRangeProviderKey             = "foldingRangeProvider";
-
-const String ServerCapabilities::
-	executeCommandProviderKey           = "executeCommandProvider";
-
-const String ServerCapabilities::
-	selectionRangeProviderKey           = "selectionRangeProvider";
-
-const String ServerCapabilities::
-	workspaceSymbolProviderKey          = "workspaceSymbolProvider";
-
-const String ServerCapabilities::
-	workspaceKey                        = "workspace";
-
-const String ServerCapabilities::
-	experimentalKey                     = "experimental";
-
 ServerCapabilities::ServerCapabilities(
 	optional<variant<TextDocumentSyncOptions, Number>> textDocumentSync,
 	optional<CompletionOptions> completionProvider,
@@ -2301,9 +2120,6 @@ void ServerCapabilities::partialWrite(JsonWriter &writer)
 }
 
 
-const String ServerCapabilities::Workspace::
-	workspaceFoldersKey = "workspaceFolders";
-
 ServerCapabilities::Workspace::
 	Workspace(optional<WorkspaceFoldersServerCapabilities> workspaceFolders):
 		workspaceFolders(workspaceFolders)
@@ -2327,9 +2143,6 @@ InitializedParams::InitializedParams(){};
 InitializedParams::~InitializedParams(){};
 
 
-const String InitializeResult::capabilitiesKey = "capabilities";
-const String InitializeResult::serverInfoKey   = "serverInfo";
-
 InitializeResult::InitializeResult(ServerCapabilities capabilities,
 	optional<ServerInfo> serverInfo):
 		capabilities(capabilities),
@@ -2354,9 +2167,6 @@ void InitializeResult::partialWrite(JsonWriter &writer)
 }
 
 
-const String InitializeResult::ServerInfo::nameKey    = "name";
-const String InitializeResult::ServerInfo::versionKey = "version";
-
 InitializeResult::ServerInfo::
 	ServerInfo(String name, optional<String> version):
 		name(name),
@@ -2381,8 +2191,6 @@ void InitializeResult::ServerInfo::partialWrite(JsonWriter &writer)
 }
 
 
-const String InitializeError::retryKey = "retry";
-
 InitializeError::InitializeError(Boolean retry):
 	retry(retry)
 {};
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String Location::uriKey   = "uri";
-const String Location::rangeKey = "range";
-
 Location::Location(DocumentUri uri, Range range):
 	uri(uri),
 	range(range)
@@ -19,11 +19,6 @@
 namespace clsp
 {
 
-const String LocationLink::originSelectionRangeKey = "originSelectionRange";
-const String LocationLink::targetUriKey            = "targetUri";
-const String LocationLink::targetRangeKey          = "targetRange";
-const String LocationLink::targetSelectionRangeKey = "targetSelectionRange";
-
 LocationLink::LocationLink(optional<Range> originSelectionRange,
 	DocumentUri targetUri,
 	Range targetRange,
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String LogMessageParams::typeKey    = "type";
-const String LogMessageParams::messageKey = "message";
-
 LogMessageParams::LogMessageParams(MessageType type, String message):
 	type(type),
 	message(message)
@@ -55,10 +55,6 @@ const MarkupKind MarkupKind::PlainText = _MarkupKind::PlainText;
 const MarkupKind MarkupKind::Markdown  = _MarkupKind::Markdown;
 
 
-const String MarkupContent::kindKey  = "kind";
-const String MarkupContent::valueKey = "value";
-
-
 MarkupContent::MarkupContent(MarkupKind kind, String value):
 	kind(kind),
 	value(value)
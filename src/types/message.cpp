@@ -21,14 +21,17 @@ namespace clsp
 
 using namespace std;
 
-const pair<String, String> Message::jsonrpc = {"jsonrpc", "2.0"};
-
 Message::Message(Server& server):
 	server(server)
 {};
 
 Message::~Message(){};
 
+Server& Message::getServer()
+{
+	return server;
+}
+
 void Message::partialWrite(JsonWriter &writer)
 {
 	writer.Key(jsonrpc.first);
@@ -21,15 +21,12 @@ namespace clsp
 
 using namespace std;
 
-const String NotificationMessage::methodKey = "method";
-const String NotificationMessage::paramsKey = "params";
-
 NotificationMessage::NotificationMessage(Server& server,
 	String method,
-	optional<any> params):
+	Envelope params):
 		Message(server),
 		method(method),
-		params(params)
+		params(move(params))
 {};
 
 NotificationMessage::NotificationMessage(Server& server):
@@ -50,11 +47,11 @@ void NotificationMessage::partialWrite(JsonWriter &writer)
 	// params?
 	if(params.has_value())
 	{
-		optional<Capability> capability = server.getCapability(method);
-		if(capability.has_value())
+		const Capability* capability = server.findCapability(method);
+		if(capability != nullptr && capability->params.writer != nullptr)
 		{
 			writer.Key(paramsKey);
-			capability->params.writer.value()(writer, *params);
+			capability->params.writer(writer, params);
 		}
 	}
 }
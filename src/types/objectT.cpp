@@ -23,7 +23,11 @@ using namespace std;
 using namespace rapidjson;
 
 
-void ObjectT::fillInitializer(ObjectInitializer&){};
+void ObjectT::fillInitializer(ObjectInitializer& initializer)
+{
+	// An object without members, like InitializedParams
+	initializer.object = this;
+};
 void ObjectT::partialWrite(JsonWriter&){};
 void ObjectT::write(JsonWriter& writer)
 {
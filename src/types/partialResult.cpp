@@ -21,8 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String PartialResultParams::partialResultTokenKey = "partialResultToken";
-
 PartialResultParams::
 	PartialResultParams(optional<ProgressToken> partialResultToken):
 		partialResultToken(partialResultToken)
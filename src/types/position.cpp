@@ -21,10 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String Position::lineKey      = "line";
-const String Position::characterKey = "character";
-
-
 Position::Position(Number line, Number character):
 	line(line),
 	character(character)
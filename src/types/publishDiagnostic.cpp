@@ -21,15 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String PublishDiagnosticsClientCapabilities::
-	relatedInformationKey = "relatedInformation";
-
-const String PublishDiagnosticsClientCapabilities::
-	tagSupportKey         = "tagSupport";
-
-const String PublishDiagnosticsClientCapabilities::
-	versionSupportKey     = "versionSupport";
-
 PublishDiagnosticsClientCapabilities::
 	PublishDiagnosticsClientCapabilities(optional<Boolean> relatedInformation,
 		optional<TagSupport> tagSupport,
@@ -142,9 +133,6 @@ void PublishDiagnosticsClientCapabilities::fillInitializer(ObjectInitializer& in
 }
 
 
-const String PublishDiagnosticsClientCapabilities::TagSupport::
-	valueSetKey = "valueSet";
-
 PublishDiagnosticsClientCapabilities::TagSupport::
 	TagSupport(vector<DiagnosticTag> valueSet):
 		valueSet(valueSet)
@@ -259,10 +247,6 @@ void PublishDiagnosticsClientCapabilities::TagSupport::ValueSetMaker::
 }
 
 
-const String PublishDiagnosticsParams::uriKey         = "uri";
-const String PublishDiagnosticsParams::versionKey     = "version";
-const String PublishDiagnosticsParams::diagnosticsKey = "diagnostics";
-
 PublishDiagnosticsParams::PublishDiagnosticsParams(DocumentUri uri,
 	optional<Number> version,
 	vector<Diagnostic> diagnostics):
@@ -21,10 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String Range::startKey = "start";
-const String Range::endKey   = "end";
-
-
 Range::Range(Position start, Position end):
 	start(start),
 	end(end)
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String ReferenceClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 ReferenceClientCapabilities::
 	ReferenceClientCapabilities(optional<Boolean> dynamicRegistration):
 		dynamicRegistration(dynamicRegistration)
@@ -87,8 +84,6 @@ void ReferenceRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String ReferenceContext::includeDeclarationKey = "includeDeclaration";
-
 ReferenceContext::ReferenceContext(Boolean includeDeclaration):
 	includeDeclaration(includeDeclaration)
 {};
@@ -138,8 +133,6 @@ void ReferenceContext::fillInitializer(ObjectInitializer& initializer)
 	initializer.object = this;
 }
 
-const String ReferenceParams::contextKey = "context";
-
 ReferenceParams::ReferenceParams(TextDocumentIdentifier textDocument,
 	Position position,
 	optional<ProgressToken> workDoneToken,
@@ -21,10 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String Registration::idKey              = "id";
-const String Registration::methodKey          = "method";
-const String Registration::registerOptionsKey = "registerOptions";
-
 Registration::Registration(String id, String method, optional<Any> registerOptions):
 	id(id),
 	method(method),
@@ -53,8 +49,6 @@ void Registration::partialWrite(JsonWriter &writer)
 }
 
 
-const String RegistrationParams::registrationsKey = "registrations";
-
 RegistrationParams::RegistrationParams(vector<Registration> registrations):
 	registrations(registrations)
 {};
@@ -75,9 +69,6 @@ void RegistrationParams::partialWrite(JsonWriter &writer)
 }
 
 
-const String Unregistration::idKey              = "id";
-const String Unregistration::methodKey          = "method";
-
 Unregistration::Unregistration(String id, String method):
 	id(id),
 	method(method)
@@ -98,8 +89,6 @@ void Unregistration::partialWrite(JsonWriter &writer)
 }
 
 
-const String UnregistrationParams::unregisterationsKey = "unregisterations";
-
 UnregistrationParams::UnregistrationParams(vector<Unregistration> unregisterations):
 	unregisterations(unregisterations)
 {};
@@ -21,12 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String RenameClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String RenameClientCapabilities::
-	prepareSupportKey      = "prepareSupport";
-
 RenameClientCapabilities::
 	RenameClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<Boolean> prepareSupport):
@@ -103,8 +97,6 @@ void RenameClientCapabilities::
 }
 
 
-const String RenameOptions::prepareProviderKey = "prepareProvider";
-
 RenameOptions::RenameOptions(optional<Boolean> workDoneProgress,
 	optional<Boolean> prepareProvider):
 		WorkDoneProgressOptions(workDoneProgress),
@@ -147,8 +139,6 @@ void RenameRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String RenameParams::newNameKey      = "newName";
-
 RenameParams::RenameParams( TextDocumentIdentifier textDocument,
 	Position position,
 	optional<ProgressToken> workDoneToken,
@@ -21,19 +21,15 @@ namespace clsp
 
 using namespace std;
 
-const String RequestMessage::idKey     = "id";
-const String RequestMessage::methodKey = "method";
-const String RequestMessage::paramsKey = "params";
-
 RequestMessage::RequestMessage(Server& server,
 	variant<Number, String> id,
 	String method,
-	optional<any> params,
+	Envelope params,
 	optional<function<void(any&, Writer<StringBuffer>&)>> paramsWriter):
 		Message(server),
 		id(id),
 		method(method),
-		params(params),
+		params(move(params)),
 		paramsWriter(paramsWriter)
 {};
 
@@ -43,5 +39,40 @@ RequestMessage::RequestMessage(Server& server):
 
 RequestMessage::~RequestMessage(){};
 
+void RequestMessage::partialWrite(JsonWriter &writer)
+{
+	// Parent
+	Message::partialWrite(writer);
+
+	// id
+	writer.Key(idKey);
+	visit(overload
+	(
+		[&writer](Number n)
+		{
+			writer.Number(n);
+		},
+		[&writer](String &str)
+		{
+			writer.String(str);
+		}
+	), id);
+
+	// method
+	writer.Key(methodKey);
+	writer.String(method);
+
+	// params?
+	if(params.has_value())
+	{
+		const Capability* capability = server.findCapability(method);
+		if(capability != nullptr && capability->params.writer != nullptr)
+		{
+			writer.Key(paramsKey);
+			capability->params.writer(writer, params);
+		}
+	}
+}
+
 }
 
@@ -15,23 +15,27 @@
 // along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <libclsp/types/responseMessage.hpp>
+#include <libclsp/types/genericObject.hpp>
 
 namespace clsp
 {
 
 using namespace std;
 
-const String ResponseMessage::idKey     = "id";
-const String ResponseMessage::resultKey = "result";
-const String ResponseMessage::errorKey  = "error";
-
-
 ResponseMessage::ResponseMessage(Server& server,
 	variant<Number, String, Null> id,
 	any result):
 		Message(server),
 		id(id),
-		result(result)
+		result(move(result))
+{};
+
+ResponseMessage::ResponseMessage(Server& server,
+	variant<Number, String, Null> id,
+	function<void(JsonWriter&)> resultWriter):
+		Message(server),
+		id(id),
+		resultWriter(resultWriter)
 {};
 
 ResponseMessage::ResponseMessage(Server& server,
@@ -78,20 +82,32 @@ void ResponseMessage::partialWrite(JsonWriter &writer)
 		}
 	), id);
 
-	// result?
-	if(result.has_value() && !holds_alternative<Null>(id))
+	// Completes the request send from the client, even if it failed.
+	string_view method;
+	if(!holds_alternative<Null>(id))
 	{
-		// Completes the request send from the client.
-		String method = server.completeRequest(methodId, RequestKind::fromClient);
+		method = server.completeRequest(methodId, RequestKind::fromClient);
+	}
 
-		optional<Capability> capability = server.getCapability(method);
-		if(capability.has_value())
+	// result?
+	if(result.has_value() && !method.empty())
+	{
+		const Capability* capability = server.findCapability(method);
+		if(capability != nullptr && capability->result.has_value() &&
+			capability->result->writer != nullptr)
 		{
 			writer.Key(resultKey);
-			capability->result->writer.value()(writer, *result);
+			capability->result->writer(writer, result);
 		}
 	}
 
+	// result? from a typed handler
+	if(resultWriter.has_value())
+	{
+		writer.Key(resultKey);
+		(*resultWriter)(writer);
+	}
+
 	// error?
 	if(error.has_value())
 	{
@@ -100,10 +116,6 @@ void ResponseMessage::partialWrite(JsonWriter &writer)
 	}
 }
 
-const String ResponseError::codeKey    = "code";
-const String ResponseError::messageKey = "message";
-const String ResponseError::dataKey    = "data";
-
 ResponseError::ResponseError(ErrorCodes code, String message,
 	optional<variant<String, Number, Boolean, Array, Object, Null>> data):
 		code(code),
@@ -114,6 +126,140 @@ ResponseError::ResponseError(ErrorCodes code, String message,
 ResponseError::ResponseError(){};
 ResponseError::~ResponseError(){};
 
+void ResponseError::fillInitializer(ObjectInitializer& initializer)
+{
+	auto* handler = initializer.handler;
+
+	auto& setterMap = initializer.setterMap;
+	auto& neededMap = initializer.neededMap;
+
+	// Value setters
+
+	// code:
+	setterMap.emplace(
+		codeKey,
+		ValueSetter{
+			// String
+			nullopt,
+
+			// Number
+			[this, &neededMap](Number n)
+			{
+				if(holds_alternative<int>(n))
+				{
+					code = (ErrorCodes)get<int>(n);
+				}
+				else
+				{
+					code = ErrorCodes::UnknownErrorCode;
+				}
+
+				neededMap[codeKey] = true;
+			},
+
+			// Boolean
+			nullopt,
+
+			// Null
+			nullopt,
+
+			// Array
+			nullopt,
+
+			// Object
+			nullopt
+		}
+	);
+
+	// message:
+	setterMap.emplace(
+		messageKey,
+		ValueSetter{
+			// String
+			[this, &neededMap](String str)
+			{
+				message = str;
+
+				neededMap[messageKey] = true;
+			},
+
+			// Number
+			nullopt,
+
+			// Boolean
+			nullopt,
+
+			// Null
+			nullopt,
+
+			// Array
+			nullopt,
+
+			// Object
+			nullopt
+		}
+	);
+
+	// data?:
+	setterMap.emplace(
+		dataKey,
+		ValueSetter{
+			// String
+			[this](String str)
+			{
+				data = str;
+			},
+
+			// Number
+			[this](Number n)
+			{
+				data = n;
+			},
+
+			// Boolean
+			[this](Boolean b)
+			{
+				data = b;
+			},
+
+			// Null
+			[this]()
+			{
+				data = Null();
+			},
+
+			// Array
+			[this, handler]()
+			{
+				auto& newArray = data.emplace().emplace<Array>();
+
+				auto* maker = new ArrayMaker(newArray);
+
+				handler->pushInitializer();
+				maker->fillInitializer(handler->objectStack.top());
+			},
+
+			// Object
+			[this, handler]()
+			{
+				auto obj = make_shared<GenericObject>();
+
+				data = Object(obj);
+
+				handler->pushInitializer();
+				obj->fillInitializer(handler->objectStack.top());
+			}
+		}
+	);
+
+	// Needed members
+	neededMap.emplace(codeKey, 0);
+	neededMap.emplace(messageKey, 0);
+
+	// This
+	initializer.object = this;
+}
+
 void ResponseError::partialWrite(JsonWriter &writer)
 {
 	// code
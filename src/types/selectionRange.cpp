@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String SelectionRangeClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
 SelectionRangeClientCapabilities::
 	SelectionRangeClientCapabilities(optional<Boolean> dynamicRegistration):
 			dynamicRegistration(dynamicRegistration)
@@ -91,9 +88,6 @@ void SelectionRangeRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String SelectionRangeParams::textDocumentKey = "textDocument";
-const String SelectionRangeParams::positionsKey    = "positions";
-
 SelectionRangeParams::SelectionRangeParams(
 	optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
@@ -247,9 +241,6 @@ void SelectionRangeParams::PositionsMaker::
 }
 
 
-const String SelectionRange::rangeKey  = "range";
-const String SelectionRange::parentKey = "parent";
-
 SelectionRange::SelectionRange(Range range,
 	optional<shared_ptr<SelectionRange>> parent):
 		range(range),
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String ShowMessageParams::typeKey    = "type";
-const String ShowMessageParams::messageKey = "message";
-
 ShowMessageParams::ShowMessageParams(MessageType type, String message):
 	type(type),
 	message(message)
@@ -44,8 +41,6 @@ void ShowMessageParams::partialWrite(JsonWriter &writer)
 }
 
 
-const String MessageActionItem::titleKey = "title";
-
 MessageActionItem::MessageActionItem(String title):
 	title(title)
 {};
@@ -102,10 +97,6 @@ void MessageActionItem::partialWrite(JsonWriter &writer)
 	writer.String(title);
 }
 
-const String ShowMessageRequestParams::typeKey    = "type";
-const String ShowMessageRequestParams::messageKey = "message";
-const String ShowMessageRequestParams::actionsKey = "actions";
-
 ShowMessageRequestParams::ShowMessageRequestParams(MessageType type,
 	String message,
 	optional<vector<MessageActionItem>> actions):
@@ -21,15 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String SignatureHelpClientCapabilities::
-	dynamicRegistrationKey  = "dynamicRegistration";
-
-const String SignatureHelpClientCapabilities::
-	signatureInformationKey = "signatureInformation";
-
-const String SignatureHelpClientCapabilities::
-	contextSupportKey       = "contextSupport";
-
 SignatureHelpClientCapabilities::
 	SignatureHelpClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<SignatureInformation> signatureInformation,
@@ -140,12 +131,6 @@ void SignatureHelpClientCapabilities::
 	initializer.object = this;
 }
 
-const String SignatureHelpClientCapabilities::SignatureInformation::
-	documentationFormatKey  = "documentationFormat";
-
-const String SignatureHelpClientCapabilities::SignatureInformation::
-	parameterInformationKey = "parameterInformation";
-
 SignatureHelpClientCapabilities::SignatureInformation::
 	SignatureInformation(optional<vector<MarkupKind>> documentationFormat,
 			optional<ParameterInformation> parameterInformation):
@@ -289,11 +274,6 @@ void SignatureHelpClientCapabilities::
 	initializer.object = this;
 }
 
-const String SignatureHelpClientCapabilities::
-	SignatureInformation::
-	ParameterInformation::
-		labelOffsetSupportKey = "labelOffsetSupport";
-
 SignatureHelpClientCapabilities::SignatureInformation::ParameterInformation::
 	ParameterInformation(optional<Boolean> labelOffsetSupport):
 		labelOffsetSupport(labelOffsetSupport)
@@ -348,12 +328,6 @@ void SignatureHelpClientCapabilities::
 }
 
 
-const String SignatureHelpOptions::
-	triggerCharactersKey   = "triggerCharacters";
-
-const String SignatureHelpOptions::
-	retriggerCharactersKey = "retriggerCharacters";
-
 SignatureHelpOptions::
 	SignatureHelpOptions(optional<Boolean> workDoneProgress,
 		optional<vector<String>> triggerCharacters,
@@ -419,9 +393,6 @@ void SignatureHelpRegistrationOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String ParameterInformation::labelKey         = "label";
-const String ParameterInformation::documentationKey = "documentation";
-
 ParameterInformation::
 	ParameterInformation(variant<String, array<Number, 2>> label,
 		optional<variant<String, MarkupContent>> documentation):
@@ -603,10 +574,6 @@ void ParameterInformation::LabelMaker::
 }
 
 
-const String SignatureInformation::labelKey         = "label";
-const String SignatureInformation::documentationKey = "documentation";
-const String SignatureInformation::parametersKey    = "parameters";
-
 SignatureInformation::SignatureInformation(String label,
 	optional<variant<String, MarkupContent>> documentation,
 	optional<vector<ParameterInformation>> parameters):
@@ -819,10 +786,6 @@ void SignatureInformation::ParametersMaker::
 	initializer.object = this;
 }
 
-const String SignatureHelp::signaturesKey      = "signatures";
-const String SignatureHelp::activeSignatureKey = "activeSignature";
-const String SignatureHelp::activeParameterKey = "activeParameter";
-
 SignatureHelp::SignatureHelp(vector<SignatureInformation> signatures,
 	optional<Number> activeSignature,
 	optional<Number> activeParameter):
@@ -1018,18 +981,6 @@ void SignatureHelp::SignaturesMaker::
 	initializer.object = this;
 }
 
-const String SignatureHelpContext::
-	triggerKindKey         = "triggerKind";
-
-const String SignatureHelpContext::
-	triggerCharacterKey    = "triggerCharacter";
-
-const String SignatureHelpContext::
-	isRetriggerKey         = "isRetrigger";
-
-const String SignatureHelpContext::
-	activeSignatureHelpKey = "activeSignatureHelp";
-
 SignatureHelpContext::
 	SignatureHelpContext(SignatureHelpTriggerKind triggerKind,
 		optional<String> triggerCharacter,
@@ -1184,8 +1135,6 @@ void SignatureHelpContext::fillInitializer(ObjectInitializer& initializer)
 	initializer.object = this;
 }
 
-const String SignatureHelpParams::contextKey = "context";
-
 SignatureHelpParams::SignatureHelpParams(TextDocumentIdentifier textDocument,
 	Position position,
 	optional<ProgressToken> workDoneToken,
@@ -21,8 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String StaticRegistrationOptions::idKey = "id";
-
 StaticRegistrationOptions::StaticRegistrationOptions(optional<String> id):
 	id(id)
 {};
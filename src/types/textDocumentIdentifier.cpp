@@ -21,8 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TextDocumentIdentifier::uriKey = "uri";
-
 TextDocumentIdentifier::TextDocumentIdentifier(DocumentUri uri):
 	uri(uri)
 {};
@@ -80,8 +78,6 @@ void TextDocumentIdentifier::partialWrite(JsonWriter &writer)
 }
 
 
-const String VersionedTextDocumentIdentifier::versionKey = "version";
-
 VersionedTextDocumentIdentifier::
 	VersionedTextDocumentIdentifier(DocumentUri uri,
 		variant<Number, Null> version):
@@ -21,11 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TextDocumentItem::uriKey        = "uri";
-const String TextDocumentItem::languageIdKey = "languageId";
-const String TextDocumentItem::versionKey    = "version";
-const String TextDocumentItem::textKey       = "text";
-
 TextDocumentItem::TextDocumentItem(DocumentUri uri,
 	String languageId,
 	Number version,
@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TextDocumentPositionParams::textDocumentKey = "textDocument";
-const String TextDocumentPositionParams::positionKey     = "position";
-
 TextDocumentPositionParams::TextDocumentPositionParams(
 	TextDocumentIdentifier textDocument,
 	Position position):
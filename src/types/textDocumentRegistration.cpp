@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TextDocumentRegistrationOptions::documentSelectorKey = "documentSelector";
-
-
 TextDocumentRegistrationOptions::
 	TextDocumentRegistrationOptions(variant<DocumentSelector, Null> documentSelector):
 		documentSelector(documentSelector)
@@ -21,13 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TextDocumentSyncOptions::openCloseKey         = "openClose";
-const String TextDocumentSyncOptions::changeKey            = "change";
-const String TextDocumentSyncOptions::willSaveKey          = "willSave";
-const String TextDocumentSyncOptions::willSaveWaitUntilKey = "willSaveWaitUntil";
-const String TextDocumentSyncOptions::saveKey              = "save";
-
-
 TextDocumentSyncOptions::TextDocumentSyncOptions(optional<Boolean> openClose,
 	optional<TextDocumentSyncKind> change,
 	optional<Boolean> willSave,
@@ -83,19 +76,6 @@ void TextDocumentSyncOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String TextDocumentSyncClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String TextDocumentSyncClientCapabilities::
-	willSaveKey            = "willSave";
-
-const String TextDocumentSyncClientCapabilities::
-	willSaveWaitUntilKey   = "willSaveWaitUntil";
-
-const String TextDocumentSyncClientCapabilities::
-	didSaveKey             = "didSave";
-
-
 TextDocumentSyncClientCapabilities::
 	TextDocumentSyncClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<Boolean> willSave,
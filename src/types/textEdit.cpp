@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TextEdit::rangeKey   = "range";
-const String TextEdit::newTextKey = "newText";
-
 TextEdit::TextEdit(Range range, String newText):
 	range(range),
 	newText(newText)
@@ -120,9 +117,6 @@ void TextEdit::partialWrite(JsonWriter &writer)
 }
 
 
-const String TextDocumentEdit::textDocumentKey = "textDocument";
-const String TextDocumentEdit::editsKey        = "edits";
-
 TextDocumentEdit::TextDocumentEdit(VersionedTextDocumentIdentifier textDocument,
 	vector<TextEdit> edits):
 		textDocument(textDocument),
@@ -21,12 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String TypeDefinitionClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String TypeDefinitionClientCapabilities::
-	linkSupportKey         = "linkSupport";
-
 TypeDefinitionClientCapabilities::
 	TypeDefinitionClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<Boolean> linkSupport):
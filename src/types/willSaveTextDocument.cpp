@@ -21,9 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String WillSaveTextDocumentParams::textDocumentKey = "textDocument";
-const String WillSaveTextDocumentParams::reasonKey       = "reason";
-
 WillSaveTextDocumentParams::
 	WillSaveTextDocumentParams(TextDocumentIdentifier textDocument,
 		TextDocumentSaveReason reason):
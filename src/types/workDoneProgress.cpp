@@ -22,13 +22,6 @@ namespace clsp
 
 using namespace std;
 
-const pair<String, String> WorkDoneProgressBegin::kind = {"kind", "begin"};
-
-const String WorkDoneProgressBegin::titleKey       = "title";
-const String WorkDoneProgressBegin::cancellableKey = "cancellable";
-const String WorkDoneProgressBegin::messageKey     = "message";
-const String WorkDoneProgressBegin::percentageKey  = "percentage";
-
 WorkDoneProgressBegin::WorkDoneProgressBegin(String title,
 	optional<Boolean> cancellable,
 	optional<String> message,
@@ -198,12 +191,6 @@ void WorkDoneProgressBegin::partialWrite(JsonWriter &writer)
 }
 
 
-const pair<String, String> WorkDoneProgressReport::kind = {"kind", "report"};
-
-const String WorkDoneProgressReport::cancellableKey = "cancellable";
-const String WorkDoneProgressReport::messageKey     = "message";
-const String WorkDoneProgressReport::percentageKey  = "percentage";
-
 WorkDoneProgressReport::WorkDoneProgressReport(optional<Boolean> cancellable,
 	optional<String> message,
 	optional<Number> percentage):
@@ -335,10 +322,6 @@ void WorkDoneProgressReport::partialWrite(JsonWriter &writer)
 }
 
 
-const pair<String, String> WorkDoneProgressEnd::kind = {"kind", "end"};
-
-const String WorkDoneProgressEnd::messageKey = "message";
-
 WorkDoneProgressEnd::WorkDoneProgressEnd(optional<String> message):
 	message(message)
 {};
@@ -397,8 +380,6 @@ void WorkDoneProgressEnd::partialWrite(JsonWriter &writer)
 	}
 }
 
-const String WorkDoneProgressParams::workDoneTokenKey = "workDoneToken";
-
 WorkDoneProgressParams::
 	WorkDoneProgressParams(optional<ProgressToken> workDoneToken):
 		workDoneToken(workDoneToken)
@@ -448,8 +429,6 @@ void WorkDoneProgressParams::fillInitializer(ObjectInitializer& initializer)
 }
 
 
-const String WorkDoneProgressOptions::workDoneProgressKey = "workDoneProgress";
-
 WorkDoneProgressOptions::
 	WorkDoneProgressOptions(optional<Boolean> workDoneProgress):
 		workDoneProgress(workDoneProgress)
@@ -469,8 +448,6 @@ void WorkDoneProgressOptions::partialWrite(JsonWriter &writer)
 }
 
 
-const String WorkDoneProgressCreateParams::tokenKey = "token";
-
 WorkDoneProgressCreateParams::WorkDoneProgressCreateParams(ProgressToken token):
 	token(token)
 {};
@@ -495,8 +472,6 @@ void WorkDoneProgressCreateParams::partialWrite(JsonWriter &writer)
 }
 
 
-const String WorkDoneProgressCancelParams::tokenKey = "token";
-
 WorkDoneProgressCancelParams::WorkDoneProgressCancelParams(ProgressToken token):
 	token(token)
 {};
@@ -547,9 +522,6 @@ void WorkDoneProgressCancelParams::fillInitializer(ObjectInitializer& initialize
 }
 
 
-const String ProgressParams::tokenKey = "token";
-const String ProgressParams::valueKey = "value";
-
 ProgressParams::ProgressParams(ProgressToken token,
 	variant<WorkDoneProgressBegin,
 		WorkDoneProgressReport,
@@ -664,12 +636,12 @@ void ProgressParams::ValueMaker::fillInitializer(ObjectInitializer& initializer)
 
 	// kind:
 	setterMap.emplace(
-		"kind"s,
+		WorkDoneProgressBegin::kind.first,
 		ValueSetter{
 			// String
 			[this, handler, &initializer](String str)
 			{
-				map<String, function<void()>> kindMap =
+				map<Key, function<void()>> kindMap =
 				{
 					{
 						WorkDoneProgressBegin::kind.second,
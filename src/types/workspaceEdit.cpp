@@ -23,9 +23,6 @@ namespace clsp
 
 using namespace std;
 
-const String WorkspaceEdit::changesKey         = "changes";
-const String WorkspaceEdit::documentChangesKey = "documentChanges";
-
 WorkspaceEdit::WorkspaceEdit(optional<Changes> changes,
 	optional<
 		variant<
@@ -188,15 +185,6 @@ WorkspaceEdit::Changes::Changes(){};
 WorkspaceEdit::Changes::~Changes(){};
 
 
-const String WorkspaceEditClientCapabilities::
-	documentChangesKey    = "documentChanges";
-
-const String WorkspaceEditClientCapabilities::
-	resourceOperationsKey = "resourceOperations";
-
-const String WorkspaceEditClientCapabilities::
-	failureHandlingKey    = "failureHandling";
-
 WorkspaceEditClientCapabilities::
 	WorkspaceEditClientCapabilities(optional<Boolean> documentChanges,
 		optional<vector<ResourceOperationKind>> resourceOperations,
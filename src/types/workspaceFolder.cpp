@@ -21,11 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String WorkspaceFoldersServerCapabilities::
-	supportedKey           = "supported";
-const String WorkspaceFoldersServerCapabilities::
-	changeNotificationsKey = "changeNotifications";
-
 WorkspaceFoldersServerCapabilities::
 	WorkspaceFoldersServerCapabilities(optional<Boolean> supported,
 		optional<variant<String, Boolean>> changeNotifications):
@@ -63,9 +58,6 @@ void WorkspaceFoldersServerCapabilities::partialWrite(JsonWriter &writer)
 }
 
 
-const String WorkspaceFolder::uriKey  = "uri";
-const String WorkspaceFolder::nameKey = "name";
-
 WorkspaceFolder::WorkspaceFolder(DocumentUri uri, String name):
 	uri(uri),
 	name(name)
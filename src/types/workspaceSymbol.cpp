@@ -21,12 +21,6 @@ namespace clsp
 
 using namespace std;
 
-const String WorkspaceSymbolClientCapabilities::
-	dynamicRegistrationKey = "dynamicRegistration";
-
-const String WorkspaceSymbolClientCapabilities::
-	symbolKindKey          = "symbolKind";
-
 WorkspaceSymbolClientCapabilities::
 	WorkspaceSymbolClientCapabilities(optional<Boolean> dynamicRegistration,
 		optional<SymbolKind> symbolKind):
@@ -107,9 +101,6 @@ void WorkspaceSymbolClientCapabilities::
 	initializer.object = this;
 }
 
-const String WorkspaceSymbolClientCapabilities::SymbolKind::
-	valueSetKey = "valueSet";
-
 WorkspaceSymbolClientCapabilities::SymbolKind::
 	SymbolKind(optional<vector<clsp::SymbolKind>> valueSet):
 		valueSet(valueSet)
@@ -220,8 +211,6 @@ void WorkspaceSymbolClientCapabilities::SymbolKind::ValueSetMaker::
 	initializer.object = this;
 }
 
-const String WorkspaceSymbolParams::queryKey = "query";
-
 WorkspaceSymbolParams::WorkspaceSymbolParams(
 	optional<ProgressToken> workDoneToken,
 	optional<ProgressToken> partialResultToken,
@@ -0,0 +1,339 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// Every instruction set of the byte scanner agrees with a plain decoder,
+// wherever the sequences fall in the blocks.
+
+#include <cstdio>
+#include <random>
+
+#include <libclsp/server.hpp>
+
+using namespace clsp;
+
+using Isa = ByteScanner::Isa;
+
+const Isa isas[] = {Isa::scalar, Isa::sse2, Isa::avx2, Isa::neon};
+
+const char* isaName(Isa isa)
+{
+	switch(isa)
+	{
+		case Isa::scalar:
+			return "scalar";
+
+		case Isa::sse2:
+			return "SSE2";
+
+		case Isa::avx2:
+			return "AVX2";
+
+		case Isa::neon:
+			return "NEON";
+	}
+
+	return "?";
+}
+
+/// Decodes the code points one by one, it's slow but easy to check.
+bool decodes(const String& bytes)
+{
+	size_t i = 0;
+
+	while(i < bytes.size())
+	{
+		uint8_t lead = bytes[i];
+
+		size_t length;
+		uint32_t codePoint;
+
+		if(lead < 0x80)
+		{
+			length    = 1;
+			codePoint = lead;
+		}
+		else if((lead & 0xE0) == 0xC0)
+		{
+			length    = 2;
+			codePoint = lead & 0x1F;
+		}
+		else if((lead & 0xF0) == 0xE0)
+		{
+			length    = 3;
+			codePoint = lead & 0x0F;
+		}
+		else if((lead & 0xF8) == 0xF0)
+		{
+			length    = 4;
+			codePoint = lead & 0x07;
+		}
+		else
+		{
+			return false;
+		}
+
+		if(i + length > bytes.size())
+		{
+			return false;
+		}
+
+		for(size_t j = 1; j < length; j++)
+		{
+			uint8_t continuation = bytes[i + j];
+
+			if((continuation & 0xC0) != 0x80)
+			{
+				return false;
+			}
+
+			codePoint = codePoint << 6 | (continuation & 0x3F);
+		}
+
+		const uint32_t shortest[] = {0, 0, 0x80, 0x800, 0x10000};
+
+		if(codePoint < shortest[length] || codePoint > 0x10FFFF ||
+			(codePoint >= 0xD800 && codePoint <= 0xDFFF))
+		{
+			return false;
+		}
+
+		i += length;
+	}
+
+	return true;
+}
+
+/// Checks the bytes with every supported instruction set.
+bool checkUtf8(const String& bytes)
+{
+	bool expected = decodes(bytes);
+	bool passed   = true;
+
+	for(Isa isa: isas)
+	{
+		if(ByteScanner::isSupported(isa) &&
+			ByteScanner::isValidUtf8(bytes.data(), bytes.size(), isa) !=
+			expected)
+		{
+			fprintf(stderr, "%s says %s for:", isaName(isa),
+				expected? "invalid": "valid");
+
+			for(unsigned char c: bytes)
+			{
+				fprintf(stderr, " %02X", c);
+			}
+
+			fprintf(stderr, "\n");
+
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+/// Puts each sequence at every offset of two 32 bytes blocks, followed by
+/// ASCII or by nothing, so it's cut by the ends of the blocks.
+bool checkSequences()
+{
+	const String sequences[] = {
+		// Valid
+		"\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF",
+		"\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",
+
+		// Truncated
+		"\xC2", "\xE0\xA0", "\xE1", "\xF0\x90\x80", "\xF1\x80", "\xF4",
+
+		// Continuations without a lead, or too many
+		"\x80", "\xBF", "\xC2\x80\x80", "\xE1\x80\x80\x80",
+
+		// Overlong
+		"\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF",
+		"\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+
+		// Surrogates
+		"\xED\xA0\x80", "\xED\xAF\xBF", "\xED\xB0\x80", "\xED\xBF\xBF",
+
+		// Above U+10FFFF
+		"\xF4\x90\x80\x80", "\xF4\xBF\xBF\xBF", "\xF5\x80\x80\x80",
+		"\xF7\xBF\xBF\xBF", "\xF8\x88\x80\x80\x80", "\xFE", "\xFF",
+	};
+
+	bool passed = true;
+
+	for(const String& sequence: sequences)
+	{
+		for(size_t offset = 0; offset < 64; offset++)
+		{
+			String prefix(offset, 'a');
+
+			passed &= checkUtf8(prefix + sequence);
+			passed &= checkUtf8(prefix + sequence + String(70, 'b'));
+
+			// Twice, the second one in another block
+			passed &= checkUtf8(prefix + sequence + "c\xC3\xA9" + sequence);
+		}
+	}
+
+	return passed;
+}
+
+/// Mixes valid code points with random bytes.
+bool checkRandom()
+{
+	mt19937 random(2019);
+
+	const String pieces[] = {
+		"x", "\n", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+		"\xED\x9F\xBF", "\xF4\x8F\xBF\xBF",
+	};
+
+	bool passed = true;
+
+	for(int i = 0; i < 20000; i++)
+	{
+		String bytes;
+
+		size_t length = random() % 200;
+
+		while(bytes.size() < length)
+		{
+			bytes += pieces[random() % size(pieces)];
+		}
+
+		// A few wrong bytes, or none
+		for(int mistakes = random() % 3; mistakes > 0 && !bytes.empty();
+			mistakes--)
+		{
+			bytes[random() % bytes.size()] = (char)(random() % 256);
+		}
+
+		passed &= checkUtf8(bytes);
+	}
+
+	return passed;
+}
+
+/// Moves a terminator, and parts of it, across the 16 bytes windows.
+bool checkHeaderEnd()
+{
+	bool passed = true;
+
+	const String terminator = "\r\n\r\n";
+
+	for(size_t size = 0; size < 80; size++)
+	{
+		for(size_t offset = 0; offset <= size; offset++)
+		{
+			String bytes(size, 'h');
+
+			// A whole one, or one cut by the end of the bytes
+			bytes.replace(offset, min(terminator.size(), size - offset),
+				terminator, 0, size - offset);
+
+			// Lookalikes before it
+			if(offset >= 3)
+			{
+				bytes.replace(0, 3, "\r\n\r");
+			}
+
+			const char* first = bytes.data();
+			const char* last  = first + bytes.size();
+
+			const char* expected =
+				search(first, last, terminator.begin(), terminator.end());
+
+			for(Isa isa: isas)
+			{
+				if(ByteScanner::isSupported(isa) &&
+					ByteScanner::findHeaderEnd(first, last, isa) != expected)
+				{
+					fprintf(stderr, "%s misses the end at %zu of %zu bytes\n",
+						isaName(isa), offset, size);
+
+					passed = false;
+				}
+			}
+		}
+	}
+
+	return passed;
+}
+
+/// Splits the stream of a frame at every byte, in copied and lent reads.
+bool checkSplitFrames()
+{
+	const String body  = "{\"jsonrpc\":\"2.0\",\"method\":\"exit\"}";
+	const String frame = "Content-Length: " + to_string(body.size()) +
+		"\r\n\r\n" + body;
+
+	bool passed = true;
+
+	for(size_t split = 1; split < frame.size(); split++)
+	{
+		for(bool lent: {false, true})
+		{
+			FrameReader reader;
+			optional<pair<shared_ptr<char>, size_t>> taken;
+
+			for(auto [start, size]: {pair(size_t(0), split),
+				pair(split, frame.size() - split)})
+			{
+				if(lent)
+				{
+					shared_ptr<char> bytes(new char[size],
+						default_delete<char[]>());
+
+					copy_n(frame.data() + start, size, bytes.get());
+
+					reader.commit(move(bytes), size);
+				}
+				else
+				{
+					reader.feed(frame.data() + start, size);
+				}
+
+				// The lent bytes are read before the next ones
+				if(!taken.has_value())
+				{
+					taken = reader.take();
+				}
+			}
+
+			if(!taken.has_value() ||
+				String(taken->first.get(), taken->second) != body)
+			{
+				fprintf(stderr, "The frame split at %zu is lost\n", split);
+				passed = false;
+			}
+		}
+	}
+
+	return passed;
+}
+
+int main()
+{
+	bool passed = true;
+
+	passed &= checkSequences();
+	passed &= checkRandom();
+	passed &= checkHeaderEnd();
+	passed &= checkSplitFrames();
+
+	return passed? 0: 1;
+}
@@ -0,0 +1,89 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// The Content-Length of a header is accepted up to the maximum, and a
+// longer one makes the stream invalid instead of wrapping around.
+
+#include <cstdint>
+#include <cstdio>
+
+#include <libclsp/server.hpp>
+
+using namespace clsp;
+
+/// Reads a header with the length and an empty body. Returns true if the
+/// reader accepts it.
+bool accepts(const String& length, size_t maxFrameSize)
+{
+	FrameReader reader;
+
+	reader.setMaxFrameSize(maxFrameSize);
+
+	String header = "Content-Length: " + length + "\r\n\r\n";
+
+	reader.feed(header.data(), header.size());
+	reader.take();
+
+	return !reader.isInvalid();
+}
+
+int main()
+{
+	const size_t maximum = SIZE_MAX;
+	const String maximumText = to_string(maximum);
+
+	struct Case
+	{
+		String length;
+		size_t maxFrameSize;
+		bool accepted;
+	};
+
+	const Case cases[] = {
+		{"0", 0, true},
+		{"1", 0, false},
+		{"100", 100, true},
+		{"101", 100, false},
+		{"1000", 100, false},
+		{"  42\t", 100, true},
+		{"-1", 100, false},
+		{"4x", 100, false},
+
+		// These wrap around when the digit is added before the check
+		{maximumText, maximum, true},
+		{maximumText + "0", maximum, false},
+		{"18446744073709551616", maximum, false},
+		{"36893488147419103232", maximum, false},
+		{String(40, '9'), maximum, false},
+	};
+
+	bool passed = true;
+
+	for(const Case& c: cases)
+	{
+		if(accepts(c.length, c.maxFrameSize) != c.accepted)
+		{
+			fprintf(stderr, "\"%s\" with a maximum of %zu is %s\n",
+				c.length.c_str(), c.maxFrameSize,
+				c.accepted? "rejected": "accepted");
+
+			passed = false;
+		}
+	}
+
+	return passed? 0: 1;
+}
@@ -0,0 +1,189 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// The frames cut by short writes arrive whole, and a failed write stops
+// the writer until the next transport.
+
+#include <cstdio>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <libclsp/server.hpp>
+
+using namespace clsp;
+
+/// A transport that fails after some writes.
+class FailingTransport: public Transport
+{
+public:
+	/// The writes that succeed
+	int allowed;
+
+	/// The writes tried
+	int writes = 0;
+
+	bool interrupted = false;
+
+	FailingTransport(int allowed):
+		allowed(allowed)
+	{};
+
+	virtual ssize_t read(char*, size_t)
+	{
+		return 0;
+	}
+
+	virtual bool write(const char*, size_t)
+	{
+		return ++writes <= allowed;
+	}
+
+	virtual bool writev(const iovec*, size_t)
+	{
+		return write(nullptr, 0);
+	}
+
+	virtual void interrupt()
+	{
+		interrupted = true;
+	}
+};
+
+/// A body with the text.
+unique_ptr<JsonWriter> body(const String& text)
+{
+	auto writer = make_unique<JsonWriter>();
+
+	writer->String(text);
+
+	return writer;
+}
+
+/// Writes big frames to a small pipe, so each writev() is cut short.
+bool checkShortWrites()
+{
+	int pipeFds[2];
+
+	if(pipe(pipeFds) < 0)
+	{
+		return false;
+	}
+
+	fcntl(pipeFds[1], F_SETPIPE_SZ, 4096);
+
+	String output;
+
+	thread reader([&output, readFd = pipeFds[0]]()
+	{
+		char buffer[1000];
+		ssize_t size;
+
+		while((size = read(readFd, buffer, sizeof(buffer))) > 0)
+		{
+			output.append(buffer, size);
+		}
+	});
+
+	String expected;
+
+	{
+		FdTransport transport(-1, pipeFds[1]);
+		FrameWriter writer;
+
+		writer.setTransport(&transport);
+
+		for(int i = 0; i < 50; i++)
+		{
+			String text(i * 997, 'a' + i % 26);
+			String json = "\"" + text + "\"";
+
+			expected += "Content-Length: " + to_string(json.size()) +
+				"\r\n\r\n" + json;
+
+			// Some of them are batched
+			writer.push(body(text), i % 3 != 0);
+		}
+
+		writer.setTransport(nullptr);
+	}
+
+	close(pipeFds[1]);
+	reader.join();
+	close(pipeFds[0]);
+
+	return output == expected;
+}
+
+/// Fails the second write.
+bool checkFailedWrite()
+{
+	FailingTransport failing(1);
+	FailingTransport working(1000);
+
+	FrameWriter writer;
+
+	writer.setTransport(&failing);
+
+	writer.push(body("first"), false);
+	writer.drain();
+
+	bool passed = !writer.hasFailed();
+
+	writer.push(body("second"), false);
+	writer.drain();
+
+	passed &= writer.hasFailed() && failing.interrupted;
+
+	// Discarded, and drain() doesn't wait for it
+	writer.push(body("third"), false);
+	writer.drain();
+
+	passed &= failing.writes == 2;
+
+	// A new session writes again
+	writer.setTransport(&working);
+
+	writer.push(body("fourth"), false);
+	writer.drain();
+
+	passed &= !writer.hasFailed() && working.writes == 1;
+
+	writer.setTransport(nullptr);
+
+	return passed;
+}
+
+int main()
+{
+	bool passed = true;
+
+	if(!checkShortWrites())
+	{
+		fprintf(stderr, "The frames cut by short writes are wrong\n");
+		passed = false;
+	}
+
+	if(!checkFailedWrite())
+	{
+		fprintf(stderr, "The writer doesn't stop after a failed write\n");
+		passed = false;
+	}
+
+	return passed? 0: 1;
+}
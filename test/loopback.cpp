@@ -0,0 +1,170 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// Two clients of a socket server on localhost get their own responses.
+
+#include <cstdio>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <libclsp/server.hpp>
+
+using namespace clsp;
+
+/// Connects to the port of localhost. Returns -1 on errors.
+int connectTo(int port)
+{
+	int socketFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	sockaddr_in address{};
+
+	address.sin_family      = AF_INET;
+	address.sin_port        = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if(socketFd >= 0 &&
+		connect(socketFd, (sockaddr*)&address, sizeof(address)) < 0)
+	{
+		close(socketFd);
+		return -1;
+	}
+
+	return socketFd;
+}
+
+/// Sends an initialize request with a header.
+bool initialize(int socketFd, int id)
+{
+	String body =
+		"{\"jsonrpc\":\"2.0\",\"id\":" + to_string(id) + ","
+		"\"method\":\"initialize\","
+		"\"params\":{\"processId\":null,\"rootUri\":null,\"capabilities\":{}}}";
+
+	String frame =
+		"Content-Length: " + to_string(body.size()) + "\r\n\r\n" + body;
+
+	return send(socketFd, frame.data(), frame.size(), MSG_NOSIGNAL) ==
+		(ssize_t)frame.size();
+}
+
+/// Reads a whole frame and returns its body, or an empty string if it
+/// doesn't arrive in 5 seconds.
+String receive(int socketFd)
+{
+	String input;
+
+	while(true)
+	{
+		auto headerEnd = input.find("\r\n\r\n");
+
+		if(headerEnd != String::npos)
+		{
+			size_t length = stoul(input.substr(input.find(':') + 1));
+			size_t bodyStart = headerEnd + 4;
+
+			if(input.size() >= bodyStart + length)
+			{
+				return input.substr(bodyStart, length);
+			}
+		}
+
+		pollfd fds[] = {{socketFd, POLLIN, 0}};
+
+		if(poll(fds, 1, 5000) <= 0)
+		{
+			return String();
+		}
+
+		char buffer[4096];
+		ssize_t size = recv(socketFd, buffer, sizeof(buffer), 0);
+
+		if(size <= 0)
+		{
+			return String();
+		}
+
+		input.append(buffer, size);
+	}
+}
+
+/// True if the body is a successful response to the id.
+bool answers(const String& body, int id)
+{
+	return body.find("\"id\":" + to_string(id)) != String::npos &&
+		body.find("\"result\"") != String::npos &&
+		body.find("\"error\"") == String::npos;
+}
+
+int main()
+{
+	ThreadPool pool(2);
+	Server host(pool);
+
+	host.on<Initialize>([](InitializeParams&, RequestMessage&)
+		-> variant<InitializeResult, ResponseError>
+	{
+		return InitializeResult();
+	});
+
+	SocketServer sockets(host);
+
+	int port = sockets.listenTcp(0);
+
+	if(port < 0)
+	{
+		fprintf(stderr, "Can't listen on localhost\n");
+		return 1;
+	}
+
+	thread loop([&sockets]()
+	{
+		sockets.run();
+	});
+
+	int first  = connectTo(port);
+	int second = connectTo(port);
+
+	// The second client asks first
+	bool sent =
+		first >= 0 && second >= 0 &&
+		initialize(second, 2) &&
+		initialize(first, 1);
+
+	String firstBody  = sent? receive(first): String();
+	String secondBody = sent? receive(second): String();
+
+	close(first);
+	close(second);
+
+	sockets.stop();
+	loop.join();
+
+	if(!answers(firstBody, 1) || !answers(secondBody, 2))
+	{
+		fprintf(stderr, "First client:\n%s\nSecond client:\n%s\n",
+			firstBody.c_str(), secondBody.c_str());
+
+		return 1;
+	}
+
+	return 0;
+}
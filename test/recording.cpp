@@ -0,0 +1,182 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// A recorded session replays the same input, without the output, even
+// from a log cut by a crash.
+
+#include <cstdio>
+#include <thread>
+
+#include <unistd.h>
+
+#include <libclsp/server.hpp>
+
+using namespace clsp;
+
+/// Reads all the input of the transport.
+String readAll(Transport& transport)
+{
+	String input;
+	char buffer[777];
+	ssize_t size;
+
+	while((size = transport.read(buffer, sizeof(buffer))) > 0)
+	{
+		input.append(buffer, size);
+	}
+
+	return input;
+}
+
+/// Records a session with many reads and writes. Returns its input.
+String record(const String& path)
+{
+	int inputFds[2];
+	int outputFds[2];
+
+	if(pipe(inputFds) < 0 || pipe(outputFds) < 0)
+	{
+		return String();
+	}
+
+	String sent;
+
+	for(int i = 0; i < 2000; i++)
+	{
+		sent += "message " + to_string(i) + String(i % 50, '.') + "\n";
+	}
+
+	thread client([&sent, writeFd = inputFds[1]]()
+	{
+		for(size_t written = 0; written < sent.size();)
+		{
+			ssize_t size = write(writeFd, sent.data() + written,
+				min<size_t>(sent.size() - written, 1000));
+
+			if(size <= 0)
+			{
+				break;
+			}
+
+			written += size;
+		}
+
+		close(writeFd);
+	});
+
+	// The output isn't read, it only has to fit in the pipe
+	thread output([readFd = outputFds[0]]()
+	{
+		char buffer[4096];
+
+		while(read(readFd, buffer, sizeof(buffer)) > 0);
+	});
+
+	String received;
+
+	{
+		FdTransport fds(inputFds[0], outputFds[1]);
+		RecordingTransport recording(fds, path);
+
+		if(!recording.isValid())
+		{
+			fprintf(stderr, "Can't create %s\n", path.c_str());
+		}
+
+		char buffer[333];
+		ssize_t size;
+
+		while((size = recording.read(buffer, sizeof(buffer))) > 0)
+		{
+			received.append(buffer, size);
+
+			String answer = "read " + to_string(size);
+
+			iovec parts[] = {
+				{answer.data(), answer.size()},
+				{(void*)"\n", 1}
+			};
+
+			recording.writev(parts, 2);
+		}
+	}
+
+	client.join();
+
+	close(outputFds[1]);
+	output.join();
+
+	close(inputFds[0]);
+	close(outputFds[0]);
+
+	return received == sent? sent: String();
+}
+
+int main()
+{
+	String path = "recording-" + to_string(getpid()) + ".log";
+
+	String input = record(path);
+
+	bool passed = !input.empty();
+
+	{
+		ReplayTransport replay(path, false);
+
+		passed &= replay.isValid() && readAll(replay) == input;
+
+		// The replayed server writes to nobody
+		passed &= replay.write("x", 1) && replay.writtenSize() == 1;
+	}
+
+	// A crash leaves the last record cut, the whole ones are still read
+	if(truncate(path.c_str(), 4096) == 0)
+	{
+		ReplayTransport replay(path, false);
+
+		String prefix = readAll(replay);
+
+		passed &= !prefix.empty() && prefix.size() < input.size() &&
+			input.compare(0, prefix.size(), prefix) == 0;
+	}
+	else
+	{
+		passed = false;
+	}
+
+	// Not a log
+	{
+		FILE* file = fopen(path.c_str(), "w");
+
+		if(file != nullptr)
+		{
+			fputs("Content-Length: 2\r\n\r\n{}", file);
+			fclose(file);
+		}
+
+		passed &= !ReplayTransport(path, false).isValid();
+	}
+
+	unlink(path.c_str());
+
+	if(!passed)
+	{
+		fprintf(stderr, "The replayed input is wrong\n");
+	}
+
+	return passed? 0: 1;
+}
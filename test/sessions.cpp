@@ -0,0 +1,115 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// The sessions opened by a server share its handlers, but each one answers
+// its own client.
+
+#include <cstdio>
+#include <cstring>
+
+#include <libclsp/server.hpp>
+
+using namespace clsp;
+
+/// A transport that keeps what the session writes. There's nothing to read,
+/// the test gives the bodies to the session directly.
+class StringTransport: public Transport
+{
+public:
+	String output;
+
+	virtual ssize_t read(char*, size_t)
+	{
+		return 0;
+	}
+
+	virtual bool write(const char* data, size_t size)
+	{
+		output.append(data, size);
+		return true;
+	}
+};
+
+/// Gives an initialize request to a session.
+void initialize(Server& session, int id)
+{
+	String body =
+		"{\"jsonrpc\":\"2.0\",\"id\":" + to_string(id) + ","
+		"\"method\":\"initialize\","
+		"\"params\":{\"processId\":null,\"rootUri\":null,\"capabilities\":{}}}";
+
+	session.receive(body.data(), body.size());
+}
+
+/// True if the output has the response of the id.
+bool answered(const String& output, int id)
+{
+	return output.find("\"id\":" + to_string(id) + ",") != String::npos ||
+		output.find("\"id\":" + to_string(id) + "}") != String::npos;
+}
+
+/// True if the output only has a successful response to the id.
+bool succeeded(const String& output, int id)
+{
+	return answered(output, id) &&
+		output.find("\"result\"") != String::npos &&
+		output.find("\"error\"") == String::npos;
+}
+
+int main()
+{
+	ThreadPool pool(2);
+	Server host(pool);
+
+	host.on<Initialize>([](InitializeParams&, RequestMessage&)
+		-> variant<InitializeResult, ResponseError>
+	{
+		return InitializeResult();
+	});
+
+	auto first  = host.openSession();
+	auto second = host.openSession();
+
+	StringTransport firstTransport;
+	StringTransport secondTransport;
+
+	first->connect(firstTransport);
+	second->connect(secondTransport);
+
+	initialize(*first, 1);
+	initialize(*second, 2);
+
+	// Waits for the responses
+	first->disconnect();
+	second->disconnect();
+
+	bool passed =
+		succeeded(firstTransport.output, 1) &&
+		!answered(firstTransport.output, 2) &&
+		succeeded(secondTransport.output, 2) &&
+		!answered(secondTransport.output, 1);
+
+	if(!passed)
+	{
+		fprintf(stderr, "First session:\n%s\nSecond session:\n%s\n",
+			firstTransport.output.c_str(), secondTransport.output.c_str());
+
+		return 1;
+	}
+
+	return 0;
+}
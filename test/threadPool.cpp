@@ -0,0 +1,193 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// An aged task runs first even behind tasks with deadlines, the idle
+// workers steal the tasks of a busy one, and every task runs once.
+
+#include <cstdio>
+#include <future>
+
+#include <libclsp/server.hpp>
+
+using namespace clsp;
+
+/// Holds the only worker of a pool until it's released.
+class Blocker
+{
+private:
+	promise<void> released;
+
+public:
+	Blocker(ThreadPool& pool)
+	{
+		pool.submit([future = released.get_future().share()]()
+		{
+			future.wait();
+		});
+	};
+
+	void release()
+	{
+		released.set_value();
+	}
+};
+
+/// A background task without a deadline ages behind newer ones that
+/// have it.
+bool checkAging()
+{
+	ThreadPool pool(1);
+
+	mutex orderMutex;
+	String order;
+
+	auto log = [&order, &orderMutex](char name)
+	{
+		return [&order, &orderMutex, name]()
+		{
+			lock_guard lock(orderMutex);
+
+			order += name;
+		};
+	};
+
+	Blocker blocker(pool);
+
+	pool.submit(log('a'), Priority::background);
+
+	this_thread::sleep_for(ThreadPool::agingLimit[2] +
+		chrono::milliseconds(100));
+
+	auto deadline = ThreadPool::Clock::now() + chrono::seconds(10);
+
+	pool.submit(log('b'), Priority::background, deadline);
+	pool.submit(log('c'), Priority::background, deadline);
+	pool.submit(log('n'), Priority::normal);
+
+	blocker.release();
+
+	promise<void> done;
+
+	pool.submit([&done](){ done.set_value(); }, Priority::background);
+
+	done.get_future().wait();
+
+	if(order != "anbc")
+	{
+		fprintf(stderr, "The tasks ran in the order %s\n", order.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/// A worker that stays busy after submitting its tasks doesn't hold them.
+bool checkStealing()
+{
+	ThreadPool pool(2);
+
+	constexpr int taskCount = 100;
+
+	atomic<int> ran = 0;
+	promise<void> allRan;
+
+	shared_future<void> finished = allRan.get_future().share();
+
+	pool.submit([&pool, &ran, &allRan, finished]()
+	{
+		for(int i = 0; i < taskCount; i++)
+		{
+			pool.submit([&ran, &allRan]()
+			{
+				if(++ran == taskCount)
+				{
+					allRan.set_value();
+				}
+			});
+		}
+
+		// Its deque is only emptied by the other worker
+		finished.wait_for(chrono::seconds(10));
+	});
+
+	bool passed = true;
+
+	if(finished.wait_for(chrono::seconds(10)) !=
+		future_status::ready)
+	{
+		fprintf(stderr, "Only %d tasks were stolen\n", ran.load());
+		passed = false;
+	}
+
+	return passed;
+}
+
+/// Many threads submit tasks that also submit and run others.
+bool checkAllRun()
+{
+	atomic<int> ran = 0;
+
+	{
+		ThreadPool pool(4);
+
+		vector<thread> submitters;
+
+		for(int i = 0; i < 4; i++)
+		{
+			submitters.emplace_back([&pool, &ran, i]()
+			{
+				for(int j = 0; j < 2000; j++)
+				{
+					pool.submit([&pool, &ran]()
+					{
+						ran++;
+
+						vector<ThreadPool::Task> inner(3, [&ran](){ ran++; });
+
+						pool.run(inner, Priority::interactive);
+					}, Priority(j % ThreadPool::priorityCount));
+				}
+			});
+		}
+
+		for(auto& submitter: submitters)
+		{
+			submitter.join();
+		}
+
+		// The destructor finishes the queued tasks
+	}
+
+	if(ran != 4 * 2000 * 4)
+	{
+		fprintf(stderr, "%d tasks ran\n", ran.load());
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	bool passed = true;
+
+	passed &= checkAging();
+	passed &= checkStealing();
+	passed &= checkAllRun();
+
+	return passed? 0: 1;
+}
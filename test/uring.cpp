@@ -0,0 +1,209 @@
+// A C++17 library for language servers.
+// Copyright © 2019-2020 otreblan
+//
+// libclsp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// libclsp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libclsp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// The frames read in place from the io_uring buffers and the writes
+// completed in the background keep the bytes of the stream in order.
+
+#include <cstdio>
+#include <thread>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <libclsp/server.hpp>
+
+using namespace clsp;
+
+constexpr int frameCount = 20000;
+
+/// The body of a frame, with a size that changes so the frames are cut at
+/// any point by the ends of the buffers.
+String body(int i)
+{
+	return "{\"i\":" + to_string(i) + ",\"pad\":\"" + String(i % 300, 'x') +
+		"\"}";
+}
+
+/// Reads the frames written to writeFd from readFd. Returns false if they
+/// don't arrive whole and in order.
+bool readFrames(int readFd, int writeFd)
+{
+	UringTransport transport(readFd, -1);
+
+	// The kernel doesn't support io_uring
+	if(!transport.isValid())
+	{
+		close(writeFd);
+		return true;
+	}
+
+	thread writer([writeFd]()
+	{
+		String frames;
+
+		for(int i = 0; i < frameCount; i++)
+		{
+			String content = body(i);
+
+			frames += "Content-Length: " + to_string(content.size()) +
+				"\r\n\r\n" + content;
+		}
+
+		for(size_t written = 0; written < frames.size();)
+		{
+			ssize_t size = write(writeFd, frames.data() + written,
+				min<size_t>(frames.size() - written, 7000));
+
+			if(size <= 0)
+			{
+				break;
+			}
+
+			written += size;
+		}
+
+		close(writeFd);
+	});
+
+	FrameReader reader;
+	int next = 0;
+
+	while(true)
+	{
+		shared_ptr<char> lent;
+
+		ssize_t size = transport.lend(lent);
+
+		if(size <= 0)
+		{
+			break;
+		}
+
+		reader.commit(move(lent), size);
+
+		while(auto frame = reader.take())
+		{
+			if(String(frame->first.get(), frame->second) != body(next))
+			{
+				fprintf(stderr, "Frame %d is wrong\n", next);
+				break;
+			}
+
+			next++;
+		}
+	}
+
+	// The lent buffers go back before the transport ends
+	reader.clear();
+
+	writer.join();
+
+	return next == frameCount;
+}
+
+/// Writes many parts and reads them back from the other end of a pipe.
+bool writeParts()
+{
+	int pipeFds[2];
+
+	if(pipe(pipeFds) < 0)
+	{
+		return false;
+	}
+
+	String expected;
+	String output;
+
+	thread outputReader([&output, readFd = pipeFds[0]]()
+	{
+		char buffer[4096];
+		ssize_t size;
+
+		while((size = read(readFd, buffer, sizeof(buffer))) > 0)
+		{
+			output.append(buffer, size);
+		}
+	});
+
+	{
+		UringTransport transport(-1, pipeFds[1]);
+
+		for(int i = 0; i < 5000 && transport.isValid(); i++)
+		{
+			String header = "part" + to_string(i) + ";";
+			String filler(i % 1000, 'y');
+
+			iovec parts[] = {
+				{header.data(), header.size()},
+				{filler.data(), filler.size()}
+			};
+
+			if(!transport.writev(parts, 2))
+			{
+				break;
+			}
+
+			expected += header + filler;
+		}
+
+		// The destructor waits for the writes
+	}
+
+	close(pipeFds[1]);
+	outputReader.join();
+	close(pipeFds[0]);
+
+	return output == expected;
+}
+
+int main()
+{
+	int pipeFds[2];
+	int socketFds[2];
+
+	if(pipe(pipeFds) < 0 ||
+		socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, socketFds) < 0)
+	{
+		return 1;
+	}
+
+	bool passed = true;
+
+	// Reads on a pipe, receives on a socket
+	if(!readFrames(pipeFds[0], pipeFds[1]))
+	{
+		fprintf(stderr, "The frames of the pipe are wrong\n");
+		passed = false;
+	}
+
+	if(!readFrames(socketFds[0], socketFds[1]))
+	{
+		fprintf(stderr, "The frames of the socket are wrong\n");
+		passed = false;
+	}
+
+	close(pipeFds[0]);
+	close(socketFds[0]);
+
+	if(!writeParts())
+	{
+		fprintf(stderr, "The written parts are wrong\n");
+		passed = false;
+	}
+
+	return passed? 0: 1;
+}